@@ -58,6 +58,14 @@ macro(check_sse)
             set(SSE4_2_FOUND false CACHE BOOL "SSE4.2 available on host")
         endif(SSE42_TRUE)
 
+        string(REGEX REPLACE "^.*(sha_ni).*$" "\\1" SSE_THERE ${CPUINFO})
+        string(COMPARE EQUAL "sha_ni" "${SSE_THERE}" SHA_NI_TRUE)
+        if(SHA_NI_TRUE)
+            set(SHA_NI_FOUND true CACHE BOOL "SHA extensions available on host")
+        else(SHA_NI_TRUE)
+            set(SHA_NI_FOUND false CACHE BOOL "SHA extensions available on host")
+        endif(SHA_NI_TRUE)
+
     elseif(CMAKE_SYSTEM_NAME MATCHES "Darwin")
         exec_program("/usr/sbin/sysctl -n machdep.cpu.features" OUTPUT_VARIABLE
                      CPUINFO)
@@ -102,6 +110,17 @@ macro(check_sse)
             set(SSE4_2_FOUND false CACHE BOOL "SSE4.2 available on host")
         endif(SSE42_TRUE)
 
+        exec_program("/usr/sbin/sysctl -n machdep.cpu.leaf7_features" OUTPUT_VARIABLE
+                     CPUINFO_LEAF7)
+
+        string(REGEX REPLACE "^.*(SHA).*$" "\\1" SSE_THERE "${CPUINFO_LEAF7}")
+        string(COMPARE EQUAL "SHA" "${SSE_THERE}" SHA_NI_TRUE)
+        if(SHA_NI_TRUE)
+            set(SHA_NI_FOUND true CACHE BOOL "SHA extensions available on host")
+        else(SHA_NI_TRUE)
+            set(SHA_NI_FOUND false CACHE BOOL "SHA extensions available on host")
+        endif(SHA_NI_TRUE)
+
     elseif(CMAKE_SYSTEM_NAME MATCHES "Windows")
         # TODO
         set(SSE2_FOUND true CACHE BOOL "SSE2 available on host")
@@ -109,12 +128,14 @@ macro(check_sse)
         set(SSSE3_FOUND false CACHE BOOL "SSSE3 available on host")
         set(SSE4_1_FOUND false CACHE BOOL "SSE4.1 available on host")
         set(SSE4_2_FOUND false CACHE BOOL "SSE4.2 available on host")
+        set(SHA_NI_FOUND false CACHE BOOL "SHA extensions available on host")
     else(CMAKE_SYSTEM_NAME MATCHES "Linux")
         set(SSE2_FOUND true CACHE BOOL "SSE2 available on host")
         set(SSE3_FOUND false CACHE BOOL "SSE3 available on host")
         set(SSSE3_FOUND false CACHE BOOL "SSSE3 available on host")
         set(SSE4_1_FOUND false CACHE BOOL "SSE4.1 available on host")
         set(SSE4_2_FOUND false CACHE BOOL "SSE4.2 available on host")
+        set(SHA_NI_FOUND false CACHE BOOL "SHA extensions available on host")
     endif(CMAKE_SYSTEM_NAME MATCHES "Linux")
 
     if(CMAKE_COMPILER_IS_GNUCXX)
@@ -140,7 +161,10 @@ macro(check_sse)
     if(NOT SSE4_2_FOUND)
         message(STATUS "Could not find support for SSE4.2 on this machine.")
     endif(NOT SSE4_2_FOUND)
+    if(NOT SHA_NI_FOUND)
+        message(STATUS "Could not find support for SHA extensions on this machine.")
+    endif(NOT SHA_NI_FOUND)
 
-    mark_as_advanced(SSE2_FOUND SSE3_FOUND SSSE3_FOUND SSE4_1_FOUND SSE4_2_FOUND)
+    mark_as_advanced(SSE2_FOUND SSE3_FOUND SSSE3_FOUND SSE4_1_FOUND SSE4_2_FOUND SHA_NI_FOUND)
 
 endmacro(check_sse)
\ No newline at end of file
@@ -34,18 +34,23 @@
 #include <boost/accumulators/framework/depends_on.hpp>
 #include <boost/accumulators/framework/parameters/sample.hpp>
 
+#include <boost/assert.hpp>
 #include <boost/container/static_vector.hpp>
 
 #include <nil/crypto3/detail/make_array.hpp>
 #include <nil/crypto3/detail/static_digest.hpp>
 #include <nil/crypto3/detail/endian_shift.hpp>
 #include <nil/crypto3/detail/inject.hpp>
+#include <nil/crypto3/detail/octet.hpp>
+#include <nil/crypto3/detail/pack.hpp>
 
 #include <nil/crypto3/hash/accumulators/bits_count.hpp>
 
 #include <nil/crypto3/hash/accumulators/parameters/bits.hpp>
 #include <nil/crypto3/hash/accumulators/parameters/iterator_last.hpp>
 
+#include <nil/crypto3/hash/detail/octet_blocks.hpp>
+#include <nil/crypto3/hash/midstate.hpp>
 #include <nil/crypto3/hash/type_traits.hpp>
 
 #include <boost/accumulators/statistics/count.hpp>
@@ -104,6 +109,23 @@ namespace nil {
                         return res.digest(cache, total_seen);
                     }
 
+                    inline hashes::midstate<hash_type> export_midstate() const {
+                        hashes::midstate<hash_type> m;
+                        m.state = construction.state();
+                        m.block = cache;
+                        m.total_seen = total_seen;
+                        m.block_compressed = total_seen && !(total_seen % block_bits) && !filled;
+                        return m;
+                    }
+
+                    inline void import_midstate(const hashes::midstate<hash_type> &m) {
+                        construction.restore(m.state);
+                        cache = m.block;
+                        total_seen = m.total_seen;
+                        // A full block left in the cache has never been compressed
+                        filled = total_seen && !(total_seen % block_bits) && !m.block_compressed;
+                    }
+
                 protected:
                     inline void resolve_type(const block_type &value, std::size_t bits) {
                         // total_seen += bits == 0 ? block_bits : bits;
@@ -115,6 +137,83 @@ namespace nil {
                         process(value, bits == 0 ? word_bits : bits);
                     }
 
+                    template<std::size_t BlocksAmount>
+                    inline void resolve_type(const std::array<block_type, BlocksAmount> &value, std::size_t bits) {
+                        BOOST_ASSERT(bits % block_bits == 0);
+                        process(value.data(), bits == 0 ? BlocksAmount : bits / block_bits);
+                    }
+
+                    inline void resolve_type(const hashes::detail::octet_blocks &value, std::size_t) {
+                        process(value.data, value.amount);
+                    }
+
+                    // Whole blocks of octets, for constructions absorbing in lane order
+                    inline void process(const std::uint8_t *octets, std::size_t n) {
+                        const std::size_t block_octets = block_bits / octet_bits;
+
+                        if (!n) {
+                            return;
+                        }
+
+                        if (total_seen % block_bits) {
+                            // The cache holds a partial block, so every incoming block has to be shifted in
+                            for (; n; --n, octets += block_octets) {
+                                block_type block;
+                                ::nil::crypto3::detail::pack_to<endian_type, octet_bits, word_bits>(
+                                    octets, octets + block_octets, block.begin());
+                                process(block, block_bits);
+                            }
+                            return;
+                        }
+
+                        if (filled) {
+                            construction.process_block(cache, total_seen);
+                            filled = false;
+                        }
+
+                        // As with packed blocks, the last one waits in the cache for digest()
+                        if (n > 1) {
+                            construction.process_octets(octets, n - 1, total_seen + block_bits);
+                            total_seen += (n - 1) * block_bits;
+                            octets += (n - 1) * block_octets;
+                        }
+
+                        ::nil::crypto3::detail::pack_to<endian_type, octet_bits, word_bits>(
+                            octets, octets + block_octets, cache.begin());
+                        total_seen += block_bits;
+                        filled = true;
+                    }
+
+                    inline void process(const block_type *blocks, std::size_t n) {
+                        if (!n) {
+                            return;
+                        }
+
+                        if (total_seen % block_bits) {
+                            // The cache holds a partial block, so every incoming block has to be shifted in
+                            for (; n; --n) {
+                                process(*blocks++, block_bits);
+                            }
+                            return;
+                        }
+
+                        if (filled) {
+                            construction.process_block(cache, total_seen);
+                            filled = false;
+                        }
+
+                        // The last block is kept in the cache, since digest() is the one to process it
+                        // when no more data follows
+                        if (n > 1) {
+                            construction.process_blocks(blocks, n - 1, total_seen + block_bits);
+                            total_seen += (n - 1) * block_bits;
+                        }
+
+                        std::copy(blocks[n - 1].begin(), blocks[n - 1].end(), cache.begin());
+                        total_seen += block_bits;
+                        filled = true;
+                    }
+
                     inline void process(const block_type &value, std::size_t value_seen) {
                         using namespace ::nil::crypto3::detail;
 
@@ -125,7 +224,30 @@ namespace nil {
 
                         std::size_t cached_bits = total_seen % block_bits;
 
-                        if (cached_bits != 0) {
+                        if (cached_bits != 0 && cached_bits % word_bits == 0) {
+                            // The cache ends on a word boundary, so whole words are moved. Bits past value_seen
+                            // in the last word are garbage, just as in a partially filled incoming block.
+                            std::size_t cached_words = cached_bits / word_bits;
+                            std::size_t needed_to_fill_bits = block_bits - cached_bits;
+                            std::size_t new_bits_to_append =
+                                (needed_to_fill_bits > value_seen) ? value_seen : needed_to_fill_bits;
+
+                            std::copy(value.begin(), value.begin() + (block_words - cached_words),
+                                      cache.begin() + cached_words);
+                            total_seen += new_bits_to_append;
+
+                            if (new_bits_to_append == needed_to_fill_bits) {
+                                filled = true;
+
+                                if (value_seen > new_bits_to_append) {
+                                    construction.process_block(cache, total_seen);
+                                    filled = false;
+
+                                    std::copy(value.begin() + (block_words - cached_words), value.end(), cache.begin());
+                                    total_seen += value_seen - new_bits_to_append;
+                                }
+                            }
+                        } else if (cached_bits != 0) {
                             // If there are already any bits in the cache
 
                             std::size_t needed_to_fill_bits = block_bits - cached_bits;
@@ -219,6 +341,11 @@ namespace nil {
                             cache[cached_bits / word_bits] = value;
 
                             total_seen += value_seen;
+
+                            if (total_seen % block_bits == 0) {
+                                // The incoming word completes the block
+                                filled = true;
+                            }
                         }
                     }
 
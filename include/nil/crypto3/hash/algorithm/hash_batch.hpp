@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BATCH_HPP
+#define CRYPTO3_HASH_BATCH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/detail/batch_hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        /*!
+         * @brief Hashes every message of a batch independently. SHA-224/256, Keccak and SHA-3
+         * batches are processed several messages at a time by a multi-buffer kernel when the
+         * target has SIMD support.
+         *
+         * @ingroup hash_algorithms
+         *
+         * @tparam Hash
+         * @tparam InputRange Range of contiguous containers of octets
+         * @tparam OutputIterator
+         *
+         * @param messages
+         * @param digests Receives one digest per message, in order
+         *
+         * @return
+         */
+        template<typename Hash, typename InputRange, typename OutputIterator>
+        OutputIterator hash_batch(const InputRange &messages, OutputIterator digests) {
+            typedef hashes::detail::batch_hasher<Hash> batch_hasher_type;
+            typedef typename batch_hasher_type::digest_type digest_type;
+
+            std::vector<const std::uint8_t *> data;
+            std::vector<std::size_t> sizes;
+            for (const auto &m : messages) {
+                typedef typename std::remove_cv<
+                    typename std::remove_pointer<decltype(std::data(m))>::type>::type message_value_type;
+                BOOST_STATIC_ASSERT(sizeof(message_value_type) == 1);
+
+                data.push_back(reinterpret_cast<const std::uint8_t *>(std::data(m)));
+                sizes.push_back(std::size(m));
+            }
+
+            std::vector<digest_type> result(data.size());
+            batch_hasher_type::process(data.data(), sizes.data(), data.size(), result.data());
+            return std::copy(result.begin(), result.end(), digests);
+        }
+    }    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BATCH_HPP
@@ -0,0 +1,143 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE2_HASHER_HPP
+#define CRYPTO3_HASH_BLAKE2_HASHER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief BLAKE2 hasher with the full parameter block: keyed hashing (the BLAKE2 MAC of
+             * RFC 7693), salt and personalization. The key, zero-padded to a whole block, is hashed
+             * as the first block of every message, so a MAC costs no compressions beyond those of
+             * the message itself. reset() and finalize() return to the keyed, parametrized state.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash blake2b or blake2s
+             */
+            template<typename Hash>
+            class blake2_hasher : public hasher<Hash> {
+                typedef hasher<Hash> base_type;
+
+            public:
+                typedef typename base_type::construction_type construction_type;
+                typedef typename construction_type::parameter_block_type parameter_block_type;
+
+                typedef typename base_type::digest_type digest_type;
+                typedef typename base_type::value_type value_type;
+
+                constexpr static const std::size_t max_key_octets = parameter_block_type::max_key_octets;
+                constexpr static const std::size_t salt_octets = parameter_block_type::salt_octets;
+                constexpr static const std::size_t personalization_octets =
+                    parameter_block_type::personalization_octets;
+
+                /*!
+                 * @param params Parameter block; its digest and key lengths are filled in here
+                 */
+                explicit blake2_hasher(const parameter_block_type &params, const std::uint8_t *key = nullptr,
+                                       std::size_t key_size = 0) :
+                    params_(params),
+                    key_(), key_size_(key_size) {
+                    BOOST_ASSERT_MSG(key_size <= max_key_octets, "BLAKE2 key is longer than the largest digest");
+
+                    params_.digest_length = Hash::digest_bits / octet_bits;
+                    params_.key_length = static_cast<std::uint8_t>(key_size);
+                    std::copy(key, key + key_size, key_.begin());
+                    reset();
+                }
+
+                blake2_hasher(const std::uint8_t *key, std::size_t key_size) :
+                    blake2_hasher(parameter_block_type(), key, key_size) {
+                }
+
+                template<typename KeyRange>
+                explicit blake2_hasher(const KeyRange &key) :
+                    blake2_hasher(parameter_block_type(), detail::octets(key), std::size(key)) {
+                }
+
+                /*!
+                 * @param salt Up to 16 octets for BLAKE2b, 8 for BLAKE2s, zero-padded
+                 * @param personalization Up to 16 octets for BLAKE2b, 8 for BLAKE2s, zero-padded
+                 */
+                template<typename KeyRange, typename SaltRange, typename PersonalizationRange>
+                blake2_hasher(const KeyRange &key, const SaltRange &salt, const PersonalizationRange &personalization) :
+                    blake2_hasher(parameter_block_type::make(salt, personalization), detail::octets(key),
+                                  std::size(key)) {
+                }
+
+                template<typename InputIterator>
+                inline blake2_hasher &update(InputIterator first, InputIterator last) {
+                    base_type::update(first, last);
+                    return *this;
+                }
+
+                template<typename SinglePassRange>
+                inline blake2_hasher &update(const SinglePassRange &range) {
+                    base_type::update(range);
+                    return *this;
+                }
+
+                inline blake2_hasher &update(const value_type *data, std::size_t n) {
+                    base_type::update(data, n);
+                    return *this;
+                }
+
+                inline digest_type finalize() {
+                    digest_type d = base_type::finalize();
+                    reset();
+                    return d;
+                }
+
+                inline void reset() {
+                    base_type::reset();
+                    this->construction.reset(params_);
+                    if (key_size_) {
+                        base_type::update(key_.data(), key_.size());
+                    }
+                }
+
+            protected:
+                parameter_block_type params_;
+                std::array<std::uint8_t, base_type::block_values> key_;
+                std::size_t key_size_;
+            };
+
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2_HASHER_HPP
@@ -27,15 +27,29 @@
 #ifndef CRYPTO3_HASH_BLAKE2B_HPP
 #define CRYPTO3_HASH_BLAKE2B_HPP
 
+#include <climits>
+#include <cstdint>
+
 #include <nil/crypto3/hash/detail/blake2b/blake2b_functions.hpp>
 #include <nil/crypto3/hash/detail/blake2b/blake2b_padding.hpp>
 
 #include <nil/crypto3/hash/detail/haifa_construction.hpp>
 #include <nil/crypto3/hash/detail/block_stream_processor.hpp>
 
+#include <nil/crypto3/hash/blake2_hasher.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace hashes {
+            /*!
+             * @brief Name of the BLAKE2b compression kernel in use: "avx2" or "generic".
+             * On x86_64 it is selected at run time from cpuid.
+             * @ingroup hashes
+             */
+            inline const char *blake2b_backend() {
+                return detail::blake2b_functions<512>::backend();
+            }
+
             template<std::size_t DigestBits>
             class blake2b_compressor {
             protected:
@@ -45,6 +59,7 @@ namespace nil {
 
             public:
                 typedef typename policy_type::iv_generator iv_generator;
+                typedef typename policy_type::parameter_block_type parameter_block_type;
 
                 constexpr static const std::size_t word_bits = policy_type::word_bits;
                 typedef typename policy_type::word_type word_type;
@@ -61,42 +76,26 @@ namespace nil {
                 typedef typename policy_type::salt_type salt_type;
                 constexpr static const salt_type salt_value = policy_type::salt_value;
 
-                static void process_block(state_type &state, const block_type &block, value_type seen = value_type(),
-                                          value_type finalizator = value_type()) {
-                    std::array<word_type, state_words * 2> v;
-
-                    std::move(state.begin(), state.end(), v.begin());
-                    std::move(iv_generator()().begin(), iv_generator()().end(), v.begin() + state_words);
-
-                    std::array<typename state_type::value_type, 2> s = {seen / CHAR_BIT + ((seen % CHAR_BIT) ? 1 : 0),
-                                                                        0x00};
-
-                    v[12] ^= s[0];
-                    v[13] ^= s[1];
-
-                    s = {finalizator, 0};
-
-                    v[14] ^= s[0];
-                    v[15] ^= s[1];
-
-                    s.fill(0);
-
-                    policy_type::template round<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15>(v, block);
-                    policy_type::template round<14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3>(v, block);
-                    policy_type::template round<11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4>(v, block);
-                    policy_type::template round<7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8>(v, block);
-                    policy_type::template round<9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13>(v, block);
-                    policy_type::template round<2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9>(v, block);
-                    policy_type::template round<12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11>(v, block);
-                    policy_type::template round<13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10>(v, block);
-                    policy_type::template round<6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5>(v, block);
-                    policy_type::template round<10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0>(v, block);
-                    policy_type::template round<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15>(v, block);
-                    policy_type::template round<14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3>(v, block);
+                /*!
+                 * @param seen Message bits counted up to and including this block
+                 * @param finalizator Set on the last block of a node
+                 * @param last_node Set on the last block of the last node of a tree level
+                 */
+                static inline void process_block(state_type &state, const block_type &block,
+                                                 value_type seen = value_type(),
+                                                 value_type finalizator = value_type(),
+                                                 value_type last_node = value_type()) {
+                    policy_type::impl_type::compress(state, block, seen / CHAR_BIT + ((seen % CHAR_BIT) ? 1 : 0),
+                                                     0x00, finalizator, last_node);
+                }
 
-                    for (size_t i = 0; i < state_words; i++) {
-                        state[i] ^= v[i] ^ v[i + state_words];
-                    }
+                /*!
+                 * @param seen Message bits counted up to and including the first block
+                 */
+                static void process_blocks(state_type &state, const block_type *blocks, std::size_t n,
+                                           value_type seen = value_type()) {
+                    policy_type::impl_type::compress_blocks(state, blocks, n,
+                                                            seen / CHAR_BIT + ((seen % CHAR_BIT) ? 1 : 0));
                 }
             };
 
@@ -148,6 +147,15 @@ namespace nil {
                 };
             };
 
+            /*!
+             * @brief BLAKE2b hasher with key, salt and personalization, see blake2_hasher
+             *
+             * @ingroup hashes
+             *
+             * @tparam DigestBits
+             */
+            template<std::size_t DigestBits>
+            using blake2b_hasher = blake2_hasher<blake2b<DigestBits>>;
         }    // namespace hashes
     }        // namespace crypto3
 }    // namespace nil
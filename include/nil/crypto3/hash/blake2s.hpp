@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE2S_HPP
+#define CRYPTO3_HASH_BLAKE2S_HPP
+
+#include <climits>
+#include <cstdint>
+
+#include <nil/crypto3/hash/detail/blake2s/blake2s_functions.hpp>
+#include <nil/crypto3/hash/detail/blake2s/blake2s_padding.hpp>
+
+#include <nil/crypto3/hash/detail/haifa_construction.hpp>
+#include <nil/crypto3/hash/detail/block_stream_processor.hpp>
+
+#include <nil/crypto3/hash/blake2_hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief Name of the BLAKE2s compression kernel in use: "sse4.1" or "generic".
+             * On x86_64 it is selected at run time from cpuid.
+             * @ingroup hashes
+             */
+            inline const char *blake2s_backend() {
+                return detail::blake2s_functions<256>::backend();
+            }
+
+            template<std::size_t DigestBits>
+            class blake2s_compressor {
+            protected:
+                typedef detail::blake2s_functions<DigestBits> policy_type;
+
+                // The octet counter is 64 bits wide, twice the word
+                typedef std::uint64_t value_type;
+
+            public:
+                typedef typename policy_type::iv_generator iv_generator;
+                typedef typename policy_type::parameter_block_type parameter_block_type;
+
+                constexpr static const std::size_t word_bits = policy_type::word_bits;
+                typedef typename policy_type::word_type word_type;
+
+                constexpr static const std::size_t state_bits = policy_type::state_bits;
+                constexpr static const std::size_t state_words = policy_type::state_words;
+                typedef typename policy_type::state_type state_type;
+
+                constexpr static const std::size_t block_bits = policy_type::block_bits;
+                constexpr static const std::size_t block_words = policy_type::block_words;
+                typedef typename policy_type::block_type block_type;
+
+                constexpr static const std::size_t salt_bits = policy_type::salt_bits;
+                typedef typename policy_type::salt_type salt_type;
+                constexpr static const salt_type salt_value = policy_type::salt_value;
+
+                /*!
+                 * @param seen Message bits counted up to and including this block
+                 * @param finalizator Set on the last block of a node
+                 * @param last_node Set on the last block of the last node of a tree level
+                 */
+                static inline void process_block(state_type &state, const block_type &block,
+                                                 value_type seen = value_type(),
+                                                 value_type finalizator = value_type(),
+                                                 value_type last_node = value_type()) {
+                    value_type t = seen / CHAR_BIT + ((seen % CHAR_BIT) ? 1 : 0);
+                    policy_type::impl_type::compress(state, block, static_cast<word_type>(t),
+                                                     static_cast<word_type>(t >> word_bits),
+                                                     static_cast<word_type>(finalizator),
+                                                     static_cast<word_type>(last_node));
+                }
+
+                /*!
+                 * @param seen Message bits counted up to and including the first block
+                 */
+                static void process_blocks(state_type &state, const block_type *blocks, std::size_t n,
+                                           value_type seen = value_type()) {
+                    policy_type::impl_type::compress_blocks(state, blocks, n,
+                                                            seen / CHAR_BIT + ((seen % CHAR_BIT) ? 1 : 0));
+                }
+            };
+
+            /*!
+             * @brief BLAKE2s (RFC 7693), the 32-bit member of the BLAKE2 family. Outputs between 1 and
+             * 32 bytes; it is the faster one on 32-bit platforms and for short messages, and the one
+             * Zcash uses for its group hash and PRFs. Keyed hashing, salt and personalization are
+             * provided by blake2s_hasher.
+             *
+             * @ingroup hashes
+             * @tparam DigestBits
+             */
+            template<std::size_t DigestBits>
+            class blake2s {
+                typedef detail::blake2s_policy<DigestBits> policy_type;
+
+            public:
+                constexpr static const std::size_t word_bits = policy_type::word_bits;
+                typedef typename policy_type::word_type word_type;
+
+                constexpr static const std::size_t block_bits = policy_type::block_bits;
+                constexpr static const std::size_t block_words = policy_type::block_words;
+                typedef typename policy_type::block_type block_type;
+
+                constexpr static const std::size_t digest_bits = DigestBits;
+                typedef typename policy_type::digest_type digest_type;
+
+                struct construction {
+                    struct params_type {
+                        typedef typename policy_type::digest_endian digest_endian;
+
+                        constexpr static const std::size_t length_bits = policy_type::length_bits;
+                        constexpr static const std::size_t digest_bits = policy_type::digest_bits;
+                    };
+
+                    typedef haifa_construction<params_type, typename policy_type::iv_generator,
+                                               blake2s_compressor<DigestBits>, detail::blake2s_padding<policy_type>>
+                        type;
+                };
+
+                template<typename StateAccumulator, std::size_t ValueBits>
+                struct stream_processor {
+                    struct params_type {
+                        typedef typename policy_type::digest_endian digest_endian;
+
+                        constexpr static const std::size_t value_bits = ValueBits;
+                    };
+
+                    typedef block_stream_processor<construction, StateAccumulator, params_type> type;
+                };
+            };
+
+            /*!
+             * @brief BLAKE2s hasher with key, salt and personalization, see blake2_hasher
+             *
+             * @ingroup hashes
+             *
+             * @tparam DigestBits
+             */
+            template<std::size_t DigestBits>
+            using blake2s_hasher = blake2_hasher<blake2s<DigestBits>>;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2S_HPP
@@ -0,0 +1,51 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE2SP_HPP
+#define CRYPTO3_HASH_BLAKE2SP_HPP
+
+#include <nil/crypto3/hash/blake2s.hpp>
+#include <nil/crypto3/hash/detail/blake2_parallel.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief BLAKE2sp: BLAKE2s over 8 leaves and a root. Leaves take the message in
+             * interleaved 64-octet blocks and are compressed 8 at once. Its digests differ from
+             * those of BLAKE2s.
+             *
+             * @ingroup hashes
+             *
+             * @tparam DigestBits
+             */
+            template<std::size_t DigestBits = 256>
+            using blake2sp = detail::blake2_parallel<detail::blake2s_policy<DigestBits>,
+                                                     blake2s_compressor<DigestBits>, 8, DigestBits>;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2SP_HPP
@@ -0,0 +1,329 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE2XB_HPP
+#define CRYPTO3_HASH_BLAKE2XB_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <nil/crypto3/hash/blake2b.hpp>
+#include <nil/crypto3/hash/detail/blake2_multi_buffer.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/detail/parallel_for.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief BLAKE2Xb extendable output. The message is hashed once by BLAKE2b into a root
+             * chaining value H0, with the output length in the parameter block; output block i is
+             * then BLAKE2b(H0) with node offset i. Output blocks depend on H0 only, so they are
+             * compressed several at once, one per vector lane, and spread over threads when more
+             * than one is requested.
+             *
+             * The output length is declared up front, or left unknown. finalize() writes it and
+             * resets, squeeze() hands it out in as many calls as needed. With an unknown length,
+             * squeeze() produces whole 64-octet blocks, so its stream agrees with finalize() up to
+             * the last whole block of the latter.
+             *
+             * @ingroup hashes
+             */
+            class blake2xb {
+            public:
+                typedef blake2b_hasher<512> root_hasher_type;
+                typedef root_hasher_type::parameter_block_type parameter_block_type;
+
+                typedef detail::blake2b_policy<512> policy_type;
+                typedef blake2b_compressor<512> compressor_type;
+
+                constexpr static const std::size_t word_bits = compressor_type::word_bits;
+                typedef compressor_type::word_type word_type;
+                constexpr static const std::size_t word_octets = word_bits / octet_bits;
+
+                constexpr static const std::size_t state_words = compressor_type::state_words;
+                typedef compressor_type::state_type state_type;
+
+                constexpr static const std::size_t block_words = compressor_type::block_words;
+                typedef compressor_type::block_type block_type;
+
+                // Output is produced in blocks of a full chaining value
+                constexpr static const std::size_t output_block_octets = parameter_block_type::max_digest_octets;
+                constexpr static const std::uint32_t unknown_output_octets = 0xFFFFFFFF;
+
+                constexpr static const std::size_t max_key_octets = parameter_block_type::max_key_octets;
+                constexpr static const std::size_t salt_octets = parameter_block_type::salt_octets;
+                constexpr static const std::size_t personalization_octets =
+                    parameter_block_type::personalization_octets;
+
+            protected:
+                constexpr static const word_type flag = ~word_type();
+
+                // Output blocks handed over to each thread at least
+                constexpr static const std::size_t thread_blocks = 1024;
+
+#ifdef CRYPTO3_HASH_BLAKE2_MULTI_BUFFER
+                typedef detail::blake2_multi_buffer_dispatch<policy_type> multi_buffer_type;
+
+                // Output blocks compressed by one multi-buffer call, a multiple of every backend's lanes
+                constexpr static const std::size_t batch_blocks = 16;
+#endif
+
+            public:
+                /*!
+                 * @param output_octets Output length, or unknown_output_octets
+                 * @param params Parameter block of the root, for its salt and personalization
+                 */
+                blake2xb(std::uint32_t output_octets, const parameter_block_type &params,
+                         const std::uint8_t *key = nullptr, std::size_t key_size = 0, std::size_t threads = 1) :
+                    root_(root_parameters(output_octets, params), key, key_size),
+                    output_octets_(output_octets), threads_(std::max<std::size_t>(threads, 1)) {
+                    BOOST_ASSERT_MSG(output_octets, "BLAKE2Xb output length is zero");
+
+                    // Output nodes: a single block holding H0, in a tree of unlimited fanout and depth
+                    parameter_block_type node = params;
+                    node.digest_length = output_block_octets;
+                    node.key_length = 0;
+                    node.fanout = 0;
+                    node.depth = 0;
+                    node.leaf_length = output_block_octets;
+                    node.node_offset = static_cast<std::uint64_t>(output_octets) << 32;
+                    node.node_depth = 0;
+                    node.inner_length = output_block_octets;
+                    node_state_ = node.apply(policy_type::iv);
+
+                    reset();
+                }
+
+                explicit blake2xb(std::uint32_t output_octets = unknown_output_octets) :
+                    blake2xb(output_octets, parameter_block_type()) {
+                }
+
+                template<typename KeyRange>
+                blake2xb(std::uint32_t output_octets, const KeyRange &key, std::size_t threads = 1) :
+                    blake2xb(output_octets, parameter_block_type(), detail::octets(key), std::size(key), threads) {
+                }
+
+                /*!
+                 * @param salt Up to 16 octets, zero-padded
+                 * @param personalization Up to 16 octets, zero-padded
+                 */
+                template<typename KeyRange, typename SaltRange, typename PersonalizationRange>
+                blake2xb(std::uint32_t output_octets, const KeyRange &key, const SaltRange &salt,
+                         const PersonalizationRange &personalization, std::size_t threads = 1) :
+                    blake2xb(output_octets, parameter_block_type::make(salt, personalization), detail::octets(key),
+                             std::size(key), threads) {
+                }
+
+                inline blake2xb &update(const std::uint8_t *data, std::size_t n) {
+                    BOOST_ASSERT_MSG(!squeezing_, "BLAKE2Xb input can not be extended once squeezing started");
+
+                    root_.update(data, n);
+                    return *this;
+                }
+
+                template<typename ContiguousRange>
+                inline blake2xb &update(const ContiguousRange &range) {
+                    return update(detail::octets(range), std::size(range));
+                }
+
+                /*!
+                 * @brief Writes the n-octet output for the message seen so far and resets. n is the
+                 * declared output length, unless that is unknown.
+                 */
+                inline void finalize(std::uint8_t *out, std::size_t n) {
+                    BOOST_ASSERT_MSG(output_octets_ == unknown_output_octets || n == output_octets_,
+                                     "BLAKE2Xb output length differs from the declared one");
+
+                    if (!squeezing_) {
+                        finish();
+                        stream_octets_ = n;
+                    }
+                    squeeze(out, n);
+                    reset();
+                }
+
+                inline std::vector<std::uint8_t> finalize(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    finalize(out.data(), n);
+                    return out;
+                }
+
+                inline std::vector<std::uint8_t> finalize() {
+                    BOOST_ASSERT_MSG(output_octets_ != unknown_output_octets, "BLAKE2Xb output length is unknown");
+                    return finalize(output_octets_);
+                }
+
+                /*!
+                 * @brief Writes the next n octets of output. The first call ends the message.
+                 */
+                inline void squeeze(std::uint8_t *out, std::size_t n) {
+                    if (!squeezing_) {
+                        finish();
+                    }
+                    BOOST_ASSERT_MSG(n <= stream_octets_ - squeezed_, "BLAKE2Xb output is exhausted");
+
+                    std::size_t amount = std::min(n, cached_);
+                    std::memcpy(out, cache_.data() + output_block_octets - cached_, amount);
+                    cached_ -= amount;
+                    squeezed_ += amount;
+                    out += amount;
+                    n -= amount;
+
+                    std::size_t blocks = n / output_block_octets;
+                    produce(squeezed_ / output_block_octets, blocks, out);
+                    squeezed_ += blocks * output_block_octets;
+                    out += blocks * output_block_octets;
+                    n -= blocks * output_block_octets;
+
+                    if (n) {
+                        produce(squeezed_ / output_block_octets, 1, cache_.data());
+                        std::memcpy(out, cache_.data(), n);
+                        cached_ = output_block_octets - n;
+                        squeezed_ += n;
+                    }
+                }
+
+                inline std::vector<std::uint8_t> squeeze(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    squeeze(out.data(), n);
+                    return out;
+                }
+
+                inline void reset() {
+                    root_.reset();
+                    squeezed_ = 0;
+                    cached_ = 0;
+                    squeezing_ = false;
+                }
+
+            protected:
+                // The root is plain BLAKE2b-512 with the output length in the upper half of the node offset
+                static inline parameter_block_type root_parameters(std::uint32_t output_octets,
+                                                                   parameter_block_type params) {
+                    params.node_offset = static_cast<std::uint64_t>(output_octets) << 32;
+                    return params;
+                }
+
+                // Hashes the message into H0, the single block every output node compresses
+                inline void finish() {
+                    static_digest<512> h0 = root_.finalize();
+
+                    root_block_ = block_type();
+                    for (std::size_t i = 0; i != h0.size(); ++i) {
+                        const word_type octet = h0[i];
+                        root_block_[i / word_octets] |= octet << ((i % word_octets) * octet_bits);
+                    }
+
+                    stream_octets_ = output_octets_ == unknown_output_octets ?
+                                         (std::uint64_t(1) << 32) * output_block_octets :
+                                         output_octets_;
+                    squeezing_ = true;
+                }
+
+                // Digest length of output node i: the last node of the stream may be shorter
+                inline std::size_t node_octets(std::uint64_t i) const {
+                    return static_cast<std::size_t>(
+                        std::min<std::uint64_t>(output_block_octets, stream_octets_ - i * output_block_octets));
+                }
+
+                // Initial chaining value of output node i
+                inline state_type node_state(std::uint64_t i) const {
+                    state_type s = node_state_;
+                    s[0] ^= output_block_octets ^ node_octets(i);
+                    s[1] ^= i;
+                    return s;
+                }
+
+                inline void store(state_type s, std::uint64_t i, std::uint8_t *out) const {
+                    for (word_type &w : s) {
+                        w = boost::endian::native_to_little(w);
+                    }
+                    std::memcpy(out, s.data(), node_octets(i));
+                }
+
+                // Writes count output blocks, starting with block first, the threads taking a range each
+                inline void produce(std::uint64_t first, std::size_t count, std::uint8_t *out) const {
+                    std::size_t threads = std::min(threads_, std::max<std::size_t>(count / thread_blocks, 1));
+                    detail::parallel_for(count, threads, [&](std::size_t begin, std::size_t end) {
+                        produce_range(first + begin, end - begin, out + begin * output_block_octets);
+                    });
+                }
+
+                inline void produce_range(std::uint64_t first, std::size_t count, std::uint8_t *out) const {
+#ifdef CRYPTO3_HASH_BLAKE2_MULTI_BUFFER
+                    const multi_buffer_type::backend_type &backend = multi_buffer_type::backend();
+
+                    // Nodes differ in their offsets, and the last one of the stream in its digest length
+                    std::array<state_type, batch_blocks> states;
+                    while (count) {
+                        std::size_t n = std::min(count, batch_blocks);
+                        for (std::size_t l = 0; l != n; ++l) {
+                            states[l] = node_state(first + l);
+                        }
+                        backend.compress_blocks(states.data(), n, root_block_, output_block_octets, 0, flag);
+                        for (std::size_t l = 0; l != n; ++l) {
+                            store(states[l], first + l, out + l * output_block_octets);
+                        }
+                        count -= n;
+                        first += n;
+                        out += n * output_block_octets;
+                    }
+#endif
+
+                    for (; count; --count, ++first, out += output_block_octets) {
+                        state_type s = node_state(first);
+                        compressor_type::process_block(s, root_block_, output_block_octets * octet_bits, flag);
+                        store(s, first, out);
+                    }
+                }
+
+                root_hasher_type root_;
+                state_type node_state_;
+                block_type root_block_;
+
+                std::uint32_t output_octets_;
+                std::size_t threads_;
+
+                // Output octets the node digest lengths are computed for
+                std::uint64_t stream_octets_;
+                std::uint64_t squeezed_;
+                std::array<std::uint8_t, output_block_octets> cache_;
+                // Octets of the last produced block not handed out yet, at the end of cache_
+                std::size_t cached_;
+                bool squeezing_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2XB_HPP
@@ -0,0 +1,226 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE3_HPP
+#define CRYPTO3_HASH_BLAKE3_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/detail/blake3/blake3_functions.hpp>
+#include <nil/crypto3/hash/detail/blake3/blake3_construction.hpp>
+#include <nil/crypto3/hash/detail/block_stream_processor.hpp>
+
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief Name of the BLAKE3 chunk hashing kernel in use: "avx512", "avx2", "sse4.1" or
+             * "generic". On x86_64 it is selected at run time from cpuid.
+             * @ingroup hashes
+             */
+            inline const char *blake3_backend() {
+                return detail::blake3_functions<256>::backend();
+            }
+
+            /*!
+             * @brief BLAKE3: a 32-bit, 7-round compression function in a binary tree over 1 KiB
+             * chunks. Independent chunks are hashed several at once by the SIMD kernels. The output
+             * is extendable, DigestBits is the amount taken from it; keyed hashing, key derivation,
+             * arbitrary-length output and multi-threaded hashing are provided by blake3_hasher.
+             *
+             * @ingroup hashes
+             * @tparam DigestBits
+             */
+            template<std::size_t DigestBits = 256>
+            class blake3 {
+                typedef detail::blake3_functions<DigestBits> policy_type;
+
+            public:
+                constexpr static const std::size_t word_bits = policy_type::word_bits;
+                typedef typename policy_type::word_type word_type;
+
+                constexpr static const std::size_t block_bits = policy_type::block_bits;
+                constexpr static const std::size_t block_words = policy_type::block_words;
+                typedef typename policy_type::block_type block_type;
+
+                constexpr static const std::size_t digest_bits = DigestBits;
+                typedef typename policy_type::digest_type digest_type;
+
+                BOOST_STATIC_ASSERT(digest_bits && digest_bits % octet_bits == 0);
+
+                struct construction {
+                    struct params_type {
+                        typedef typename policy_type::digest_endian digest_endian;
+
+                        constexpr static const std::size_t length_bits = policy_type::length_bits;
+                        constexpr static const std::size_t digest_bits = policy_type::digest_bits;
+                    };
+
+                    typedef detail::blake3_construction<params_type, policy_type> type;
+                };
+
+                template<typename StateAccumulator, std::size_t ValueBits>
+                struct stream_processor {
+                    struct params_type {
+                        typedef typename policy_type::digest_endian digest_endian;
+
+                        constexpr static const std::size_t value_bits = ValueBits;
+                    };
+
+                    typedef block_stream_processor<construction, StateAccumulator, params_type> type;
+                };
+            };
+
+            /*!
+             * @brief BLAKE3 hasher with its three modes: hashing, keyed hashing with a 32-octet key
+             * and key derivation from a context string. Besides the DigestBits digest, finalize()
+             * writes any amount of extendable output. Long messages are spread over threads, one
+             * complete subtree each.
+             *
+             * @ingroup hashes
+             *
+             * @tparam DigestBits
+             */
+            template<std::size_t DigestBits = 256>
+            class blake3_hasher : public hasher<blake3<DigestBits>> {
+                typedef hasher<blake3<DigestBits>> base_type;
+
+            public:
+                typedef typename base_type::construction_type construction_type;
+                typedef typename construction_type::state_type state_type;
+                typedef typename construction_type::word_type word_type;
+
+                typedef typename base_type::digest_type digest_type;
+                typedef typename base_type::value_type value_type;
+
+                typedef detail::blake3_policy<DigestBits> policy_type;
+                constexpr static const std::size_t key_octets = policy_type::key_octets;
+
+                explicit blake3_hasher(std::size_t threads = 1) : blake3_hasher(policy_type::iv, 0, threads) {
+                }
+
+                /*!
+                 * @brief Keyed hashing
+                 */
+                template<typename KeyRange>
+                explicit blake3_hasher(const KeyRange &key, std::size_t threads = 1) :
+                    blake3_hasher(load_key(detail::octets(key), std::size(key)), policy_type::keyed_hash, threads) {
+                }
+
+                /*!
+                 * @brief Key derivation: the hasher turns key material into keys bound to context,
+                 * a hardcoded, globally unique string naming the application and the purpose
+                 */
+                template<typename ContextRange>
+                static blake3_hasher derive_key(const ContextRange &context, std::size_t threads = 1) {
+                    blake3_hasher context_hasher(policy_type::iv, policy_type::derive_key_context, 1);
+                    context_hasher.update(context);
+                    std::array<std::uint8_t, key_octets> context_key;
+                    context_hasher.finalize(context_key.data(), context_key.size());
+
+                    return blake3_hasher(load_key(context_key.data(), context_key.size()),
+                                         policy_type::derive_key_material, threads);
+                }
+
+                template<typename InputIterator>
+                inline blake3_hasher &update(InputIterator first, InputIterator last) {
+                    base_type::update(first, last);
+                    return *this;
+                }
+
+                template<typename SinglePassRange>
+                inline blake3_hasher &update(const SinglePassRange &range) {
+                    base_type::update(range);
+                    return *this;
+                }
+
+                inline blake3_hasher &update(const value_type *data, std::size_t n) {
+                    base_type::update(data, n);
+                    return *this;
+                }
+
+                inline digest_type finalize() {
+                    digest_type d = base_type::finalize();
+                    reset();
+                    return d;
+                }
+
+                /*!
+                 * @brief Writes octets [offset, offset + n) of the extendable output of the message
+                 * seen so far and resets. Its first DigestBits are the digest.
+                 */
+                inline void finalize(std::uint8_t *out, std::size_t n, std::uint64_t offset = 0) {
+                    typename base_type::block_type block;
+                    const std::size_t seen = this->last_block(block);
+
+                    this->construction.output(block, seen).squeeze(out, n, offset);
+                    reset();
+                }
+
+                inline std::vector<std::uint8_t> finalize(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    finalize(out.data(), n);
+                    return out;
+                }
+
+                inline void reset() {
+                    base_type::reset();
+                    this->construction.reset(key_, flags_);
+                }
+
+            protected:
+                blake3_hasher(const state_type &key, word_type flags, std::size_t threads) : key_(key), flags_(flags) {
+                    this->construction.threads(threads);
+                    reset();
+                }
+
+                static inline state_type load_key(const std::uint8_t *key, std::size_t key_size) {
+                    BOOST_ASSERT_MSG(key_size == key_octets, "BLAKE3 key is not 32 octets long");
+
+                    state_type k;
+                    for (std::size_t i = 0; i != k.size(); ++i, key += policy_type::word_bits / octet_bits) {
+                        k[i] = static_cast<word_type>(key[0]) | (static_cast<word_type>(key[1]) << 8) |
+                               (static_cast<word_type>(key[2]) << 16) | (static_cast<word_type>(key[3]) << 24);
+                    }
+                    return k;
+                }
+
+                state_type key_;
+                word_type flags_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE3_HPP
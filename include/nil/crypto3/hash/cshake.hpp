@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_CSHAKE_HPP
+#define CRYPTO3_HASH_CSHAKE_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <nil/crypto3/hash/shake.hpp>
+#include <nil/crypto3/hash/detail/cshake/cshake_functions.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief cSHAKE128/cSHAKE256 (NIST SP 800-185): SHAKE with a function name and a
+             * customization string. The encoded prefix fills whole blocks, so the state after it
+             * is kept and reset() returns to it without absorbing the prefix again. With both
+             * strings empty cSHAKE is plain SHAKE.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             */
+            template<std::size_t SecurityBits>
+            class cshake_xof : public shake_xof<SecurityBits> {
+                typedef shake_xof<SecurityBits> base_type;
+                typedef detail::cshake_functions functions_type;
+
+            public:
+                typedef typename base_type::state_type state_type;
+
+                constexpr static const std::size_t block_octets = base_type::block_octets;
+
+                constexpr static const std::uint8_t domain_separator = 0x04;
+
+                cshake_xof() : base_type(base_type::domain_separator), prefix_state_(this->state_) {
+                }
+
+                cshake_xof(const std::uint8_t *function_name, std::size_t function_name_size,
+                           const std::uint8_t *customization, std::size_t customization_size) :
+                    base_type(function_name_size || customization_size ? domain_separator :
+                                                                         base_type::domain_separator) {
+                    if (function_name_size || customization_size) {
+                        std::vector<std::uint8_t> prefix = functions_type::bytepad(
+                            {{function_name, function_name_size}, {customization, customization_size}},
+                            block_octets);
+                        base_type::update(prefix.data(), prefix.size());
+                    }
+                    prefix_state_ = this->state_;
+                }
+
+                template<typename FunctionNameRange, typename CustomizationRange>
+                cshake_xof(const FunctionNameRange &function_name, const CustomizationRange &customization) :
+                    cshake_xof(detail::octets(function_name), std::size(function_name),
+                               detail::octets(customization), std::size(customization)) {
+                }
+
+                inline void reset() {
+                    base_type::reset();
+                    this->state_ = prefix_state_;
+                }
+
+            protected:
+                state_type prefix_state_;
+            };
+
+            typedef cshake_xof<128> cshake128;
+            typedef cshake_xof<256> cshake256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_CSHAKE_HPP
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_DETAIL_BATCH_HASHER_HPP
+#define CRYPTO3_HASH_DETAIL_BATCH_HASHER_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_multi_buffer.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_policy.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_1600_multi_buffer.hpp>
+#include <nil/crypto3/hash/detail/sha3/sha3_policy.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            template<std::size_t Version>
+            class sha2;
+
+            template<std::size_t DigestBits>
+            class keccak_1600;
+
+            template<std::size_t DigestBits>
+            class sha3;
+
+            namespace detail {
+                /*!
+                 * @brief Hashes a batch of independent octet messages. Hashes without a dedicated
+                 * multi-message kernel process the messages one after another.
+                 *
+                 * @tparam Hash
+                 */
+                template<typename Hash, typename = void>
+                struct batch_hasher {
+                    typedef typename hasher<Hash>::digest_type digest_type;
+
+                    static inline void process(const std::uint8_t *const *data, const std::size_t *sizes,
+                                               std::size_t n, digest_type *digests) {
+                        hasher<Hash> h;
+                        for (std::size_t i = 0; i != n; ++i) {
+                            digests[i] = h.update(data[i], sizes[i]).finalize();
+                        }
+                    }
+                };
+
+#ifdef CRYPTO3_HASH_SHA2_256_MULTI_BUFFER
+                template<std::size_t Version>
+                struct batch_hasher<sha2<Version>, typename std::enable_if<Version == 224 || Version == 256>::type>
+                    : public sha2_256_multi_buffer_dispatch<sha2_policy<Version>> { };
+#endif
+
+#ifdef CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER
+                template<std::size_t DigestBits>
+                struct batch_hasher<keccak_1600<DigestBits>>
+                    : public keccak_1600_multi_buffer_dispatch<keccak_1600_policy<DigestBits>, 0x01> { };
+
+                template<std::size_t DigestBits>
+                struct batch_hasher<sha3<DigestBits>>
+                    : public keccak_1600_multi_buffer_dispatch<sha3_policy<DigestBits>, 0x06> { };
+#endif
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_BATCH_HASHER_HPP
@@ -0,0 +1,310 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_BLAKE2_MULTI_BUFFER_HPP
+#define CRYPTO3_HASH_BLAKE2_MULTI_BUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/config.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Multi-buffer BLAKE2 compression: one block into each of several independent
+                 * states, one state per vector lane. States and message blocks are lane-interleaved,
+                 * vector i holding word i of every lane, so each G is a handful of vertical
+                 * operations with no shuffles between rows.
+                 *
+                 * Vectors are written with the compiler's generic vector extension and everything is
+                 * force-inlined, so the instruction set is the one of the entry point in
+                 * blake2_multi_buffer_simd the kernel ends up in.
+                 *
+                 * @tparam Lanes States compressed at once
+                 * @tparam PolicyType blake2b_policy or blake2s_policy
+                 */
+                template<std::size_t Lanes, typename PolicyType>
+                struct blake2_multi_buffer {
+                    constexpr static const std::size_t lanes = Lanes;
+
+                    typedef PolicyType policy_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+                    typedef word_type vector_type __attribute__((vector_size(lanes * sizeof(word_type))));
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t block_octets = policy_type::block_bits / octet_bits;
+                    typedef typename policy_type::block_type block_type;
+
+                    // G rotation distances
+                    constexpr static const int r1 = word_bits == 64 ? 32 : 16;
+                    constexpr static const int r2 = word_bits == 64 ? 24 : 12;
+                    constexpr static const int r3 = word_bits == 64 ? 16 : 8;
+                    constexpr static const int r4 = word_bits == 64 ? 63 : 7;
+
+                    /*!
+                     * @brief Compresses count stripes of lanes consecutive blocks, block l of every
+                     * stripe into state l. None of them is the last block of its node.
+                     *
+                     * @param h Lane-interleaved chaining values, word i of every state together
+                     * @param octets Octets every state has absorbed before the first stripe
+                     */
+                    BOOST_FORCEINLINE static void compress_stripes(word_type *h, const std::uint8_t *data,
+                                                                   std::size_t count, std::uint64_t octets) {
+                        // Vector registers are kept in plain arrays, std::array would drop their alignment attributes
+                        vector_type H[state_words];
+                        vector_type m[block_words];
+                        std::memcpy(H, h, sizeof(H));
+
+                        std::array<std::array<word_type, lanes>, block_words> words;
+                        for (; count; --count, data += lanes * block_octets) {
+                            for (std::size_t l = 0; l != lanes; ++l) {
+                                const std::uint8_t *p = data + l * block_octets;
+                                for (std::size_t t = 0; t != block_words; ++t, p += word_octets) {
+                                    word_type w;
+                                    std::memcpy(&w, p, word_octets);
+                                    words[t][l] = boost::endian::little_to_native(w);
+                                }
+                            }
+                            std::memcpy(m, words.data(), sizeof(m));
+
+                            octets += block_octets;
+                            compress(H, m, static_cast<word_type>(octets),
+                                     static_cast<word_type>(octets >> (word_bits - 1) >> 1), 0);
+                        }
+
+                        std::memcpy(h, H, sizeof(H));
+                    }
+
+                    /*!
+                     * @brief Compresses the same block into each of the n states, with the same
+                     * counter and finalization flag everywhere
+                     */
+                    BOOST_FORCEINLINE static void compress_blocks(state_type *states, std::size_t n,
+                                                                  const block_type &block, word_type t0,
+                                                                  word_type t1, word_type f0) {
+                        vector_type m[block_words];
+                        for (std::size_t t = 0; t != block_words; ++t) {
+                            m[t] = vector_type {} + block[t];
+                        }
+
+                        for (std::size_t i = 0; i < n; i += lanes) {
+                            std::size_t count = std::min(lanes, n - i);
+
+                            vector_type H[state_words];
+                            for (std::size_t w = 0; w != state_words; ++w) {
+                                for (std::size_t l = 0; l != lanes; ++l) {
+                                    H[w][l] = l < count ? states[i + l][w] : word_type();
+                                }
+                            }
+                            compress(H, m, t0, t1, f0);
+                            for (std::size_t w = 0; w != state_words; ++w) {
+                                for (std::size_t l = 0; l != count; ++l) {
+                                    states[i + l][w] = H[w][l];
+                                }
+                            }
+                        }
+                    }
+
+                protected:
+                    // Helpers take and hand back vectors by reference, so no vector crosses a call by value
+                    template<int N>
+                    BOOST_FORCEINLINE static void rotr(vector_type &x) {
+                        x = (x >> N) | (x << (word_bits - N));
+                    }
+
+                    BOOST_FORCEINLINE static void g(vector_type *v, std::size_t a, std::size_t b, std::size_t c,
+                                                    std::size_t d, const vector_type &x, const vector_type &y) {
+                        v[a] += v[b] + x;
+                        v[d] ^= v[a];
+                        rotr<r1>(v[d]);
+                        v[c] += v[d];
+                        v[b] ^= v[c];
+                        rotr<r2>(v[b]);
+                        v[a] += v[b] + y;
+                        v[d] ^= v[a];
+                        rotr<r3>(v[d]);
+                        v[c] += v[d];
+                        v[b] ^= v[c];
+                        rotr<r4>(v[b]);
+                    }
+
+                    /*!
+                     * @brief Compresses a block into each lane of h. Every lane has seen the same number
+                     * of octets, and the block is the last one of its node either in all lanes or in none.
+                     *
+                     * @param h Lane-interleaved chaining values
+                     * @param m Lane-interleaved message words
+                     * @param t0, t1 Low and high words of the octet counter
+                     * @param f0 Finalization flag, all ones for the last block of a node
+                     */
+                    BOOST_FORCEINLINE static void compress(vector_type *h, const vector_type *m, word_type t0,
+                                                           word_type t1, word_type f0) {
+                        vector_type v[2 * state_words];
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            v[i] = h[i];
+                            v[i + state_words] = vector_type {} + policy_type::iv[i];
+                        }
+                        v[12] ^= t0;
+                        v[13] ^= t1;
+                        v[14] ^= f0;
+
+                        for (std::size_t r = 0; r != policy_type::rounds; ++r) {
+                            const std::uint8_t *s = policy_type::sigma[r].data();
+
+                            g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+                            g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+                            g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+                            g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+                            g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+                            g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+                            g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+                            g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+                        }
+
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            h[i] ^= v[i] ^ v[i + state_words];
+                        }
+                    }
+                };
+
+#if BOOST_ARCH_X86_64
+                /*!
+                 * @brief Entry points compiling blake2_multi_buffer for the instruction sets
+                 * cpu_features reports. Only reachable through blake2_multi_buffer_dispatch.
+                 *
+                 * Stripes always take a 256-bit vector, as many lanes as BLAKE2bp and BLAKE2sp have
+                 * leaves; independent blocks take the widest vector of the instruction set.
+                 */
+                template<typename PolicyType>
+                struct blake2_multi_buffer_simd {
+                    typedef typename PolicyType::word_type word_type;
+                    typedef typename PolicyType::state_type state_type;
+                    typedef typename PolicyType::block_type block_type;
+
+                    constexpr static const std::size_t stripe_lanes = 256 / PolicyType::word_bits;
+
+                    template<std::size_t Lanes>
+                    using kernel_type = blake2_multi_buffer<Lanes, PolicyType>;
+
+                    static void compress_stripes_sse2(word_type *h, const std::uint8_t *data, std::size_t count,
+                                                      std::uint64_t octets) {
+                        kernel_type<stripe_lanes>::compress_stripes(h, data, count, octets);
+                    }
+
+                    static void compress_blocks_sse2(state_type *states, std::size_t n, const block_type &block,
+                                                     word_type t0, word_type t1, word_type f0) {
+                        kernel_type<128 / PolicyType::word_bits>::compress_blocks(states, n, block, t0, t1, f0);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void compress_stripes_avx2(word_type *h, const std::uint8_t *data, std::size_t count,
+                                                      std::uint64_t octets) {
+                        kernel_type<stripe_lanes>::compress_stripes(h, data, count, octets);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void compress_blocks_avx2(state_type *states, std::size_t n, const block_type &block,
+                                                     word_type t0, word_type t1, word_type f0) {
+                        kernel_type<256 / PolicyType::word_bits>::compress_blocks(states, n, block, t0, t1, f0);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void compress_blocks_avx512(state_type *states, std::size_t n, const block_type &block,
+                                                       word_type t0, word_type t1, word_type f0) {
+                        kernel_type<512 / PolicyType::word_bits>::compress_blocks(states, n, block, t0, t1, f0);
+                    }
+                };
+
+                /*!
+                 * @brief Multi-buffer BLAKE2 compression choosing its kernels from the features of the
+                 * CPU it runs on. The choice is made once, on first use.
+                 *
+                 * @tparam PolicyType blake2b_policy or blake2s_policy
+                 */
+                template<typename PolicyType>
+                struct blake2_multi_buffer_dispatch {
+                    typedef typename PolicyType::word_type word_type;
+                    typedef typename PolicyType::state_type state_type;
+                    typedef typename PolicyType::block_type block_type;
+
+                    // Leaves compress_stripes works on
+                    constexpr static const std::size_t stripe_lanes =
+                        blake2_multi_buffer_simd<PolicyType>::stripe_lanes;
+
+                    struct backend_type {
+                        const char *name;
+                        // States compress_blocks works on at once
+                        std::size_t lanes;
+                        void (*compress_stripes)(word_type *, const std::uint8_t *, std::size_t, std::uint64_t);
+                        void (*compress_blocks)(state_type *, std::size_t, const block_type &, word_type, word_type,
+                                                word_type);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        typedef blake2_multi_buffer_simd<PolicyType> simd_type;
+                        constexpr std::size_t word_bits = PolicyType::word_bits;
+
+                        // Stripes fill a 256-bit vector, AVX-512 has nothing to add to them
+                        if (features.avx512f) {
+                            return {"avx512", 512 / word_bits, &simd_type::compress_stripes_avx2,
+                                    &simd_type::compress_blocks_avx512};
+                        }
+                        if (features.avx2) {
+                            return {"avx2", 256 / word_bits, &simd_type::compress_stripes_avx2,
+                                    &simd_type::compress_blocks_avx2};
+                        }
+                        return {"sse2", 128 / word_bits, &simd_type::compress_stripes_sse2,
+                                &simd_type::compress_blocks_sse2};
+                    }
+                };
+
+#define CRYPTO3_HASH_BLAKE2_MULTI_BUFFER
+#endif
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2_MULTI_BUFFER_HPP
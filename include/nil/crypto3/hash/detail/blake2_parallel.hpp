@@ -0,0 +1,324 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE2_PARALLEL_HPP
+#define CRYPTO3_HASH_BLAKE2_PARALLEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/detail/octet.hpp>
+#include <nil/crypto3/detail/static_digest.hpp>
+
+#include <nil/crypto3/hash/detail/blake2_multi_buffer.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief The BLAKE2bp and BLAKE2sp parallel modes (BLAKE2 paper, section 2.10): a
+                 * tree of depth 2 whose Degree leaves take the message blocks in turn, block i going
+                 * to leaf i mod Degree, and whose root hashes the leaf digests together. The leaves
+                 * are independent, so a stripe of Degree blocks is compressed at once, one leaf per
+                 * vector lane, when blake2_multi_buffer has a 256-bit vector of as many lanes.
+                 *
+                 * Leaf chaining values are stored lane-interleaved, word i of every leaf together.
+                 *
+                 * @tparam PolicyType blake2b_policy or blake2s_policy
+                 * @tparam Compressor blake2b_compressor or blake2s_compressor
+                 * @tparam Degree Number of leaves: 4 for BLAKE2bp, 8 for BLAKE2sp
+                 * @tparam DigestBits
+                 */
+                template<typename PolicyType, typename Compressor, std::size_t Degree, std::size_t DigestBits>
+                class blake2_parallel {
+                public:
+                    typedef PolicyType policy_type;
+                    typedef Compressor compressor_type;
+                    typedef typename compressor_type::parameter_block_type parameter_block_type;
+
+                    constexpr static const std::size_t word_bits = compressor_type::word_bits;
+                    typedef typename compressor_type::word_type word_type;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+
+                    constexpr static const std::size_t state_words = compressor_type::state_words;
+                    typedef typename compressor_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = compressor_type::block_bits;
+                    constexpr static const std::size_t block_words = compressor_type::block_words;
+                    constexpr static const std::size_t block_octets = block_bits / octet_bits;
+                    typedef typename compressor_type::block_type block_type;
+
+                    constexpr static const std::size_t degree = Degree;
+                    constexpr static const std::size_t stripe_octets = degree * block_octets;
+
+                    constexpr static const std::size_t digest_bits = DigestBits;
+                    constexpr static const std::size_t digest_octets = digest_bits / octet_bits;
+                    typedef static_digest<digest_bits> digest_type;
+
+                    constexpr static const std::size_t max_key_octets = parameter_block_type::max_key_octets;
+                    // Leaves always output a full chaining value
+                    constexpr static const std::size_t inner_octets = parameter_block_type::max_digest_octets;
+
+                    BOOST_STATIC_ASSERT(digest_bits % octet_bits == 0 && digest_octets >= 1 &&
+                                        digest_octets <= parameter_block_type::max_digest_octets);
+
+                protected:
+                    constexpr static const word_type flag = ~word_type();
+
+#ifdef CRYPTO3_HASH_BLAKE2_MULTI_BUFFER
+                    typedef blake2_multi_buffer_dispatch<policy_type> multi_buffer_type;
+                    constexpr static const bool vectorized = multi_buffer_type::stripe_lanes == degree;
+#else
+                    constexpr static const bool vectorized = false;
+#endif
+
+                public:
+                    explicit blake2_parallel(const std::uint8_t *key = nullptr, std::size_t key_size = 0) :
+                        key_(), key_size_(key_size) {
+                        BOOST_ASSERT_MSG(key_size <= max_key_octets, "BLAKE2 key is longer than the digest");
+
+                        std::copy(key, key + key_size, key_.begin());
+                        reset();
+                    }
+
+                    template<typename KeyRange>
+                    explicit blake2_parallel(const KeyRange &key) :
+                        blake2_parallel(reinterpret_cast<const std::uint8_t *>(std::data(key)), std::size(key)) {
+                        BOOST_STATIC_ASSERT(sizeof(*std::data(key)) == 1);
+                    }
+
+                    inline blake2_parallel &update(const std::uint8_t *data, std::size_t n) {
+                        while (n) {
+                            if (buffered_ == buffer_.size()) {
+                                // The second stripe gives every leaf of the first one a block to follow
+                                process_stripes(buffer_.data(), 1);
+                                std::memcpy(buffer_.data(), buffer_.data() + stripe_octets, stripe_octets);
+                                buffered_ = stripe_octets;
+                            }
+
+                            if (!buffered_) {
+                                // Stripes followed by more than a stripe are never the last of their leaves
+                                std::size_t stripes = n > buffer_.size() ? (n - stripe_octets - 1) / stripe_octets : 0;
+                                process_stripes(data, stripes);
+                                data += stripes * stripe_octets;
+                                n -= stripes * stripe_octets;
+                            }
+
+                            std::size_t amount = std::min(n, buffer_.size() - buffered_);
+                            std::memcpy(buffer_.data() + buffered_, data, amount);
+                            buffered_ += amount;
+                            data += amount;
+                            n -= amount;
+                        }
+                        return *this;
+                    }
+
+                    template<typename ContiguousRange>
+                    inline blake2_parallel &update(const ContiguousRange &range) {
+                        BOOST_STATIC_ASSERT(sizeof(*std::data(range)) == 1);
+                        return update(reinterpret_cast<const std::uint8_t *>(std::data(range)), std::size(range));
+                    }
+
+                    /*!
+                     * @brief Returns the digest of the message seen so far and resets
+                     */
+                    inline digest_type finalize() {
+                        std::array<std::uint8_t, degree * inner_octets> inner;
+                        for (std::size_t l = 0; l != degree; ++l) {
+                            finish_leaf(l, inner.data() + l * inner_octets);
+                        }
+
+                        state_type root = node_parameters(0, 1).apply(policy_type::iv);
+                        const std::size_t root_blocks = inner.size() / block_octets;
+                        for (std::size_t b = 0; b != root_blocks; ++b) {
+                            const bool last = b + 1 == root_blocks;
+                            compressor_type::process_block(root, load_block(inner.data() + b * block_octets),
+                                                           (b + 1) * block_bits, last ? flag : 0, last ? flag : 0);
+                        }
+
+                        digest_type d;
+                        for (std::size_t i = 0; i != digest_octets; ++i) {
+                            d[i] = static_cast<std::uint8_t>(root[i / word_octets] >> ((i % word_octets) * octet_bits));
+                        }
+
+                        reset();
+                        return d;
+                    }
+
+                    inline void reset() {
+                        for (std::size_t l = 0; l != degree; ++l) {
+                            state_type s = node_parameters(l, 0).apply(policy_type::iv);
+                            for (std::size_t i = 0; i != state_words; ++i) {
+                                leaves_[i][l] = s[i];
+                            }
+                        }
+                        leaf_octets_ = 0;
+                        key_pending_ = key_size_ != 0;
+                        buffered_ = 0;
+                    }
+
+                protected:
+                    typedef std::array<std::array<word_type, degree>, state_words> leaves_type;
+
+                    inline parameter_block_type node_parameters(std::uint64_t offset, std::uint8_t depth) const {
+                        parameter_block_type params(digest_octets, static_cast<std::uint8_t>(key_size_));
+                        params.fanout = degree;
+                        params.depth = 2;
+                        params.node_offset = offset;
+                        params.node_depth = depth;
+                        params.inner_length = inner_octets;
+                        return params;
+                    }
+
+                    static inline block_type load_block(const std::uint8_t *p) {
+                        block_type block;
+                        for (std::size_t i = 0; i != block_words; ++i, p += word_octets) {
+                            word_type w;
+                            std::memcpy(&w, p, word_octets);
+                            block[i] = boost::endian::little_to_native(w);
+                        }
+                        return block;
+                    }
+
+                    inline state_type leaf(std::size_t l) const {
+                        state_type s;
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            s[i] = leaves_[i][l];
+                        }
+                        return s;
+                    }
+
+                    inline void set_leaf(std::size_t l, const state_type &s) {
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            leaves_[i][l] = s[i];
+                        }
+                    }
+
+                    // The zero-padded key is the first block of every leaf, absorbed once more input follows
+                    inline void absorb_key() {
+                        std::array<std::uint8_t, block_octets> padded = {};
+                        std::copy(key_.begin(), key_.begin() + key_size_, padded.begin());
+
+                        std::array<std::uint8_t, stripe_octets> stripe;
+                        for (std::size_t l = 0; l != degree; ++l) {
+                            std::copy(padded.begin(), padded.end(), stripe.begin() + l * block_octets);
+                        }
+                        key_pending_ = false;
+                        process_stripes(stripe.data(), 1);
+                    }
+
+                    // Compresses count whole stripes, none of which holds the last block of any leaf
+                    inline void process_stripes(const std::uint8_t *data, std::size_t count) {
+                        if (!count) {
+                            return;
+                        }
+                        if (key_pending_) {
+                            absorb_key();
+                        }
+
+#ifdef CRYPTO3_HASH_BLAKE2_MULTI_BUFFER
+                        if constexpr (vectorized) {
+                            multi_buffer_type::backend().compress_stripes(leaves_[0].data(), data, count,
+                                                                          leaf_octets_);
+                            leaf_octets_ += count * block_octets;
+                            return;
+                        }
+#endif
+
+                        for (; count; --count, data += stripe_octets) {
+                            leaf_octets_ += block_octets;
+                            for (std::size_t l = 0; l != degree; ++l) {
+                                state_type s = leaf(l);
+                                compressor_type::process_block(s, load_block(data + l * block_octets),
+                                                               leaf_octets_ * octet_bits);
+                                set_leaf(l, s);
+                            }
+                        }
+                    }
+
+                    // Compresses the blocks of leaf l still buffered, the last one as final, and writes its digest
+                    inline void finish_leaf(std::size_t l, std::uint8_t *out) {
+                        state_type s = leaf(l);
+                        std::uint64_t seen = leaf_octets_;
+
+                        std::array<block_type, 3> blocks;
+                        std::array<std::size_t, 3> sizes;
+                        std::size_t n = 0;
+
+                        if (key_pending_) {
+                            std::array<std::uint8_t, block_octets> padded = {};
+                            std::copy(key_.begin(), key_.begin() + key_size_, padded.begin());
+                            blocks[n] = load_block(padded.data());
+                            sizes[n++] = block_octets;
+                        }
+                        for (std::size_t offset = l * block_octets; offset < buffered_; offset += stripe_octets) {
+                            std::array<std::uint8_t, block_octets> padded = {};
+                            std::size_t size = std::min(block_octets, buffered_ - offset);
+                            std::memcpy(padded.data(), buffer_.data() + offset, size);
+                            blocks[n] = load_block(padded.data());
+                            sizes[n++] = size;
+                        }
+                        if (!n) {
+                            blocks[n] = block_type();
+                            sizes[n++] = 0;
+                        }
+
+                        for (std::size_t b = 0; b != n; ++b) {
+                            const bool last = b + 1 == n;
+                            seen += sizes[b];
+                            compressor_type::process_block(s, blocks[b], seen * octet_bits, last ? flag : 0,
+                                                           last && l + 1 == degree ? flag : 0);
+                        }
+
+                        for (std::size_t i = 0; i != inner_octets; ++i) {
+                            out[i] = static_cast<std::uint8_t>(s[i / word_octets] >> ((i % word_octets) * octet_bits));
+                        }
+                    }
+
+                    leaves_type leaves_;
+                    // Octets absorbed by each leaf in whole stripes, key block included
+                    std::uint64_t leaf_octets_;
+
+                    std::array<std::uint8_t, 2 * stripe_octets> buffer_;
+                    std::size_t buffered_;
+
+                    std::array<std::uint8_t, max_key_octets> key_;
+                    std::size_t key_size_;
+                    bool key_pending_;
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2_PARALLEL_HPP
@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_BLAKE2_PARAMETER_BLOCK_HPP
+#define CRYPTO3_HASH_BLAKE2_PARAMETER_BLOCK_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/integer.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief BLAKE2 parameter block (RFC 7693, section 2.5 and the BLAKE2 paper, section 2.8).
+                 * The initial chaining value is the IV XORed with it. The defaults describe plain
+                 * sequential hashing; keyed hashing, salt, personalization and tree hashing are set
+                 * through the fields. It is a literal type, so fixed parameter sets can be constexpr.
+                 *
+                 * @tparam WordBits 64 for BLAKE2b, 32 for BLAKE2s
+                 */
+                template<std::size_t WordBits>
+                struct blake2_parameter_block {
+                    BOOST_STATIC_ASSERT(WordBits == 64 || WordBits == 32);
+
+                    constexpr static const std::size_t word_bits = WordBits;
+                    typedef typename boost::uint_t<word_bits>::exact word_type;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+
+                    constexpr static const std::size_t words = 8;
+                    constexpr static const std::size_t octets = words * word_octets;
+
+                    constexpr static const std::size_t max_digest_octets = 8 * word_octets;
+                    constexpr static const std::size_t max_key_octets = 8 * word_octets;
+                    // 64 bits for BLAKE2b, 48 for BLAKE2s
+                    constexpr static const std::size_t node_offset_octets = word_bits == 64 ? 8 : 6;
+
+                    constexpr static const std::size_t salt_octets = 2 * word_octets;
+                    typedef std::array<std::uint8_t, salt_octets> salt_type;
+
+                    constexpr static const std::size_t personalization_octets = 2 * word_octets;
+                    typedef std::array<std::uint8_t, personalization_octets> personalization_type;
+
+                    constexpr explicit blake2_parameter_block(std::uint8_t digest_length = max_digest_octets,
+                                                              std::uint8_t key_length = 0) :
+                        digest_length(digest_length),
+                        key_length(key_length), fanout(1), depth(1), leaf_length(0), node_offset(0), node_depth(0),
+                        inner_length(0), salt(), personalization() {
+                    }
+
+                    /*!
+                     * @brief Parameters of sequential hashing with a salt and a personalization, each
+                     * zero-padded to its full size
+                     */
+                    template<typename SaltRange, typename PersonalizationRange>
+                    static blake2_parameter_block make(const SaltRange &salt,
+                                                       const PersonalizationRange &personalization) {
+                        BOOST_ASSERT_MSG(std::size(salt) <= salt_octets, "BLAKE2 salt is too long");
+                        BOOST_ASSERT_MSG(std::size(personalization) <= personalization_octets,
+                                         "BLAKE2 personalization is too long");
+
+                        blake2_parameter_block params;
+                        std::copy(std::cbegin(salt), std::cend(salt), params.salt.begin());
+                        std::copy(std::cbegin(personalization), std::cend(personalization),
+                                  params.personalization.begin());
+                        return params;
+                    }
+
+                    /*!
+                     * @return the parameter block in its serialized form
+                     */
+                    constexpr std::array<std::uint8_t, octets> to_octets() const {
+                        std::array<std::uint8_t, octets> p = {};
+                        p[0] = digest_length;
+                        p[1] = key_length;
+                        p[2] = fanout;
+                        p[3] = depth;
+                        for (std::size_t i = 0; i != 4; ++i) {
+                            p[4 + i] = static_cast<std::uint8_t>(leaf_length >> (i * octet_bits));
+                        }
+                        for (std::size_t i = 0; i != node_offset_octets; ++i) {
+                            p[8 + i] = static_cast<std::uint8_t>(node_offset >> (i * octet_bits));
+                        }
+                        p[8 + node_offset_octets] = node_depth;
+                        p[9 + node_offset_octets] = inner_length;
+                        for (std::size_t i = 0; i != salt_octets; ++i) {
+                            p[octets / 2 + i] = salt[i];
+                        }
+                        for (std::size_t i = 0; i != personalization_octets; ++i) {
+                            p[octets / 2 + salt_octets + i] = personalization[i];
+                        }
+                        return p;
+                    }
+
+                    /*!
+                     * @return the initial chaining value: iv with the parameter block XORed in
+                     */
+                    template<typename State>
+                    constexpr State apply(State iv) const {
+                        std::array<std::uint8_t, octets> p = to_octets();
+                        for (std::size_t i = 0; i != words; ++i) {
+                            word_type w = 0;
+                            for (std::size_t j = 0; j != word_octets; ++j) {
+                                w |= static_cast<word_type>(p[i * word_octets + j]) << (j * octet_bits);
+                            }
+                            iv[i] ^= w;
+                        }
+                        return iv;
+                    }
+
+                    std::uint8_t digest_length;
+                    std::uint8_t key_length;
+                    std::uint8_t fanout;
+                    std::uint8_t depth;
+                    std::uint32_t leaf_length;
+                    std::uint64_t node_offset;
+                    std::uint8_t node_depth;
+                    std::uint8_t inner_length;
+                    salt_type salt;
+                    personalization_type personalization;
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_BLAKE2_PARAMETER_BLOCK_HPP
@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE2B_AVX2_IMPL_HPP
+#define CRYPTO3_BLAKE2B_AVX2_IMPL_HPP
+
+#include <array>
+#include <cstdint>
+
+#include <nil/crypto3/hash/detail/blake2b/blake2b_policy.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+#include <immintrin.h>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief BLAKE2b compression function F with the 4x4 working matrix held in four
+                 * AVX2 rows. The column step runs the four G of a half-round at once; the diagonal
+                 * step rotates rows 1-3 so that the diagonals line up as columns, and back after.
+                 */
+                template<typename PolicyType>
+                struct blake2b_avx2_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    typedef typename policy_type::block_type block_type;
+
+                    constexpr static const std::size_t rounds = policy_type::rounds;
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static inline __m256i rotr24(__m256i x) {
+                        return _mm256_shuffle_epi8(x, _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8,
+                                                                       9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14,
+                                                                       15, 8, 9, 10));
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static inline __m256i rotr16(__m256i x) {
+                        return _mm256_shuffle_epi8(x, _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15,
+                                                                       8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13,
+                                                                       14, 15, 8, 9));
+                    }
+
+                    // Four G at once, one per column of rows a, b, c and d
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static inline void g(__m256i &a, __m256i &b, __m256i &c, __m256i &d, __m256i m0, __m256i m1) {
+                        a = _mm256_add_epi64(_mm256_add_epi64(a, b), m0);
+                        d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2, 3, 0, 1));
+                        c = _mm256_add_epi64(c, d);
+                        b = rotr24(_mm256_xor_si256(b, c));
+                        a = _mm256_add_epi64(_mm256_add_epi64(a, b), m1);
+                        d = rotr16(_mm256_xor_si256(d, a));
+                        c = _mm256_add_epi64(c, d);
+                        b = _mm256_xor_si256(b, c);
+                        b = _mm256_or_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static inline __m256i load(const block_type &block, const std::uint8_t *s) {
+                        return _mm256_setr_epi64x(block[s[0]], block[s[2]], block[s[4]], block[s[6]]);
+                    }
+
+                    /*!
+                     * @param t0, t1 Low and high words of the message octet counter
+                     * @param f0, f1 Last block and last node flags
+                     */
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void compress(state_type &h, const block_type &block, word_type t0, word_type t1,
+                                         word_type f0, word_type f1) {
+                        const __m256i h0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h.data()));
+                        const __m256i h1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h.data() + 4));
+
+                        __m256i a = h0, b = h1;
+                        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(policy_type::iv.data()));
+                        __m256i d = _mm256_xor_si256(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(policy_type::iv.data() + 4)),
+                            _mm256_setr_epi64x(t0, t1, f0, f1));
+
+                        for (std::size_t r = 0; r != rounds; ++r) {
+                            const std::uint8_t *s = policy_type::sigma[r].data();
+
+                            g(a, b, c, d, load(block, s), load(block, s + 1));
+
+                            // Diagonals to columns
+                            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+                            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+                            d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+
+                            g(a, b, c, d, load(block, s + 8), load(block, s + 9));
+
+                            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+                            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+                            d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+                        }
+
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(h.data()),
+                                            _mm256_xor_si256(h0, _mm256_xor_si256(a, c)));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(h.data() + 4),
+                                            _mm256_xor_si256(h1, _mm256_xor_si256(b, d)));
+                    }
+
+                    /*!
+                     * @brief Compresses n consecutive blocks, none of them the last of its node, in one call
+                     *
+                     * @param t Message octets counted up to and including the first block
+                     */
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void compress_blocks(state_type &h, const block_type *blocks, std::size_t n,
+                                                std::uint64_t t) {
+                        for (; n; --n, t += policy_type::block_bits / 8) {
+                            compress(h, *blocks++, static_cast<word_type>(t),
+                                     static_cast<word_type>(t >> (policy_type::word_bits - 1) >> 1), 0, 0);
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2B_AVX2_IMPL_HPP
@@ -26,11 +26,14 @@
 #ifndef CRYPTO3_BLAKE2B_FUNCTIONS_HPP
 #define CRYPTO3_BLAKE2B_FUNCTIONS_HPP
 
-#include <array>
+#include <boost/predef/architecture.h>
 
 #include <nil/crypto3/hash/detail/blake2b/blake2b_policy.hpp>
+#include <nil/crypto3/hash/detail/blake2b/blake2b_impl.hpp>
 
-#include <boost/static_assert.hpp>
+#if BOOST_ARCH_X86_64
+#include <nil/crypto3/hash/detail/blake2b/blake2b_dispatch_impl.hpp>
+#endif
 
 namespace nil {
     namespace crypto3 {
@@ -44,30 +47,21 @@ namespace nil {
 
                     constexpr static const std::size_t state_words = policy_type::state_words;
 
-                    inline static void g(word_type &a, word_type &b, word_type &c, word_type &d, word_type M0,
-                                         word_type M1) {
-                        a = a + b + M0;
-                        d = policy_type::template rotr<32>(d ^ a);
-                        c = c + d;
-                        b = policy_type::template rotr<24>(b ^ c);
-                        a = a + b + M1;
-                        d = policy_type::template rotr<16>(d ^ a);
-                        c = c + d;
-                        b = policy_type::template rotr<63>(b ^ c);
-                    }
+#if BOOST_ARCH_X86_64
+                    typedef blake2b_dispatch_impl<policy_type> impl_type;
+#else
+                    typedef blake2b_impl<policy_type> impl_type;
+#endif
 
-                    template<size_t i0, size_t i1, size_t i2, size_t i3, size_t i4, size_t i5, size_t i6, size_t i7,
-                             size_t i8, size_t i9, size_t iA, size_t iB, size_t iC, size_t iD, size_t iE, size_t iF>
-                    inline static void round(std::array<word_type, state_words * 2> &v,
-                                             const std::array<word_type, state_words * 2> &M) {
-                        g(v[0], v[4], v[8], v[12], M[i0], M[i1]);
-                        g(v[1], v[5], v[9], v[13], M[i2], M[i3]);
-                        g(v[2], v[6], v[10], v[14], M[i4], M[i5]);
-                        g(v[3], v[7], v[11], v[15], M[i6], M[i7]);
-                        g(v[0], v[5], v[10], v[15], M[i8], M[i9]);
-                        g(v[1], v[6], v[11], v[12], M[iA], M[iB]);
-                        g(v[2], v[7], v[8], v[13], M[iC], M[iD]);
-                        g(v[3], v[4], v[9], v[14], M[iE], M[iF]);
+                    /*!
+                     * @brief Name of the compression kernel impl_type runs on this host
+                     */
+                    static const char *backend() {
+#if BOOST_ARCH_X86_64
+                        return impl_type::backend().name;
+#else
+                        return "generic";
+#endif
                     }
                 };
             }    // namespace detail
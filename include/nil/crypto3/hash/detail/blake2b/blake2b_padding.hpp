@@ -28,6 +28,7 @@
 #define CRYPTO3_BLAKE2B_PADDING_HPP
 
 #include <nil/crypto3/hash/detail/blake2b/blake2b_policy.hpp>
+#include <nil/crypto3/hash/detail/octet_injector.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -48,11 +49,16 @@ namespace nil {
 
                     typedef ::nil::crypto3::detail::injector<endian_type, word_bits, block_words, block_bits>
                         injector_type;
+                    typedef octet_injector<endian_type, block_type> octet_injector_type;
 
                 public:
                     void operator()(block_type &block, word_type total_seen) {
                         // Pad block with zero bits if it is empty or incomplete
-                        if (!total_seen || total_seen % block_bits) {
+                        if (!(total_seen % octet_bits)) {
+                            if (!total_seen || total_seen % block_bits) {
+                                octet_injector_type::truncate(block, (total_seen % block_bits) / octet_bits);
+                            }
+                        } else if (!total_seen || total_seen % block_bits) {
                             word_type seen_words =
                                 ((total_seen / word_bits) % block_words) + ((total_seen % word_bits) ? 1 : 0);
                             std::fill(block.begin() + seen_words, block.end(), 0);
@@ -30,6 +30,8 @@
 #include <nil/crypto3/detail/basic_functions.hpp>
 #include <nil/crypto3/detail/inject.hpp>
 
+#include <nil/crypto3/hash/detail/blake2_parameter_block.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace hashes {
@@ -54,12 +56,32 @@ namespace nil {
 
                     constexpr static const std::size_t rounds = 12;
 
+                    // Message word permutations, sigma[r] for round r. Rounds 10 and 11 repeat 0 and 1
+                    typedef std::array<std::array<std::uint8_t, block_words>, rounds> sigma_type;
+                    constexpr static const sigma_type sigma = {{
+                        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+                        {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+                        {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+                        {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+                        {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+                        {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+                        {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+                        {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+                        {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+                        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+                    }};
+
+                    typedef blake2_parameter_block<word_bits> parameter_block_type;
+
+                    constexpr static const state_type iv = {
+                        {0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+                         0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179}};
+
                     struct iv_generator {
                         state_type const &operator()() const {
-                            constexpr static const state_type H0 = {
-                                {0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
-                                 0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179}};
-                            return H0;
+                            return iv;
                         }
                     };
 
@@ -67,6 +89,12 @@ namespace nil {
                     typedef typename boost::uint_t<salt_bits>::exact salt_type;
                     constexpr static const salt_type salt_value = 0xFFFFFFFFFFFFFFFF;
                 };
+
+                template<std::size_t DigestBits>
+                constexpr typename blake2b_policy<DigestBits>::state_type const blake2b_policy<DigestBits>::iv;
+
+                template<std::size_t DigestBits>
+                constexpr typename blake2b_policy<DigestBits>::sigma_type const blake2b_policy<DigestBits>::sigma;
             }    // namespace detail
         }        // namespace hashes
     }            // namespace crypto3
@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE2S_DISPATCH_IMPL_HPP
+#define CRYPTO3_BLAKE2S_DISPATCH_IMPL_HPP
+
+#include <nil/crypto3/hash/detail/blake2s/blake2s_policy.hpp>
+#include <nil/crypto3/hash/detail/blake2s/blake2s_impl.hpp>
+#include <nil/crypto3/hash/detail/blake2s/blake2s_sse41_impl.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief BLAKE2s compression choosing between the SSE4.1 and the portable kernels from
+                 * the features of the CPU it runs on. The choice is made once, on first use.
+                 */
+                template<typename PolicyType>
+                struct blake2s_dispatch_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+                    typedef typename policy_type::state_type state_type;
+                    typedef typename policy_type::block_type block_type;
+
+                    struct backend_type {
+                        const char *name;
+                        void (*compress)(state_type &, const block_type &, word_type, word_type, word_type,
+                                         word_type);
+                        void (*compress_blocks)(state_type &, const block_type *, std::size_t, std::uint64_t);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        if (features.sse4_1) {
+                            return {"sse4.1", &blake2s_sse41_impl<policy_type>::compress,
+                                    &blake2s_sse41_impl<policy_type>::compress_blocks};
+                        }
+                        return {"generic", &blake2s_impl<policy_type>::compress,
+                                &blake2s_impl<policy_type>::compress_blocks};
+                    }
+
+                    static inline void compress(state_type &h, const block_type &block, word_type t0, word_type t1,
+                                                word_type f0, word_type f1) {
+                        backend().compress(h, block, t0, t1, f0, f1);
+                    }
+
+                    /*!
+                     * @brief Resolves the backend once for all n blocks, which are compressed in the kernel
+                     */
+                    static inline void compress_blocks(state_type &h, const block_type *blocks, std::size_t n,
+                                                       std::uint64_t t) {
+                        backend().compress_blocks(h, blocks, n, t);
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2S_DISPATCH_IMPL_HPP
@@ -0,0 +1,72 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE2S_FUNCTIONS_HPP
+#define CRYPTO3_BLAKE2S_FUNCTIONS_HPP
+
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/hash/detail/blake2s/blake2s_policy.hpp>
+#include <nil/crypto3/hash/detail/blake2s/blake2s_impl.hpp>
+
+#if BOOST_ARCH_X86_64
+#include <nil/crypto3/hash/detail/blake2s/blake2s_dispatch_impl.hpp>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                template<std::size_t DigestBits>
+                struct blake2s_functions : public blake2s_policy<DigestBits> {
+                    typedef blake2s_policy<DigestBits> policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+
+#if BOOST_ARCH_X86_64
+                    typedef blake2s_dispatch_impl<policy_type> impl_type;
+#else
+                    typedef blake2s_impl<policy_type> impl_type;
+#endif
+
+                    /*!
+                     * @brief Name of the compression kernel impl_type runs on this host
+                     */
+                    static const char *backend() {
+#if BOOST_ARCH_X86_64
+                        return impl_type::backend().name;
+#else
+                        return "generic";
+#endif
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2S_FUNCTIONS_HPP
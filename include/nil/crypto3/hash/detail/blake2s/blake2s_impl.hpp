@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE2S_IMPL_HPP
+#define CRYPTO3_BLAKE2S_IMPL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <nil/crypto3/hash/detail/blake2s/blake2s_policy.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Portable BLAKE2s compression function F, one G at a time
+                 */
+                template<typename PolicyType>
+                struct blake2s_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    typedef typename policy_type::block_type block_type;
+
+                    typedef std::array<word_type, state_words * 2> work_type;
+
+                    inline static void g(word_type &a, word_type &b, word_type &c, word_type &d, word_type M0,
+                                         word_type M1) {
+                        a = a + b + M0;
+                        d = policy_type::template rotr<16>(d ^ a);
+                        c = c + d;
+                        b = policy_type::template rotr<12>(b ^ c);
+                        a = a + b + M1;
+                        d = policy_type::template rotr<8>(d ^ a);
+                        c = c + d;
+                        b = policy_type::template rotr<7>(b ^ c);
+                    }
+
+                    template<size_t i0, size_t i1, size_t i2, size_t i3, size_t i4, size_t i5, size_t i6, size_t i7,
+                             size_t i8, size_t i9, size_t iA, size_t iB, size_t iC, size_t iD, size_t iE, size_t iF>
+                    inline static void round(work_type &v, const block_type &M) {
+                        g(v[0], v[4], v[8], v[12], M[i0], M[i1]);
+                        g(v[1], v[5], v[9], v[13], M[i2], M[i3]);
+                        g(v[2], v[6], v[10], v[14], M[i4], M[i5]);
+                        g(v[3], v[7], v[11], v[15], M[i6], M[i7]);
+                        g(v[0], v[5], v[10], v[15], M[i8], M[i9]);
+                        g(v[1], v[6], v[11], v[12], M[iA], M[iB]);
+                        g(v[2], v[7], v[8], v[13], M[iC], M[iD]);
+                        g(v[3], v[4], v[9], v[14], M[iE], M[iF]);
+                    }
+
+                    /*!
+                     * @param t0, t1 Low and high words of the message octet counter
+                     * @param f0, f1 Last block and last node flags
+                     */
+                    static void compress(state_type &h, const block_type &block, word_type t0, word_type t1,
+                                         word_type f0, word_type f1) {
+                        work_type v;
+
+                        std::copy(h.begin(), h.end(), v.begin());
+                        std::copy(policy_type::iv.begin(), policy_type::iv.end(), v.begin() + state_words);
+
+                        v[12] ^= t0;
+                        v[13] ^= t1;
+                        v[14] ^= f0;
+                        v[15] ^= f1;
+
+                        round<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15>(v, block);
+                        round<14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3>(v, block);
+                        round<11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4>(v, block);
+                        round<7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8>(v, block);
+                        round<9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13>(v, block);
+                        round<2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9>(v, block);
+                        round<12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11>(v, block);
+                        round<13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10>(v, block);
+                        round<6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5>(v, block);
+                        round<10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0>(v, block);
+
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            h[i] ^= v[i] ^ v[i + state_words];
+                        }
+                    }
+
+                    /*!
+                     * @brief Compresses n consecutive blocks, none of them the last of its node, in one call
+                     *
+                     * @param t Message octets counted up to and including the first block
+                     */
+                    static void compress_blocks(state_type &h, const block_type *blocks, std::size_t n,
+                                                std::uint64_t t) {
+                        for (; n; --n, t += policy_type::block_bits / 8) {
+                            compress(h, *blocks++, static_cast<word_type>(t),
+                                     static_cast<word_type>(t >> (policy_type::word_bits - 1) >> 1), 0, 0);
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2S_IMPL_HPP
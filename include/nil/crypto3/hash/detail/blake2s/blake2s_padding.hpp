@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_BLAKE2S_PADDING_HPP
+#define CRYPTO3_BLAKE2S_PADDING_HPP
+
+#include <cstdint>
+
+#include <nil/crypto3/hash/detail/blake2s/blake2s_policy.hpp>
+#include <nil/crypto3/hash/detail/octet_injector.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                template<typename Hash>
+                class blake2s_padding {
+                    typedef Hash policy_type;
+
+                    typedef typename policy_type::digest_endian endian_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t block_bits = policy_type::block_bits;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    typedef typename policy_type::block_type block_type;
+
+                    typedef ::nil::crypto3::detail::injector<endian_type, word_bits, block_words, block_bits>
+                        injector_type;
+                    typedef octet_injector<endian_type, block_type> octet_injector_type;
+
+                public:
+                    // Message lengths in bits exceed a 32-bit word
+                    void operator()(block_type &block, std::uint64_t total_seen) {
+                        // Pad block with zero bits if it is empty or incomplete
+                        if (!(total_seen % octet_bits)) {
+                            if (!total_seen || total_seen % block_bits) {
+                                octet_injector_type::truncate(block, (total_seen % block_bits) / octet_bits);
+                            }
+                        } else if (!total_seen || total_seen % block_bits) {
+                            std::size_t seen_words =
+                                ((total_seen / word_bits) % block_words) + ((total_seen % word_bits) ? 1 : 0);
+                            std::fill(block.begin() + seen_words, block.end(), 0);
+                            // Pad with zeros last significant word if it is incomplete
+                            if (total_seen % word_bits) {
+                                std::size_t block_seen = total_seen % block_bits;
+                                injector_type::inject(word_type(), word_bits - block_seen % word_bits, block,
+                                                      block_seen);
+                            }
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2S_PADDING_HPP
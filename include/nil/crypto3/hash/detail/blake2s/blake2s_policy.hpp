@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE2S_POLICY_HPP
+#define CRYPTO3_BLAKE2S_POLICY_HPP
+
+#include <nil/crypto3/detail/static_digest.hpp>
+#include <nil/crypto3/detail/basic_functions.hpp>
+#include <nil/crypto3/detail/inject.hpp>
+
+#include <nil/crypto3/hash/detail/blake2_parameter_block.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                template<std::size_t DigestBits>
+                struct blake2s_policy : public ::nil::crypto3::detail::basic_functions<32> {
+
+                    constexpr static const std::size_t state_bits = 256;
+                    constexpr static const std::size_t state_words = state_bits / word_bits;
+                    typedef std::array<word_type, state_words> state_type;
+
+                    constexpr static const std::size_t block_bits = 512;
+                    constexpr static const std::size_t block_words = block_bits / word_bits;
+                    typedef std::array<word_type, block_words> block_type;
+
+                    // The octet counter spans two words
+                    constexpr static const std::size_t length_bits = 2 * word_bits;
+
+                    typedef typename stream_endian::little_octet_big_bit digest_endian;
+
+                    constexpr static const std::size_t digest_bits = DigestBits;
+                    typedef static_digest<digest_bits> digest_type;
+
+                    constexpr static const std::size_t rounds = 10;
+
+                    // Message word permutations, sigma[r] for round r
+                    typedef std::array<std::array<std::uint8_t, block_words>, rounds> sigma_type;
+                    constexpr static const sigma_type sigma = {{
+                        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+                        {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+                        {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+                        {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+                        {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+                        {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+                        {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+                        {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+                        {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+                    }};
+
+                    typedef blake2_parameter_block<word_bits> parameter_block_type;
+
+                    constexpr static const state_type iv = {
+                        {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab,
+                         0x5be0cd19}};
+
+                    struct iv_generator {
+                        state_type const &operator()() const {
+                            return iv;
+                        }
+                    };
+
+                    constexpr static const std::size_t salt_bits = 32;
+                    typedef typename boost::uint_t<salt_bits>::exact salt_type;
+                    constexpr static const salt_type salt_value = 0xFFFFFFFF;
+                };
+
+                template<std::size_t DigestBits>
+                constexpr typename blake2s_policy<DigestBits>::state_type const blake2s_policy<DigestBits>::iv;
+
+                template<std::size_t DigestBits>
+                constexpr typename blake2s_policy<DigestBits>::sigma_type const blake2s_policy<DigestBits>::sigma;
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2S_POLICY_HPP
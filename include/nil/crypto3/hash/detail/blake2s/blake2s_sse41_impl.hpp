@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE2S_SSE41_IMPL_HPP
+#define CRYPTO3_BLAKE2S_SSE41_IMPL_HPP
+
+#include <cstdint>
+
+#include <nil/crypto3/hash/detail/blake2s/blake2s_policy.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+#include <immintrin.h>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief BLAKE2s compression function F with the 4x4 working matrix held in four
+                 * SSE rows, as in blake2b_avx2_impl. The rows of 32-bit words fit 128-bit registers,
+                 * so wider vectors do not help a single message; BLAKE2sp uses AVX2 for eight.
+                 */
+                template<typename PolicyType>
+                struct blake2s_sse41_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    typedef typename policy_type::block_type block_type;
+
+                    constexpr static const std::size_t rounds = policy_type::rounds;
+
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static inline __m128i rotr16(__m128i x) {
+                        return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+                    }
+
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static inline __m128i rotr8(__m128i x) {
+                        return _mm_shuffle_epi8(x, _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12));
+                    }
+
+                    // Four G at once, one per column of rows a, b, c and d
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static inline void g(__m128i &a, __m128i &b, __m128i &c, __m128i &d, __m128i m0, __m128i m1) {
+                        a = _mm_add_epi32(_mm_add_epi32(a, b), m0);
+                        d = rotr16(_mm_xor_si128(d, a));
+                        c = _mm_add_epi32(c, d);
+                        b = _mm_xor_si128(b, c);
+                        b = _mm_or_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+                        a = _mm_add_epi32(_mm_add_epi32(a, b), m1);
+                        d = rotr8(_mm_xor_si128(d, a));
+                        c = _mm_add_epi32(c, d);
+                        b = _mm_xor_si128(b, c);
+                        b = _mm_or_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+                    }
+
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static inline __m128i load(const block_type &block, const std::uint8_t *s) {
+                        return _mm_setr_epi32(static_cast<int>(block[s[0]]), static_cast<int>(block[s[2]]),
+                                              static_cast<int>(block[s[4]]), static_cast<int>(block[s[6]]));
+                    }
+
+                    /*!
+                     * @param t0, t1 Low and high words of the message octet counter
+                     * @param f0, f1 Last block and last node flags
+                     */
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static void compress(state_type &h, const block_type &block, word_type t0, word_type t1,
+                                         word_type f0, word_type f1) {
+                        const __m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h.data()));
+                        const __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h.data() + 4));
+
+                        __m128i a = h0, b = h1;
+                        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(policy_type::iv.data()));
+                        __m128i d = _mm_xor_si128(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(policy_type::iv.data() + 4)),
+                            _mm_setr_epi32(static_cast<int>(t0), static_cast<int>(t1), static_cast<int>(f0),
+                                           static_cast<int>(f1)));
+
+                        for (std::size_t r = 0; r != rounds; ++r) {
+                            const std::uint8_t *s = policy_type::sigma[r].data();
+
+                            g(a, b, c, d, load(block, s), load(block, s + 1));
+
+                            // Diagonals to columns
+                            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1));
+                            c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+                            d = _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 1, 0, 3));
+
+                            g(a, b, c, d, load(block, s + 8), load(block, s + 9));
+
+                            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3));
+                            c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+                            d = _mm_shuffle_epi32(d, _MM_SHUFFLE(0, 3, 2, 1));
+                        }
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(h.data()), _mm_xor_si128(h0, _mm_xor_si128(a, c)));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(h.data() + 4),
+                                         _mm_xor_si128(h1, _mm_xor_si128(b, d)));
+                    }
+
+                    /*!
+                     * @brief Compresses n consecutive blocks, none of them the last of its node, in one call
+                     *
+                     * @param t Message octets counted up to and including the first block
+                     */
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static void compress_blocks(state_type &h, const block_type *blocks, std::size_t n,
+                                                std::uint64_t t) {
+                        for (; n; --n, t += policy_type::block_bits / 8) {
+                            compress(h, *blocks++, static_cast<word_type>(t),
+                                     static_cast<word_type>(t >> (policy_type::word_bits - 1) >> 1), 0, 0);
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE2S_SSE41_IMPL_HPP
@@ -0,0 +1,401 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE3_CONSTRUCTION_HPP
+#define CRYPTO3_BLAKE3_CONSTRUCTION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <boost/predef/other/endian.h>
+
+#include <nil/crypto3/detail/octet.hpp>
+#include <nil/crypto3/detail/static_digest.hpp>
+
+#include <nil/crypto3/hash/detail/parallel_for.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Node of a BLAKE3 tree before its last compression: either its chaining value
+                 * or, at the root, as many output octets as are asked for
+                 */
+                template<typename PolicyType>
+                struct blake3_output_node {
+                    typedef PolicyType policy_type;
+                    typedef typename policy_type::impl_type impl_type;
+
+                    typedef typename policy_type::word_type word_type;
+                    constexpr static const std::size_t word_octets = policy_type::word_bits / octet_bits;
+                    typedef typename policy_type::state_type state_type;
+                    typedef typename policy_type::block_type block_type;
+                    typedef typename policy_type::output_type output_type;
+
+                    constexpr static const std::size_t output_octets = output_type().size() * word_octets;
+
+                    inline state_type chaining_value() const {
+                        state_type s = cv;
+                        impl_type::compress(s, block, counter, block_len, flags);
+                        return s;
+                    }
+
+                    /*!
+                     * @brief Writes octets [offset, offset + n) of the extendable output of the root
+                     */
+                    inline void squeeze(std::uint8_t *out, std::size_t n, std::uint64_t offset = 0) const {
+                        while (n) {
+                            const output_type o = impl_type::compress_xof(cv, block, offset / output_octets,
+                                                                          block_len, flags | policy_type::root);
+                            std::size_t first = offset % output_octets;
+                            std::size_t amount = std::min(n, output_octets - first);
+                            for (std::size_t i = first; i != first + amount; ++i) {
+                                const word_type w = o[i / word_octets];
+                                *out++ = static_cast<std::uint8_t>(w >> ((i % word_octets) * octet_bits));
+                            }
+                            offset += amount;
+                            n -= amount;
+                        }
+                    }
+
+                    state_type cv;
+                    block_type block;
+                    std::uint64_t counter;
+                    word_type block_len;
+                    word_type flags;
+                };
+
+                /*!
+                 * @brief The BLAKE3 tree: the message is split into 1 KiB chunks, hashed from the key
+                 * words, and their chaining values are merged pairwise by parent nodes up to the root.
+                 * Completed subtrees are kept on a stack, one per set bit of the chunk count.
+                 *
+                 * Like the other constructions it is handed every block but the last one, which
+                 * comes with digest(), so a completed chunk is never the root. Runs of whole chunks
+                 * are hashed as complete subtrees by the kernel of impl_type, several chunks at once,
+                 * and by several threads when threads() allows them.
+                 *
+                 * @tparam Params
+                 * @tparam PolicyType blake3_functions
+                 */
+                template<typename Params, typename PolicyType>
+                class blake3_construction {
+                public:
+                    typedef PolicyType policy_type;
+                    typedef typename policy_type::impl_type impl_type;
+                    typedef blake3_output_node<policy_type> output_node_type;
+
+                    typedef typename Params::digest_endian endian_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+
+                    constexpr static const std::size_t state_bits = policy_type::state_bits;
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    constexpr static const std::size_t state_octets = state_bits / octet_bits;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = policy_type::block_bits;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t block_octets = policy_type::block_octets;
+                    typedef typename policy_type::block_type block_type;
+
+                    constexpr static const std::size_t chunk_blocks = policy_type::chunk_blocks;
+                    constexpr static const std::size_t chunk_octets = policy_type::chunk_octets;
+
+                    constexpr static const std::size_t digest_bits = Params::digest_bits;
+                    constexpr static const std::size_t digest_octets = digest_bits / octet_bits;
+                    typedef static_digest<digest_bits> digest_type;
+
+                    /*!
+                     * @brief Whole blocks may be absorbed straight from octets with process_octets
+                     */
+                    constexpr static const bool native_lane_order = BOOST_ENDIAN_LITTLE_BYTE;
+
+                protected:
+                    // One entry per level of a tree over 2^64 octets
+                    constexpr static const std::size_t max_depth = 54;
+
+                    // Subtrees up to this many chunks are reduced in a buffer on the stack
+                    constexpr static const std::size_t stride_level = 6;
+                    constexpr static const std::size_t stride_chunks = std::size_t(1) << stride_level;
+
+                    // Chunks handed over to each thread at least
+                    constexpr static const std::size_t thread_chunks = 256;
+
+                public:
+                    blake3_construction() : threads_(1) {
+                        reset();
+                    }
+
+                    inline void reset() {
+                        reset(policy_type::iv, 0);
+                    }
+
+                    /*!
+                     * @brief Starts a message hashed from key, with flags on every compression: the key
+                     * words with keyed_hash, a derived key with derive_key_material, the IV otherwise
+                     */
+                    inline void reset(const state_type &key, word_type flags) {
+                        key_ = key;
+                        flags_ = flags;
+                        chunk_cv_ = key;
+                        chunk_seen_ = 0;
+                        chunks_ = 0;
+                        stack_size_ = 0;
+                    }
+
+                    /*!
+                     * @brief Sets the amount of threads long runs of whole chunks are spread over
+                     */
+                    inline void threads(std::size_t n) {
+                        threads_ = std::max<std::size_t>(n, 1);
+                    }
+
+                    inline std::size_t threads() const {
+                        return threads_;
+                    }
+
+                    template<typename Integer = std::size_t>
+                    inline blake3_construction &process_block(const block_type &block, Integer = Integer()) {
+                        word_type f = flags_ | (chunk_seen_ ? 0 : policy_type::chunk_start);
+                        if (chunk_seen_ + 1 == chunk_blocks) {
+                            f |= policy_type::chunk_end;
+                        }
+                        impl_type::compress(chunk_cv_, block, chunks_, block_octets, f);
+
+                        if (++chunk_seen_ == chunk_blocks) {
+                            push(chunk_cv_, 0);
+                            chunk_cv_ = key_;
+                            chunk_seen_ = 0;
+                        }
+                        return *this;
+                    }
+
+                    /*!
+                     * @param seen Message bits counted up to and including the first block
+                     */
+                    template<typename Integer = std::size_t>
+                    inline blake3_construction &process_blocks(const block_type *blocks, std::size_t n,
+                                                               Integer seen = Integer()) {
+#if BOOST_ENDIAN_LITTLE_BYTE
+                        // Blocks of words are laid out as the octets they were packed from
+                        return process_octets(reinterpret_cast<const std::uint8_t *>(blocks), n, seen);
+#else
+                        for (; n; --n) {
+                            process_block(*blocks++);
+                        }
+                        return *this;
+#endif
+                    }
+
+                    /*!
+                     * @brief Absorbs n whole blocks of contiguous octets
+                     */
+                    template<typename Integer = std::size_t>
+                    inline blake3_construction &process_octets(const std::uint8_t *data, std::size_t n,
+                                                               Integer = Integer()) {
+                        while (n) {
+                            if (!chunk_seen_ && n >= chunk_blocks) {
+                                std::size_t chunks = process_subtree(data, n / chunk_blocks);
+                                data += chunks * chunk_octets;
+                                n -= chunks * chunk_blocks;
+                            } else {
+                                process_block(impl_type::load_block(data));
+                                data += block_octets;
+                                --n;
+                            }
+                        }
+                        return *this;
+                    }
+
+                    /*!
+                     * @brief The root node of the message seen so far and block, its last one. The
+                     * construction itself is left as it is.
+                     *
+                     * @param total_seen Message bits, block included
+                     */
+                    inline output_node_type output(const block_type &block, std::size_t total_seen) const {
+                        const std::uint64_t absorbed = (chunks_ * chunk_blocks + chunk_seen_) * block_octets;
+                        const std::size_t last_octets = static_cast<std::size_t>(total_seen / octet_bits - absorbed);
+
+                        output_node_type node;
+                        node.cv = chunk_cv_;
+                        node.block = block;
+                        // Octets past the message may hold anything
+                        for (std::size_t i = last_octets; i != block_octets; ++i) {
+                            node.block[i / word_octets] &= ~(word_type(0xFF) << ((i % word_octets) * octet_bits));
+                        }
+                        node.counter = chunks_;
+                        node.block_len = static_cast<word_type>(last_octets);
+                        node.flags = flags_ | policy_type::chunk_end | (chunk_seen_ ? 0 : policy_type::chunk_start);
+
+                        for (std::size_t i = stack_size_; i--;) {
+                            node = parent_node(stack_[i], node.chaining_value());
+                        }
+                        return node;
+                    }
+
+                    inline digest_type digest(const block_type &block = block_type(), std::size_t total_seen = 0) {
+                        digest_type d;
+                        output(block, total_seen).squeeze(d.data(), digest_octets);
+                        return d;
+                    }
+
+                protected:
+                    inline output_node_type parent_node(const state_type &left, const state_type &right) const {
+                        output_node_type node;
+                        node.cv = key_;
+                        std::copy(left.begin(), left.end(), node.block.begin());
+                        std::copy(right.begin(), right.end(), node.block.begin() + state_words);
+                        node.counter = 0;
+                        node.block_len = block_octets;
+                        node.flags = flags_ | policy_type::parent;
+                        return node;
+                    }
+
+                    inline state_type parent_cv(const state_type &left, const state_type &right) const {
+                        return parent_node(left, right).chaining_value();
+                    }
+
+                    /*!
+                     * @brief Pushes the chaining value of a complete subtree of 2^level chunks, which
+                     * starts at chunk chunks_, and merges the subtrees it completes
+                     */
+                    inline void push(const state_type &cv, std::size_t level) {
+                        chunks_ += std::uint64_t(1) << level;
+                        stack_[stack_size_++] = cv;
+                        for (; !((chunks_ >> level) & 1); ++level) {
+                            --stack_size_;
+                            stack_[stack_size_ - 1] = parent_cv(stack_[stack_size_ - 1], stack_[stack_size_]);
+                        }
+                    }
+
+                    /*!
+                     * @brief Hashes the largest complete subtree among the available whole chunks that
+                     * starts at chunk chunks_, and returns its size in chunks
+                     */
+                    inline std::size_t process_subtree(const std::uint8_t *data, std::size_t available) {
+                        std::size_t level = 0;
+                        // A subtree of 2^level chunks may only start at a multiple of its size
+                        while ((std::size_t(2) << level) <= available &&
+                               !(chunks_ & ((std::uint64_t(2) << level) - 1))) {
+                            ++level;
+                        }
+
+                        push(subtree_cv(data, level, chunks_), level);
+                        return std::size_t(1) << level;
+                    }
+
+                    inline state_type subtree_cv(const std::uint8_t *data, std::size_t level,
+                                                 std::uint64_t counter) const {
+                        std::size_t parts = 1;
+                        while (2 * parts <= threads_ && thread_chunks * 2 * parts <= (std::size_t(1) << level)) {
+                            parts *= 2;
+                        }
+                        if (parts == 1) {
+                            return subtree_cv_serial(data, level, counter);
+                        }
+
+                        // Each thread takes a complete subtree of its own, their roots are merged here
+                        std::size_t part_level = level;
+                        for (std::size_t p = parts; p > 1; p /= 2) {
+                            --part_level;
+                        }
+                        const std::size_t part_chunks = std::size_t(1) << part_level;
+
+                        std::vector<state_type> cvs(parts);
+                        parallel_for(parts, parts, [&](std::size_t first, std::size_t last) {
+                            for (std::size_t p = first; p != last; ++p) {
+                                cvs[p] = subtree_cv_serial(data + p * part_chunks * chunk_octets, part_level,
+                                                           counter + p * part_chunks);
+                            }
+                        });
+
+                        for (; parts > 1; parts /= 2) {
+                            for (std::size_t p = 0; p != parts / 2; ++p) {
+                                cvs[p] = parent_cv(cvs[2 * p], cvs[2 * p + 1]);
+                            }
+                        }
+                        return cvs[0];
+                    }
+
+                    inline state_type subtree_cv_serial(const std::uint8_t *data, std::size_t level,
+                                                        std::uint64_t counter) const {
+                        if (level > stride_level) {
+                            const std::size_t half = std::size_t(1) << (level - 1);
+                            return parent_cv(subtree_cv_serial(data, level - 1, counter),
+                                             subtree_cv_serial(data + half * chunk_octets, level - 1, counter + half));
+                        }
+
+                        std::size_t count = std::size_t(1) << level;
+                        std::array<const std::uint8_t *, stride_chunks> inputs;
+                        std::array<std::uint8_t, stride_chunks * state_octets> cvs;
+                        for (std::size_t i = 0; i != count; ++i) {
+                            inputs[i] = data + i * chunk_octets;
+                        }
+                        impl_type::hash_many(inputs.data(), count, chunk_blocks, key_, counter, true, flags_,
+                                             policy_type::chunk_start, policy_type::chunk_end, cvs.data());
+
+                        // A parent block is two adjacent chaining values. Parents overwrite the level
+                        // below in place, never ahead of the children still to be read.
+                        for (; count > 1; count /= 2) {
+                            for (std::size_t i = 0; i != count / 2; ++i) {
+                                inputs[i] = cvs.data() + i * block_octets;
+                            }
+                            impl_type::hash_many(inputs.data(), count / 2, 1, key_, 0, false,
+                                                 flags_ | policy_type::parent, 0, 0, cvs.data());
+                        }
+
+                        block_type words = impl_type::load_block(cvs.data());
+                        state_type cv;
+                        std::copy(words.begin(), words.begin() + state_words, cv.begin());
+                        return cv;
+                    }
+
+                    state_type key_;
+                    word_type flags_;
+
+                    state_type chunk_cv_;
+                    // Blocks of the current chunk compressed so far
+                    std::size_t chunk_seen_;
+                    // Chunks completed so far, the counter of the current one
+                    std::uint64_t chunks_;
+
+                    std::array<state_type, max_depth> stack_;
+                    std::size_t stack_size_;
+
+                    std::size_t threads_;
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE3_CONSTRUCTION_HPP
@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE3_DISPATCH_IMPL_HPP
+#define CRYPTO3_BLAKE3_DISPATCH_IMPL_HPP
+
+#include <nil/crypto3/hash/detail/blake3/blake3_impl.hpp>
+#include <nil/crypto3/hash/detail/blake3/blake3_simd_impl.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief BLAKE3 chunk hashing choosing between the AVX-512, AVX2, SSE4.1 and portable
+                 * kernels, 16, 8, 4 and 1 chunks at a time, from the features of the CPU it runs on.
+                 * The choice is made once, on first use. Single compressions always take the portable
+                 * path.
+                 */
+                template<typename PolicyType>
+                struct blake3_dispatch_impl : public blake3_impl<PolicyType> {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+                    typedef typename policy_type::state_type state_type;
+
+                    struct backend_type {
+                        const char *name;
+                        // Inputs hashed at once
+                        std::size_t degree;
+                        void (*hash_many)(const std::uint8_t *const *, std::size_t, std::size_t, const state_type &,
+                                          std::uint64_t, bool, word_type, word_type, word_type, std::uint8_t *);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        typedef blake3_simd_impl<policy_type> simd_type;
+
+                        if (features.avx512f) {
+                            return {"avx512", 16, &simd_type::hash_many_avx512};
+                        }
+                        if (features.avx2) {
+                            return {"avx2", 8, &simd_type::hash_many_avx2};
+                        }
+                        if (features.sse4_1) {
+                            return {"sse4.1", 4, &simd_type::hash_many_sse41};
+                        }
+                        return {"generic", 1, &blake3_impl<policy_type>::hash_many};
+                    }
+
+                    static inline std::size_t degree() {
+                        return backend().degree;
+                    }
+
+                    static inline void hash_many(const std::uint8_t *const *inputs, std::size_t count,
+                                                 std::size_t blocks, const state_type &key, std::uint64_t counter,
+                                                 bool increment_counter, word_type flags, word_type flags_start,
+                                                 word_type flags_end, std::uint8_t *out) {
+                        backend().hash_many(inputs, count, blocks, key, counter, increment_counter, flags, flags_start,
+                                            flags_end, out);
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE3_DISPATCH_IMPL_HPP
@@ -0,0 +1,182 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE3_IMPL_HPP
+#define CRYPTO3_BLAKE3_IMPL_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include <boost/endian/conversion.hpp>
+
+#include <nil/crypto3/hash/detail/blake3/blake3_policy.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Portable BLAKE3 compression function, one G at a time, and the chunk
+                 * hashing loop built on it
+                 */
+                template<typename PolicyType>
+                struct blake3_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+                    constexpr static const std::size_t word_octets = policy_type::word_bits / octet_bits;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t block_octets = policy_type::block_octets;
+                    typedef typename policy_type::block_type block_type;
+
+                    typedef typename policy_type::output_type output_type;
+                    typedef output_type work_type;
+
+                    inline static void g(word_type &a, word_type &b, word_type &c, word_type &d, word_type x,
+                                         word_type y) {
+                        a = a + b + x;
+                        d = policy_type::template rotr<16>(d ^ a);
+                        c = c + d;
+                        b = policy_type::template rotr<12>(b ^ c);
+                        a = a + b + y;
+                        d = policy_type::template rotr<8>(d ^ a);
+                        c = c + d;
+                        b = policy_type::template rotr<7>(b ^ c);
+                    }
+
+                    inline static void round(work_type &v, const block_type &m, std::size_t r) {
+                        const std::uint8_t *s = policy_type::sigma[r].data();
+
+                        g(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+                        g(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+                        g(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+                        g(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+                        g(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+                        g(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+                        g(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+                        g(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+                    }
+
+                    inline static work_type rounds(const state_type &cv, const block_type &block, std::uint64_t counter,
+                                                   word_type block_len, word_type flags) {
+                        work_type v;
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            v[i] = cv[i];
+                        }
+                        for (std::size_t i = 0; i != 4; ++i) {
+                            v[state_words + i] = policy_type::iv[i];
+                        }
+                        v[12] = static_cast<word_type>(counter);
+                        v[13] = static_cast<word_type>(counter >> policy_type::word_bits);
+                        v[14] = block_len;
+                        v[15] = flags;
+
+                        for (std::size_t r = 0; r != policy_type::rounds; ++r) {
+                            round(v, block, r);
+                        }
+                        return v;
+                    }
+
+                    /*!
+                     * @brief Replaces cv with the chaining value the block compresses to
+                     *
+                     * @param counter Chunk index, or the output block index of the root
+                     * @param block_len Message octets in the block
+                     */
+                    static void compress(state_type &cv, const block_type &block, std::uint64_t counter,
+                                         word_type block_len, word_type flags) {
+                        work_type v = rounds(cv, block, counter, block_len, flags);
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            cv[i] = v[i] ^ v[i + state_words];
+                        }
+                    }
+
+                    /*!
+                     * @brief Full 16-word output of the compression function, as the root emits it
+                     */
+                    static output_type compress_xof(const state_type &cv, const block_type &block,
+                                                    std::uint64_t counter, word_type block_len, word_type flags) {
+                        work_type v = rounds(cv, block, counter, block_len, flags);
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            v[i] ^= v[i + state_words];
+                            v[i + state_words] ^= cv[i];
+                        }
+                        return v;
+                    }
+
+                    static inline block_type load_block(const std::uint8_t *p) {
+                        block_type block;
+                        for (std::size_t i = 0; i != block_words; ++i, p += word_octets) {
+                            word_type w;
+                            std::memcpy(&w, p, word_octets);
+                            block[i] = boost::endian::little_to_native(w);
+                        }
+                        return block;
+                    }
+
+                    static inline void store_state(const state_type &s, std::uint8_t *p) {
+                        for (std::size_t i = 0; i != state_words; ++i, p += word_octets) {
+                            word_type w = boost::endian::native_to_little(s[i]);
+                            std::memcpy(p, &w, word_octets);
+                        }
+                    }
+
+                    /*!
+                     * @brief Hashes count inputs of blocks whole blocks each, all starting from key, and
+                     * writes their chaining values one after another to out. Used for whole chunks and,
+                     * with single blocks, for parent nodes.
+                     *
+                     * @param counter Counter of the first input, the following ones count up from it
+                     * when increment_counter is set
+                     * @param flags_start, flags_end Flags added to the first and to the last block
+                     */
+                    static void hash_many(const std::uint8_t *const *inputs, std::size_t count, std::size_t blocks,
+                                          const state_type &key, std::uint64_t counter, bool increment_counter,
+                                          word_type flags, word_type flags_start, word_type flags_end,
+                                          std::uint8_t *out) {
+                        for (std::size_t i = 0; i != count; ++i, out += state_words * word_octets) {
+                            state_type cv = key;
+                            const std::uint8_t *p = inputs[i];
+                            for (std::size_t b = 0; b != blocks; ++b, p += block_octets) {
+                                word_type f = flags | (b ? 0 : flags_start) | (b + 1 == blocks ? flags_end : 0);
+                                compress(cv, load_block(p), counter, block_octets, f);
+                            }
+                            store_state(cv, out);
+                            if (increment_counter) {
+                                ++counter;
+                            }
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE3_IMPL_HPP
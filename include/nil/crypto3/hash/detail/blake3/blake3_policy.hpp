@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE3_POLICY_HPP
+#define CRYPTO3_BLAKE3_POLICY_HPP
+
+#include <array>
+#include <cstdint>
+
+#include <nil/crypto3/detail/octet.hpp>
+#include <nil/crypto3/detail/static_digest.hpp>
+#include <nil/crypto3/detail/basic_functions.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                template<std::size_t DigestBits>
+                struct blake3_policy : public ::nil::crypto3::detail::basic_functions<32> {
+
+                    // The chaining value of a chunk or a parent node
+                    constexpr static const std::size_t state_bits = 256;
+                    constexpr static const std::size_t state_words = state_bits / word_bits;
+                    typedef std::array<word_type, state_words> state_type;
+
+                    constexpr static const std::size_t block_bits = 512;
+                    constexpr static const std::size_t block_words = block_bits / word_bits;
+                    constexpr static const std::size_t block_octets = block_bits / octet_bits;
+                    typedef std::array<word_type, block_words> block_type;
+
+                    // Full output of the compression function, the extendable output of the root
+                    typedef std::array<word_type, 2 * state_words> output_type;
+
+                    constexpr static const std::size_t chunk_blocks = 16;
+                    constexpr static const std::size_t chunk_octets = chunk_blocks * block_octets;
+
+                    constexpr static const std::size_t length_bits = 2 * word_bits;
+
+                    typedef typename stream_endian::little_octet_big_bit digest_endian;
+
+                    constexpr static const std::size_t digest_bits = DigestBits;
+                    typedef static_digest<digest_bits> digest_type;
+
+                    constexpr static const std::size_t key_octets = state_bits / octet_bits;
+
+                    constexpr static const std::size_t rounds = 7;
+
+                    // Domain separation flags
+                    constexpr static const word_type chunk_start = 1 << 0;
+                    constexpr static const word_type chunk_end = 1 << 1;
+                    constexpr static const word_type parent = 1 << 2;
+                    constexpr static const word_type root = 1 << 3;
+                    constexpr static const word_type keyed_hash = 1 << 4;
+                    constexpr static const word_type derive_key_context = 1 << 5;
+                    constexpr static const word_type derive_key_material = 1 << 6;
+
+                    // Message word schedule, sigma[r] for round r: the message permutation applied r times
+                    typedef std::array<std::array<std::uint8_t, block_words>, rounds> sigma_type;
+                    constexpr static const sigma_type sigma = {{
+                        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                        {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+                        {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+                        {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+                        {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+                        {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+                        {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+                    }};
+
+                    constexpr static const state_type iv = {
+                        {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab,
+                         0x5be0cd19}};
+                };
+
+                template<std::size_t DigestBits>
+                constexpr typename blake3_policy<DigestBits>::state_type const blake3_policy<DigestBits>::iv;
+
+                template<std::size_t DigestBits>
+                constexpr typename blake3_policy<DigestBits>::sigma_type const blake3_policy<DigestBits>::sigma;
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE3_POLICY_HPP
@@ -0,0 +1,263 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_BLAKE3_SIMD_IMPL_HPP
+#define CRYPTO3_BLAKE3_SIMD_IMPL_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <boost/config.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <nil/crypto3/hash/detail/blake3/blake3_impl.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief BLAKE3 chunk hashing over Lanes inputs at once, one input per vector lane.
+                 * Chaining values and message words are lane-interleaved, so each G is a handful of
+                 * vertical operations. Vectors are written with the compiler's generic vector
+                 * extension and everything is force-inlined, so the instruction set is the one of the
+                 * entry point in blake3_simd_impl the kernel ends up in.
+                 *
+                 * @tparam PolicyType blake3_policy
+                 * @tparam Lanes 4, 8 or 16
+                 */
+                template<typename PolicyType, std::size_t Lanes>
+                struct blake3_lanes_impl {
+                    typedef PolicyType policy_type;
+                    typedef blake3_impl<policy_type> scalar_impl_type;
+
+                    constexpr static const std::size_t lanes = Lanes;
+
+                    typedef typename policy_type::word_type word_type;
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+                    typedef word_type vector_type __attribute__((vector_size(lanes * sizeof(word_type))));
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t block_octets = policy_type::block_octets;
+
+                    // Helpers take and hand back vectors by reference, so no vector crosses a call by value
+                    template<int N>
+                    BOOST_FORCEINLINE static void rotr(vector_type &x) {
+                        x = (x >> N) | (x << (word_bits - N));
+                    }
+
+                    BOOST_FORCEINLINE static void g(vector_type *v, std::size_t a, std::size_t b, std::size_t c,
+                                                    std::size_t d, const vector_type &x, const vector_type &y) {
+                        v[a] = v[a] + v[b] + x;
+                        v[d] ^= v[a];
+                        rotr<16>(v[d]);
+                        v[c] = v[c] + v[d];
+                        v[b] ^= v[c];
+                        rotr<12>(v[b]);
+                        v[a] = v[a] + v[b] + y;
+                        v[d] ^= v[a];
+                        rotr<8>(v[d]);
+                        v[c] = v[c] + v[d];
+                        v[b] ^= v[c];
+                        rotr<7>(v[b]);
+                    }
+
+                    // Round R with its message schedule known at compile time, so m stays in registers
+                    template<std::size_t R>
+                    BOOST_FORCEINLINE static void round(vector_type *v, const vector_type *m) {
+                        constexpr const std::array<std::uint8_t, block_words> &s = policy_type::sigma[R];
+
+                        g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+                        g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+                        g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+                        g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+                        g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+                        g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+                        g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+                        g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+                    }
+
+                    template<std::size_t... R>
+                    BOOST_FORCEINLINE static void rounds(vector_type *v, const vector_type *m,
+                                                         std::index_sequence<R...>) {
+                        (round<R>(v, m), ...);
+                    }
+
+                    BOOST_FORCEINLINE static void set1(vector_type &v, word_type x) {
+                        v = vector_type {} + x;
+                    }
+
+                    // Word t of block b of every input, in lane order
+                    BOOST_FORCEINLINE static void load(const std::uint8_t *const *inputs, std::size_t offset,
+                                                       vector_type *m) {
+                        for (std::size_t l = 0; l != lanes; ++l) {
+                            const std::uint8_t *p = inputs[l] + offset;
+                            for (std::size_t t = 0; t != block_words; ++t, p += word_octets) {
+                                word_type w;
+                                std::memcpy(&w, p, word_octets);
+                                m[t][l] = boost::endian::little_to_native(w);
+                            }
+                        }
+                    }
+
+                    /*!
+                     * @brief blake3_impl::hash_many for exactly lanes inputs
+                     */
+                    BOOST_FORCEINLINE static void hash_lanes(const std::uint8_t *const *inputs, std::size_t blocks,
+                                                             const state_type &key, std::uint64_t counter,
+                                                             bool increment_counter, word_type flags,
+                                                             word_type flags_start, word_type flags_end,
+                                                             std::uint8_t *out) {
+                        vector_type counter_low, counter_high;
+                        for (std::size_t l = 0; l != lanes; ++l) {
+                            const std::uint64_t c = counter + (increment_counter ? l : 0);
+                            counter_low[l] = static_cast<word_type>(c);
+                            counter_high[l] = static_cast<word_type>(c >> word_bits);
+                        }
+
+                        vector_type h[state_words];
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            set1(h[i], key[i]);
+                        }
+
+                        for (std::size_t b = 0; b != blocks; ++b) {
+                            vector_type m[block_words];
+                            load(inputs, b * block_octets, m);
+
+                            const word_type f = flags | (b ? 0 : flags_start) | (b + 1 == blocks ? flags_end : 0);
+
+                            vector_type v[2 * state_words];
+                            for (std::size_t i = 0; i != state_words; ++i) {
+                                v[i] = h[i];
+                            }
+                            for (std::size_t i = 0; i != 4; ++i) {
+                                set1(v[state_words + i], policy_type::iv[i]);
+                            }
+                            v[12] = counter_low;
+                            v[13] = counter_high;
+                            set1(v[14], block_octets);
+                            set1(v[15], f);
+
+                            rounds(v, m, std::make_index_sequence<policy_type::rounds>());
+
+                            for (std::size_t i = 0; i != state_words; ++i) {
+                                h[i] = v[i] ^ v[i + state_words];
+                            }
+                        }
+
+                        for (std::size_t l = 0; l != lanes; ++l) {
+                            for (std::size_t i = 0; i != state_words; ++i, out += word_octets) {
+                                word_type w = boost::endian::native_to_little(h[i][l]);
+                                std::memcpy(out, &w, word_octets);
+                            }
+                        }
+                    }
+
+                    /*!
+                     * @brief blake3_impl::hash_many, lanes inputs at a time. The remainder goes to the
+                     * kernel of half as many lanes, down to the portable one.
+                     */
+                    BOOST_FORCEINLINE static void hash_many(const std::uint8_t *const *inputs, std::size_t count,
+                                                            std::size_t blocks, const state_type &key,
+                                                            std::uint64_t counter, bool increment_counter,
+                                                            word_type flags, word_type flags_start,
+                                                            word_type flags_end, std::uint8_t *out) {
+                        constexpr std::size_t out_octets = lanes * state_words * word_octets;
+                        for (; count >= lanes; count -= lanes, inputs += lanes, out += out_octets) {
+                            hash_lanes(inputs, blocks, key, counter, increment_counter, flags, flags_start, flags_end,
+                                       out);
+                            if (increment_counter) {
+                                counter += lanes;
+                            }
+                        }
+
+                        if (!count) {
+                            return;
+                        }
+                        if constexpr (lanes > 4) {
+                            blake3_lanes_impl<policy_type, lanes / 2>::hash_many(inputs, count, blocks, key, counter,
+                                                                                  increment_counter, flags,
+                                                                                  flags_start, flags_end, out);
+                        } else {
+                            scalar_impl_type::hash_many(inputs, count, blocks, key, counter, increment_counter, flags,
+                                                        flags_start, flags_end, out);
+                        }
+                    }
+                };
+
+                /*!
+                 * @brief Entry points compiling blake3_lanes_impl for the instruction sets cpu_features
+                 * reports. Only reachable through blake3_dispatch_impl.
+                 */
+                template<typename PolicyType>
+                struct blake3_simd_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+                    typedef typename policy_type::state_type state_type;
+
+                    CRYPTO3_HASH_TARGET("sse4.1")
+                    static void hash_many_sse41(const std::uint8_t *const *inputs, std::size_t count,
+                                                std::size_t blocks, const state_type &key, std::uint64_t counter,
+                                                bool increment_counter, word_type flags, word_type flags_start,
+                                                word_type flags_end, std::uint8_t *out) {
+                        blake3_lanes_impl<policy_type, 4>::hash_many(inputs, count, blocks, key, counter,
+                                                                     increment_counter, flags, flags_start, flags_end,
+                                                                     out);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void hash_many_avx2(const std::uint8_t *const *inputs, std::size_t count, std::size_t blocks,
+                                               const state_type &key, std::uint64_t counter, bool increment_counter,
+                                               word_type flags, word_type flags_start, word_type flags_end,
+                                               std::uint8_t *out) {
+                        blake3_lanes_impl<policy_type, 8>::hash_many(inputs, count, blocks, key, counter,
+                                                                     increment_counter, flags, flags_start, flags_end,
+                                                                     out);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void hash_many_avx512(const std::uint8_t *const *inputs, std::size_t count,
+                                                 std::size_t blocks, const state_type &key, std::uint64_t counter,
+                                                 bool increment_counter, word_type flags, word_type flags_start,
+                                                 word_type flags_end, std::uint8_t *out) {
+                        blake3_lanes_impl<policy_type, 16>::hash_many(inputs, count, blocks, key, counter,
+                                                                      increment_counter, flags, flags_start,
+                                                                      flags_end, out);
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BLAKE3_SIMD_IMPL_HPP
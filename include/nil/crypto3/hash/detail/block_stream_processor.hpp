@@ -26,14 +26,20 @@
 #ifndef CRYPTO3_HASH_BLOCK_STREAM_PROCESSOR_HPP
 #define CRYPTO3_HASH_BLOCK_STREAM_PROCESSOR_HPP
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iterator>
+#include <type_traits>
 
+#include <nil/crypto3/detail/octet.hpp>
 #include <nil/crypto3/detail/pack.hpp>
 
 #include <nil/crypto3/hash/accumulators/bits_count.hpp>
 #include <nil/crypto3/hash/accumulators/parameters/bits.hpp>
 
+#include <nil/crypto3/hash/detail/octet_blocks.hpp>
+
 #include <boost/integer.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/utility/enable_if.hpp>
@@ -72,9 +78,17 @@ namespace nil {
                 constexpr static const std::size_t block_values = block_bits / value_bits;
                 typedef std::array<value_type, block_values> cache_type;
 
+                constexpr static const std::size_t batch_blocks = 8;
+                typedef std::array<block_type, batch_blocks> batch_type;
+
             protected:
                 BOOST_STATIC_ASSERT(block_bits % value_bits == 0);
 
+                // Constructions absorbing in lane order take contiguous octets without packing
+                typedef std::integral_constant<bool, value_bits == octet_bits &&
+                                                         detail::absorbs_octets<construction_type>::value>
+                    octet_absorb_type;
+
                 inline void process_block(std::size_t block_seen = block_bits) {
                     // Convert the input into words
                     block_type block;
@@ -83,6 +97,39 @@ namespace nil {
                     acc(block, ::nil::crypto3::accumulators::bits = block_seen);
                 }
 
+                template<typename InputIterator>
+                inline InputIterator process_blocks(InputIterator p, std::size_t n, std::false_type) {
+                    // Convert full blocks of input values into words without staging them in the cache
+                    batch_type blocks;
+                    while (n) {
+                        std::size_t batch_amount = std::min(n, batch_blocks);
+                        for (std::size_t i = 0; i != batch_amount; ++i) {
+                            InputIterator block_end = p;
+                            std::advance(block_end, block_values);
+                            nil::crypto3::detail::pack_to<endian_type, value_bits, word_bits>(p, block_end,
+                                                                                              blocks[i].begin());
+                            p = block_end;
+                        }
+                        // Process the blocks at once, so the construction keeps its state between them
+                        acc(blocks, ::nil::crypto3::accumulators::bits = batch_amount * block_bits);
+                        n -= batch_amount;
+                    }
+                    return p;
+                }
+
+                template<typename InputIterator>
+                inline InputIterator process_blocks(InputIterator p, std::size_t n, std::true_type) {
+                    return process_blocks(p, n, std::false_type());
+                }
+
+                // Contiguous octets go to the construction in a single run, however long
+                template<typename ValueType>
+                inline ValueType *process_blocks(ValueType *p, std::size_t n, std::true_type) {
+                    acc(detail::octet_blocks {reinterpret_cast<const std::uint8_t *>(p), n},
+                        ::nil::crypto3::accumulators::bits = n * block_bits);
+                    return p + n * block_values;
+                }
+
             public:
                 inline void update_one(value_type value) {
                     cache[cache_seen] = value;
@@ -96,6 +143,19 @@ namespace nil {
 
                 template<typename InputIterator>
                 inline void update_n(InputIterator p, size_t n) {
+                    // Top up the partially filled cache to the block boundary
+                    for (; n && cache_seen; --n) {
+                        update_one(*p++);
+                    }
+
+                    // Pack whole blocks straight from the input, bypassing the cache
+                    if (n >= block_values) {
+                        std::size_t blocks_amount = n / block_values;
+                        p = process_blocks(p, blocks_amount, octet_absorb_type());
+                        n -= blocks_amount * block_values;
+                    }
+
+                    // Keep the tail for the next update or the destructor
                     for (; n; --n) {
                         update_one(*p++);
                     }
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_DETAIL_CONTIGUOUS_RANGE_HPP
+#define CRYPTO3_HASH_DETAIL_CONTIGUOUS_RANGE_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <boost/static_assert.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Tells ranges laid out in one piece of memory, such as arrays, vectors and
+                 * strings, which are then handed over as a pointer and a size
+                 */
+                template<typename Range, typename = void>
+                struct is_contiguous_range : std::false_type { };
+
+                template<typename Range>
+                struct is_contiguous_range<Range,
+                                           typename std::enable_if<std::is_pointer<decltype(std::data(
+                                               std::declval<const Range &>()))>::value>::type> : std::true_type { };
+
+                /*!
+                 * @return the first octet of a contiguous range of one-octet values
+                 */
+                template<typename Range>
+                inline const std::uint8_t *octets(const Range &range) {
+                    BOOST_STATIC_ASSERT(sizeof(*std::data(range)) == 1);
+                    return reinterpret_cast<const std::uint8_t *>(std::data(range));
+                }
+            }    // namespace detail
+        }        // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_CONTIGUOUS_RANGE_HPP
@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_DETAIL_CPU_FEATURES_HPP
+#define CRYPTO3_HASH_DETAIL_CPU_FEATURES_HPP
+
+#include <cstdint>
+
+#include <boost/predef/architecture.h>
+
+#if BOOST_ARCH_X86_64
+#include <cpuid.h>
+
+/*!
+ * @brief Compiles a single function for an instruction set the rest of the translation
+ * unit is not built for. Such a function may only be reached after a cpu_features check.
+ */
+#define CRYPTO3_HASH_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Instruction set extensions of the CPU the process runs on, as reported by
+                 * cpuid. Vector extensions are only reported when the OS also saves their registers.
+                 */
+                struct cpu_features {
+                    bool sse4_1;
+                    bool avx2;
+                    bool avx512f;
+                    bool sha_ni;
+
+                    /*!
+                     * @brief Features of the host, detected once on first use
+                     */
+                    static const cpu_features &host() {
+                        static const cpu_features features = detect();
+                        return features;
+                    }
+
+                    static cpu_features detect() {
+                        cpu_features features = {false, false, false, false};
+#if BOOST_ARCH_X86_64
+                        unsigned int eax, ebx, ecx, edx;
+                        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+                            return features;
+                        }
+                        features.sse4_1 = ecx & bit_SSE4_1;
+
+                        const bool osxsave = ecx & bit_OSXSAVE;
+                        const std::uint64_t xcr0 = osxsave ? xgetbv() : 0;
+                        // XMM and YMM state, then opmask, ZMM0-15 upper halves and ZMM16-31
+                        const bool ymm_enabled = (xcr0 & 0x06) == 0x06;
+                        const bool zmm_enabled = (xcr0 & 0xe6) == 0xe6;
+
+                        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+                            return features;
+                        }
+                        features.avx2 = ymm_enabled && (ebx & bit_AVX2);
+                        features.avx512f = zmm_enabled && (ebx & bit_AVX512F);
+                        features.sha_ni = ebx & bit_SHA;
+#endif
+                        return features;
+                    }
+
+                protected:
+#if BOOST_ARCH_X86_64
+                    static std::uint64_t xgetbv() {
+                        std::uint32_t lo, hi;
+                        __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+                        return (static_cast<std::uint64_t>(hi) << 32) | lo;
+                    }
+#endif
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_CPU_FEATURES_HPP
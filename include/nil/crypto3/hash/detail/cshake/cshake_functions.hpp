@@ -0,0 +1,115 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_CSHAKE_FUNCTIONS_HPP
+#define CRYPTO3_HASH_CSHAKE_FUNCTIONS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief String and integer encodings of NIST SP 800-185, section 2.3
+                 */
+                struct cshake_functions {
+                    struct encoded_integer_type {
+                        std::array<std::uint8_t, 9> octets;
+                        std::size_t size;
+
+                        const std::uint8_t *data() const {
+                            return octets.data();
+                        }
+                    };
+
+                    static inline encoded_integer_type left_encode(std::uint64_t x) {
+                        encoded_integer_type e = right_encode(x);
+                        // Move the length octet from the back to the front
+                        std::uint8_t n = e.octets[e.size - 1];
+                        std::copy_backward(e.octets.begin(), e.octets.begin() + n, e.octets.begin() + n + 1);
+                        e.octets[0] = n;
+                        return e;
+                    }
+
+                    static inline encoded_integer_type right_encode(std::uint64_t x) {
+                        encoded_integer_type e;
+                        std::size_t n = 1;
+                        while (n < 8 && (x >> (n * octet_bits))) {
+                            ++n;
+                        }
+                        for (std::size_t i = 0; i != n; ++i) {
+                            e.octets[i] = static_cast<std::uint8_t>(x >> ((n - 1 - i) * octet_bits));
+                        }
+                        e.octets[n] = static_cast<std::uint8_t>(n);
+                        e.size = n + 1;
+                        return e;
+                    }
+
+                    template<typename Sink>
+                    static inline void encode_string(Sink &sink, const std::uint8_t *data, std::size_t n) {
+                        encoded_integer_type length = left_encode(static_cast<std::uint64_t>(n) * octet_bits);
+                        sink.update(length.data(), length.size);
+                        sink.update(data, n);
+                    }
+
+                    /*!
+                     * @brief bytepad(encode_string(s_1) || ... || encode_string(s_k), w): the prefix
+                     * cSHAKE and KMAC absorb, a whole number of w-octet blocks
+                     */
+                    static inline std::vector<std::uint8_t>
+                        bytepad(std::initializer_list<std::pair<const std::uint8_t *, std::size_t>> strings,
+                                std::size_t w) {
+                        struct sink_type {
+                            void update(const std::uint8_t *data, std::size_t n) {
+                                octets.insert(octets.end(), data, data + n);
+                            }
+
+                            std::vector<std::uint8_t> octets;
+                        } sink;
+
+                        encoded_integer_type rate = left_encode(w);
+                        sink.update(rate.data(), rate.size);
+                        for (const std::pair<const std::uint8_t *, std::size_t> &s : strings) {
+                            encode_string(sink, s.first, s.second);
+                        }
+                        sink.octets.resize((sink.octets.size() + w - 1) / w * w, 0);
+                        return sink.octets;
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_CSHAKE_FUNCTIONS_HPP
@@ -61,6 +61,17 @@ namespace nil {
                     CombineFunction f;
                     f(state, new_state);
                 }
+
+                inline static void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                    state_type s = state;
+                    CombineFunction f;
+                    for (; n; --n, ++blocks) {
+                        block_cipher_type cipher(*blocks);
+                        state_type new_state = cipher.encrypt((const state_type &)s);
+                        f(s, new_state);
+                    }
+                    state = s;
+                }
             };
         }    // namespace hashes
     }        // namespace crypto3
@@ -45,6 +45,10 @@
 #include <nil/crypto3/detail/strxor.hpp>
 
 #include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/hash_state.hpp>
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/prefix_state.hpp>
+#include <nil/crypto3/hash/shake.hpp>
 
 #include <nil/crypto3/hash/detail/h2c/h2c_policy.hpp>
 
@@ -79,8 +83,15 @@ namespace nil {
                     typedef std::array<std::uint8_t, len_in_bytes> result_type;
                     typedef accumulator_set<Hash> internal_accumulator_type;
 
+                    static inline const midstate<Hash> &z_pad_midstate() {
+                        static const midstate<Hash> m = prefix_state<Hash>(Z_pad).export_midstate();
+                        return m;
+                    }
+
                     static inline void init_accumulator(internal_accumulator_type &acc) {
-                        hash<Hash>(Z_pad, acc);
+                        // Z_pad is a whole block, compressed once per process. The snapshot has to be resumed with
+                        // more data, and l_i_b_str always follows the message.
+                        import_midstate(acc, z_pad_midstate());
                     }
 
                     template<typename InputRange>
@@ -114,28 +125,80 @@ namespace nil {
                         typename Hash::digest_type b0 = ::nil::crypto3::accumulators::extract::hash<Hash>(b0_acc);
 
                         result_type uniform_bytes;
-                        internal_accumulator_type bi_acc;
-                        hash<Hash>(b0, bi_acc);
-                        hash<Hash>(std::array<std::uint8_t, 1> {1}, bi_acc);
-                        hash<Hash>(dst, bi_acc);
-                        hash<Hash>(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(dst_size)}, bi_acc);
-                        typename Hash::digest_type bi = ::nil::crypto3::accumulators::extract::hash<Hash>(bi_acc);
+                        hasher<Hash> bi_hasher;
+                        bi_hasher.update(b0);
+                        bi_hasher.update(std::array<std::uint8_t, 1> {1});
+                        bi_hasher.update(dst);
+                        bi_hasher.update(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(dst_size)});
+                        typename Hash::digest_type bi = bi_hasher.finalize();
                         std::copy(bi.begin(), bi.end(), uniform_bytes.begin());
 
                         typename Hash::digest_type xored_b;
                         for (std::size_t i = 2; i <= ell; i++) {
-                            internal_accumulator_type bi_acc;
                             ::nil::crypto3::detail::strxor(b0, bi, xored_b.begin());
-                            hash<Hash>(xored_b, bi_acc);
-                            hash<Hash>(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(i)}, bi_acc);
-                            hash<Hash>(dst, bi_acc);
-                            hash<Hash>(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(dst_size)}, bi_acc);
-                            bi = ::nil::crypto3::accumulators::extract::hash<Hash>(bi_acc);
+                            bi_hasher.update(xored_b);
+                            bi_hasher.update(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(i)});
+                            bi_hasher.update(dst);
+                            bi_hasher.update(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(dst_size)});
+                            bi = bi_hasher.finalize();
                             std::copy(bi.begin(), bi.end(), uniform_bytes.begin() + (i - 1) * b_in_bytes);
                         }
                         return uniform_bytes;
                     }
                 };
+
+                template<std::size_t k, std::size_t len_in_bytes, typename Xof>
+                class expand_message_xof {
+                    // https://www.rfc-editor.org/rfc/rfc9380#section-5.3.2
+                    static_assert(Xof::security_bits >= k, "k-bit collision resistance is not fulfilled");
+                    static_assert(len_in_bytes < 0x10000, "len_in_bytes should be less than 0x10000");
+
+                    constexpr static std::array<std::uint8_t, 2> l_i_b_str = {
+                        static_cast<std::uint8_t>(len_in_bytes >> 8u), static_cast<std::uint8_t>(len_in_bytes % 0x100)};
+
+                public:
+                    typedef std::array<std::uint8_t, len_in_bytes> result_type;
+                    typedef Xof internal_accumulator_type;
+
+                    static inline void init_accumulator(internal_accumulator_type &acc) {
+                        acc.reset();
+                    }
+
+                    template<typename InputRange>
+                    static inline void update(internal_accumulator_type &acc, const InputRange &range) {
+                        BOOST_CONCEPT_ASSERT((boost::SinglePassRangeConcept<InputRange>));
+
+                        acc.update(range);
+                    }
+
+                    template<typename InputIterator>
+                    static inline void update(internal_accumulator_type &acc, InputIterator first, InputIterator last) {
+                        BOOST_CONCEPT_ASSERT((boost::InputIteratorConcept<InputIterator>));
+
+                        acc.update(first, last);
+                    }
+
+                    template<typename DstRange>
+                    static inline typename std::enable_if<
+                        std::is_same<std::uint8_t,
+                                     typename std::iterator_traits<typename DstRange::iterator>::value_type>::value,
+                        result_type>::type
+                        process(internal_accumulator_type &acc, const DstRange &dst) {
+
+                        auto dst_size = std::distance(std::cbegin(dst), std::cend(dst));
+                        assert(dst_size >= 16 && dst_size <= 255);
+
+                        // A single sponge squeezed for len_in_bytes, where expand_message_xmd chains
+                        // ell fixed-size digests
+                        acc.update(l_i_b_str);
+                        acc.update(dst);
+                        acc.update(std::array<std::uint8_t, 1> {static_cast<std::uint8_t>(dst_size)});
+
+                        result_type uniform_bytes;
+                        acc.squeeze(uniform_bytes.data(), len_in_bytes);
+                        return uniform_bytes;
+                    }
+                };
             }    // namespace detail
         }        // namespace hashes
     }            // namespace crypto3
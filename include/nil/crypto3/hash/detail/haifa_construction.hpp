@@ -65,6 +65,7 @@ namespace nil {
                 constexpr static const salt_type salt_value = compressor_functor::salt_value;
 
                 typedef typename compressor_functor::iv_generator iv_generator;
+                typedef typename compressor_functor::parameter_block_type parameter_block_type;
 
                 constexpr static const std::size_t word_bits = compressor_functor::word_bits;
                 typedef typename compressor_functor::word_type word_type;
@@ -101,21 +102,28 @@ namespace nil {
                     return *this;
                 }
 
+                /*!
+                 * @param seen Message bits counted up to and including the first block
+                 */
+                template<typename Integer = std::size_t>
+                inline haifa_construction &process_blocks(const block_type *blocks, std::size_t n, Integer seen) {
+                    compressor_functor::process_blocks(state_, blocks, n, seen);
+                    return *this;
+                }
+
                 inline digest_type digest(const block_type &block = block_type(),
                                           std::size_t total_seen = length_type()) {
                     using namespace nil::crypto3::detail;
 
                     block_type b = block;
-                    // Process block if it is full
-                    if (total_seen && !(total_seen % block_bits))
-                        process_block(b, total_seen);
 
-                    // Pad last message block
+                    // Pad last message block. A full last block is left as it is and compressed
+                    // only once, as the final one
                     padding_functor padding;
                     padding(b, total_seen);
 
-                    // Process last block
-                    process_block(b, total_seen, salt_value);
+                    // Process last block. The flag may be narrower than the length, as in BLAKE2s
+                    process_block<std::size_t>(b, total_seen, salt_value);
 
                     // Apply finalizer
                     finalizer_functor()(state_);
@@ -143,10 +151,27 @@ namespace nil {
                     reset(iv());
                 }
 
+                /*!
+                 * @brief Starts from the IV combined with a full parameter block, for keyed, salted,
+                 * personalized or tree hashing. The digest length in it is the caller's to set.
+                 */
+                void reset(const parameter_block_type &params) {
+                    iv_generator iv;
+                    state_ = params.apply(iv());
+                }
+
                 state_type const &state() const {
                     return state_;
                 }
 
+                /*!
+                 * @brief Loads a chaining state previously obtained with state(). Unlike reset(s),
+                 * the parameter block is not applied again.
+                 */
+                void restore(state_type const &s) {
+                    state_ = s;
+                }
+
             private:
                 state_type state_;
             };
@@ -0,0 +1,430 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER_HPP
+#define CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/config.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+#include <nil/crypto3/hash/detail/keccak/keccak_impl.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Multi-buffer Keccak-f[1600]: hashes independent messages at once, one
+                 * message per vector lane. The states are kept lane-interleaved, vector i holding
+                 * lane i of every state, so each permutation step is a handful of vertical operations
+                 * on 25 registers with no shuffles. Short messages, which need a single permutation
+                 * each, gain the most.
+                 *
+                 * Vectors are written with the compiler's generic vector extension and everything is
+                 * force-inlined, so the instruction set is the one of the entry point in
+                 * keccak_1600_multi_buffer_simd the kernel ends up in.
+                 *
+                 * @tparam Lanes 2, 4 or 8
+                 * @tparam Policy keccak_1600_policy or sha3_policy, giving the rate, digest size and rounds
+                 * @tparam DomainSeparator First padding octet: 0x01 for Keccak, 0x06 for SHA-3
+                 */
+                template<std::size_t Lanes, typename Policy, std::uint8_t DomainSeparator>
+                struct keccak_1600_multi_buffer {
+                    constexpr static const std::size_t lanes = Lanes;
+
+                    typedef Policy policy_type;
+                    typedef keccak_1600_impl<policy_type> constants_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+                    typedef word_type vector_type __attribute__((vector_size(lanes * sizeof(word_type))));
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t block_octets = policy_type::block_bits / octet_bits;
+
+                    constexpr static const std::size_t digest_octets = policy_type::digest_bits / octet_bits;
+                    typedef typename policy_type::digest_type digest_type;
+
+                    typedef std::array<word_type, lanes> lane_words_type;
+
+                    BOOST_FORCEINLINE static void process(const std::uint8_t *const *data, const std::size_t *sizes,
+                                                          std::size_t n, digest_type *digests) {
+                        for (std::size_t i = 0; i < n; i += lanes) {
+                            std::array<state_type, lanes> states;
+                            std::size_t count = std::min(lanes, n - i);
+                            absorb_group(data + i, sizes + i, count, states.data());
+
+                            for (std::size_t l = 0; l != count; ++l) {
+                                for (std::size_t j = 0; j != digest_octets; ++j) {
+                                    digests[i + l][j] = static_cast<std::uint8_t>(states[l][j / word_octets] >>
+                                                                                  ((j % word_octets) * octet_bits));
+                                }
+                            }
+                        }
+                    }
+
+                    /*!
+                     * @brief Absorbs n messages, leaving in states the state of each one right after
+                     * its final permutation. Extendable-output functions squeeze on from there.
+                     */
+                    BOOST_FORCEINLINE static void absorb(const std::uint8_t *const *data, const std::size_t *sizes,
+                                                         std::size_t n, state_type *states) {
+                        for (std::size_t i = 0; i < n; i += lanes) {
+                            absorb_group(data + i, sizes + i, std::min(lanes, n - i), states + i);
+                        }
+                    }
+
+                    /*!
+                     * @brief Applies Keccak-p[1600, policy_type::rounds] to each of the n states
+                     */
+                    BOOST_FORCEINLINE static void permute(state_type *states, std::size_t n) {
+                        for (std::size_t i = 0; i < n; i += lanes) {
+                            std::size_t count = std::min(lanes, n - i);
+
+                            vector_type A[state_words];
+                            for (std::size_t t = 0; t != state_words; ++t) {
+                                for (std::size_t l = 0; l != lanes; ++l) {
+                                    A[t][l] = l < count ? states[i + l][t] : word_type();
+                                }
+                            }
+                            permute(A);
+                            for (std::size_t t = 0; t != state_words; ++t) {
+                                for (std::size_t l = 0; l != count; ++l) {
+                                    states[i + l][t] = A[t][l];
+                                }
+                            }
+                        }
+                    }
+
+                protected:
+                    BOOST_FORCEINLINE static void absorb_group(const std::uint8_t *const *data,
+                                                               const std::size_t *sizes, std::size_t count,
+                                                               state_type *states) {
+                        // The last block of every message with the padding applied. It always fits:
+                        // the domain separator and the final bit share an octet when only one is left
+                        std::array<std::array<std::uint8_t, block_octets>, lanes> tails;
+                        std::array<std::size_t, lanes> full_blocks;
+                        std::size_t max_blocks = 0;
+
+                        for (std::size_t l = 0; l != lanes; ++l) {
+                            std::fill(tails[l].begin(), tails[l].end(), 0);
+                            if (l >= count) {
+                                full_blocks[l] = 0;
+                                continue;
+                            }
+
+                            std::size_t rem = sizes[l] % block_octets;
+                            full_blocks[l] = sizes[l] / block_octets;
+                            max_blocks = std::max(max_blocks, full_blocks[l] + 1);
+
+                            if (rem) {
+                                std::memcpy(tails[l].data(), data[l] + full_blocks[l] * block_octets, rem);
+                            }
+                            tails[l][rem] ^= DomainSeparator;
+                            tails[l][block_octets - 1] ^= 0x80;
+                        }
+
+                        // Vector registers are kept in plain arrays, std::array would drop their alignment attributes
+                        vector_type A[state_words];
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            A[i] = vector_type {};
+                        }
+
+                        std::array<lane_words_type, block_words> words;
+
+                        for (std::size_t b = 0; b != max_blocks; ++b) {
+                            for (std::size_t l = 0; l != lanes; ++l) {
+                                // Lanes past their last block absorb their padded tail again; their
+                                // states have already been taken
+                                const std::uint8_t *p =
+                                    b < full_blocks[l] ? data[l] + b * block_octets : tails[l].data();
+
+                                for (std::size_t t = 0; t != block_words; ++t, p += word_octets) {
+                                    word_type w;
+                                    std::memcpy(&w, p, word_octets);
+                                    words[t][l] = boost::endian::little_to_native(w);
+                                }
+                            }
+
+                            for (std::size_t t = 0; t != block_words; ++t) {
+                                vector_type w;
+                                std::memcpy(&w, words[t].data(), sizeof(w));
+                                A[t] ^= w;
+                            }
+                            permute(A);
+
+                            for (std::size_t l = 0; l != count; ++l) {
+                                if (full_blocks[l] != b) {
+                                    continue;
+                                }
+                                for (std::size_t i = 0; i != state_words; ++i) {
+                                    states[l][i] = A[i][l];
+                                }
+                            }
+                        }
+                    }
+
+                    // Helpers take and hand back vectors by reference, so no vector crosses a call by value
+                    template<int N>
+                    BOOST_FORCEINLINE static void rotl(vector_type &r, const vector_type &x) {
+                        r = (x << N) | (x >> (word_bits - N));
+                    }
+
+                    // Theta applied to one lane, then its rho rotation
+                    template<int N>
+                    BOOST_FORCEINLINE static void theta_rho(vector_type &r, const vector_type &a,
+                                                            const vector_type &d) {
+                        rotl<N>(r, a ^ d);
+                    }
+
+                    /*!
+                     * @brief Applies Keccak-p[1600, policy_type::rounds] to every lane of the lane-interleaved
+                     * states in A
+                     */
+                    BOOST_FORCEINLINE static void permute(vector_type *A) {
+                        for (std::size_t r = constants_type::first_round; r != constants_type::round_constants_size;
+                             ++r) {
+                            const vector_type C0 = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+                            const vector_type C1 = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+                            const vector_type C2 = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+                            const vector_type C3 = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+                            const vector_type C4 = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+
+                            vector_type D0, D1, D2, D3, D4;
+                            rotl<1>(D0, C1);
+                            rotl<1>(D1, C2);
+                            rotl<1>(D2, C3);
+                            rotl<1>(D3, C4);
+                            rotl<1>(D4, C0);
+                            D0 ^= C4;
+                            D1 ^= C0;
+                            D2 ^= C1;
+                            D3 ^= C2;
+                            D4 ^= C3;
+
+                            // Bij receives the lane pi moves to position ij
+                            const vector_type B00 = A[0] ^ D0;
+                            vector_type B10, B20, B05, B15, B16, B01, B11, B21, B06, B07, B17, B02;
+                            vector_type B12, B22, B23, B08, B18, B03, B13, B14, B24, B09, B19, B04;
+                            theta_rho<1>(B10, A[1], D1);
+                            theta_rho<62>(B20, A[2], D2);
+                            theta_rho<28>(B05, A[3], D3);
+                            theta_rho<27>(B15, A[4], D4);
+                            theta_rho<36>(B16, A[5], D0);
+                            theta_rho<44>(B01, A[6], D1);
+                            theta_rho<6>(B11, A[7], D2);
+                            theta_rho<55>(B21, A[8], D3);
+                            theta_rho<20>(B06, A[9], D4);
+                            theta_rho<3>(B07, A[10], D0);
+                            theta_rho<10>(B17, A[11], D1);
+                            theta_rho<43>(B02, A[12], D2);
+                            theta_rho<25>(B12, A[13], D3);
+                            theta_rho<39>(B22, A[14], D4);
+                            theta_rho<41>(B23, A[15], D0);
+                            theta_rho<45>(B08, A[16], D1);
+                            theta_rho<15>(B18, A[17], D2);
+                            theta_rho<21>(B03, A[18], D3);
+                            theta_rho<8>(B13, A[19], D4);
+                            theta_rho<18>(B14, A[20], D0);
+                            theta_rho<2>(B24, A[21], D1);
+                            theta_rho<61>(B09, A[22], D2);
+                            theta_rho<56>(B19, A[23], D3);
+                            theta_rho<14>(B04, A[24], D4);
+
+                            A[0] = B00 ^ (~B01 & B02);
+                            A[1] = B01 ^ (~B02 & B03);
+                            A[2] = B02 ^ (~B03 & B04);
+                            A[3] = B03 ^ (~B04 & B00);
+                            A[4] = B04 ^ (~B00 & B01);
+                            A[5] = B05 ^ (~B06 & B07);
+                            A[6] = B06 ^ (~B07 & B08);
+                            A[7] = B07 ^ (~B08 & B09);
+                            A[8] = B08 ^ (~B09 & B05);
+                            A[9] = B09 ^ (~B05 & B06);
+                            A[10] = B10 ^ (~B11 & B12);
+                            A[11] = B11 ^ (~B12 & B13);
+                            A[12] = B12 ^ (~B13 & B14);
+                            A[13] = B13 ^ (~B14 & B10);
+                            A[14] = B14 ^ (~B10 & B11);
+                            A[15] = B15 ^ (~B16 & B17);
+                            A[16] = B16 ^ (~B17 & B18);
+                            A[17] = B17 ^ (~B18 & B19);
+                            A[18] = B18 ^ (~B19 & B15);
+                            A[19] = B19 ^ (~B15 & B16);
+                            A[20] = B20 ^ (~B21 & B22);
+                            A[21] = B21 ^ (~B22 & B23);
+                            A[22] = B22 ^ (~B23 & B24);
+                            A[23] = B23 ^ (~B24 & B20);
+                            A[24] = B24 ^ (~B20 & B21);
+                            A[0] ^= constants_type::round_constants[r];
+                        }
+                    }
+                };
+
+#if BOOST_ARCH_X86_64
+                /*!
+                 * @brief Entry points compiling keccak_1600_multi_buffer for the instruction sets
+                 * cpu_features reports. Only reachable through keccak_1600_multi_buffer_dispatch.
+                 */
+                template<typename Policy, std::uint8_t DomainSeparator>
+                struct keccak_1600_multi_buffer_simd {
+                    typedef typename Policy::digest_type digest_type;
+                    typedef typename Policy::state_type state_type;
+
+                    template<std::size_t Lanes>
+                    using kernel_type = keccak_1600_multi_buffer<Lanes, Policy, DomainSeparator>;
+
+                    static void process_sse2(const std::uint8_t *const *data, const std::size_t *sizes,
+                                             std::size_t n, digest_type *digests) {
+                        kernel_type<2>::process(data, sizes, n, digests);
+                    }
+
+                    static void absorb_sse2(const std::uint8_t *const *data, const std::size_t *sizes, std::size_t n,
+                                            state_type *states) {
+                        kernel_type<2>::absorb(data, sizes, n, states);
+                    }
+
+                    static void permute_sse2(state_type *states, std::size_t n) {
+                        kernel_type<2>::permute(states, n);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void process_avx2(const std::uint8_t *const *data, const std::size_t *sizes,
+                                             std::size_t n, digest_type *digests) {
+                        kernel_type<4>::process(data, sizes, n, digests);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void absorb_avx2(const std::uint8_t *const *data, const std::size_t *sizes, std::size_t n,
+                                            state_type *states) {
+                        kernel_type<4>::absorb(data, sizes, n, states);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void permute_avx2(state_type *states, std::size_t n) {
+                        kernel_type<4>::permute(states, n);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void process_avx512(const std::uint8_t *const *data, const std::size_t *sizes,
+                                               std::size_t n, digest_type *digests) {
+                        kernel_type<8>::process(data, sizes, n, digests);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void absorb_avx512(const std::uint8_t *const *data, const std::size_t *sizes,
+                                              std::size_t n, state_type *states) {
+                        kernel_type<8>::absorb(data, sizes, n, states);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void permute_avx512(state_type *states, std::size_t n) {
+                        kernel_type<8>::permute(states, n);
+                    }
+                };
+
+                /*!
+                 * @brief Multi-buffer Keccak-f[1600] choosing between 8, 4 and 2 lanes from the
+                 * features of the CPU it runs on. The choice is made once, on first use.
+                 *
+                 * @tparam Policy keccak_1600_policy or sha3_policy, giving the rate, digest size and rounds
+                 * @tparam DomainSeparator First padding octet: 0x01 for Keccak, 0x06 for SHA-3
+                 */
+                template<typename Policy, std::uint8_t DomainSeparator>
+                struct keccak_1600_multi_buffer_dispatch {
+                    typedef typename Policy::digest_type digest_type;
+                    typedef typename Policy::state_type state_type;
+
+                    struct backend_type {
+                        const char *name;
+                        // Messages hashed at once
+                        std::size_t lanes;
+                        void (*process)(const std::uint8_t *const *, const std::size_t *, std::size_t,
+                                        digest_type *);
+                        void (*absorb)(const std::uint8_t *const *, const std::size_t *, std::size_t, state_type *);
+                        void (*permute)(state_type *, std::size_t);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        typedef keccak_1600_multi_buffer_simd<Policy, DomainSeparator> simd_type;
+
+                        if (features.avx512f) {
+                            return {"avx512", 8, &simd_type::process_avx512, &simd_type::absorb_avx512,
+                                    &simd_type::permute_avx512};
+                        }
+                        if (features.avx2) {
+                            return {"avx2", 4, &simd_type::process_avx2, &simd_type::absorb_avx2,
+                                    &simd_type::permute_avx2};
+                        }
+                        return {"sse2", 2, &simd_type::process_sse2, &simd_type::absorb_sse2,
+                                &simd_type::permute_sse2};
+                    }
+
+                    static inline void process(const std::uint8_t *const *data, const std::size_t *sizes,
+                                               std::size_t n, digest_type *digests) {
+                        backend().process(data, sizes, n, digests);
+                    }
+
+                    /*!
+                     * @brief Absorbs n messages, leaving in states the state of each one right after
+                     * its final permutation
+                     */
+                    static inline void absorb(const std::uint8_t *const *data, const std::size_t *sizes,
+                                              std::size_t n, state_type *states) {
+                        backend().absorb(data, sizes, n, states);
+                    }
+
+                    /*!
+                     * @brief Applies Keccak-p[1600, Policy::rounds] to each of the n states
+                     */
+                    static inline void permute(state_type *states, std::size_t n) {
+                        backend().permute(states, n);
+                    }
+                };
+
+#define CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER
+#endif
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER_HPP
@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_KECCAK_DISPATCH_IMPL_HPP
+#define CRYPTO3_KECCAK_DISPATCH_IMPL_HPP
+
+#include <nil/crypto3/hash/detail/keccak/keccak_policy.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_impl.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_avx2_impl.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_x86_64_impl.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Keccak-f[1600] permutation choosing between the AVX2 and the scalar x86_64
+                 * kernels from the features of the CPU it runs on. The choice is made once, on first
+                 * use, so one binary runs on every x86_64 host and uses the widest kernel each of
+                 * them supports.
+                 *
+                 * AVX-512 hosts are served by the AVX2 kernel: keccak_1600_avx512_impl is not
+                 * complete yet and is not selected.
+                 */
+                template<typename PolicyType>
+                struct keccak_1600_dispatch_impl {
+                    typedef PolicyType policy_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+
+                    typedef typename policy_type::state_type state_type;
+
+                    typedef typename keccak_1600_impl<policy_type>::round_constants_type round_constants_type;
+                    constexpr static const round_constants_type round_constants =
+                        keccak_1600_impl<policy_type>::round_constants;
+
+                    struct backend_type {
+                        const char *name;
+                        void (*permute)(state_type &);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        if (features.avx2) {
+                            return {"avx2", &keccak_1600_avx2_impl<policy_type>::permute};
+                        }
+                        return {"x86_64", &keccak_1600_x86_64_impl<policy_type>::permute};
+                    }
+
+                    static inline void permute(state_type &A) {
+                        backend().permute(A);
+                    }
+                };
+
+                template<typename PolicyType>
+                constexpr typename keccak_1600_dispatch_impl<PolicyType>::round_constants_type const
+                    keccak_1600_dispatch_impl<PolicyType>::round_constants;
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_KECCAK_DISPATCH_IMPL_HPP
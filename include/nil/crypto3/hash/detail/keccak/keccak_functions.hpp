@@ -27,19 +27,14 @@
 #ifndef CRYPTO3_KECCAK_FUNCTIONS_AVX2_IMPL_HPP
 #define CRYPTO3_KECCAK_FUNCTIONS_AVX2_IMPL_HPP
 
+#include <boost/predef/architecture.h>
+#include <boost/predef/version_number.h>
+
 #include <nil/crypto3/hash/detail/keccak/keccak_policy.hpp>
 #include <nil/crypto3/hash/detail/keccak/keccak_impl.hpp>
 
 #if BOOST_ARCH_X86_64
-#if defined(CRYPTO3_HAS_AVX512)
-#include <nil/crypto3/hash/detail/keccak/keccak_avx512_impl.hpp>
-#else
-#if defined(CRYPTO3_HAS_AVX2)
-#include <nil/crypto3/hash/detail/keccak/keccak_avx2_impl.hpp>
-#else
-#include <nil/crypto3/hash/detail/keccak/keccak_x86_64_impl.hpp>
-#endif
-#endif
+#include <nil/crypto3/hash/detail/keccak/keccak_dispatch_impl.hpp>
 #elif BOOST_ARCH_ARM
 #include <nil/crypto3/hash/detail/keccak/keccak_armv8_impl.hpp>
 #endif
@@ -48,9 +43,9 @@ namespace nil {
     namespace crypto3 {
         namespace hashes {
             namespace detail {
-                template<std::size_t DigestBits>
-                struct keccak_1600_functions : public keccak_1600_policy<DigestBits> {
-                    typedef keccak_1600_policy<DigestBits> policy_type;
+                template<std::size_t DigestBits, std::size_t Rounds = 24>
+                struct keccak_1600_functions : public keccak_1600_policy<DigestBits, Rounds> {
+                    typedef keccak_1600_policy<DigestBits, Rounds> policy_type;
 
                     constexpr static const std::size_t word_bits = policy_type::word_bits;
                     typedef typename policy_type::word_type word_type;
@@ -59,17 +54,12 @@ namespace nil {
 
                     typedef typename std::conditional<word_bits == 64,
 #if BOOST_ARCH_X86_64
-#if defined(CRYPTO3_HAS_AVX512)
-                                                      keccak_1600_avx512_impl<policy_type>,
-#else
-#if defined(CRYPTO3_HAS_AVX2)
-                                                      keccak_1600_avx2_impl<policy_type>,
-#else
-                                                      keccak_1600_x86_64_impl<policy_type>,
-#endif
-#endif
+                                                      keccak_1600_dispatch_impl<policy_type>,
 #elif BOOST_ARCH_ARM && BOOST_ARCH_ARM >= BOOST_VERSION_NUMBER(8, 0, 0)
-                                                      keccak_1600_armv8_impl<policy_type>,
+                                                      // The armv8 kernel is unrolled for the full 24 rounds
+                                                      typename std::conditional<Rounds == 24,
+                                                                                keccak_1600_armv8_impl<policy_type>,
+                                                                                keccak_1600_impl<policy_type>>::type,
 #else
                                                       keccak_1600_impl<policy_type>,
 #endif
@@ -79,11 +69,24 @@ namespace nil {
 
                     typedef typename impl_type::round_constants_type round_constants_type;
                     constexpr static const round_constants_type round_constants = impl_type::round_constants;
+
+                    /*!
+                     * @brief Name of the permutation kernel impl_type runs on this host
+                     */
+                    static const char *backend() {
+#if BOOST_ARCH_X86_64
+                        return impl_type::backend().name;
+#elif BOOST_ARCH_ARM && BOOST_ARCH_ARM >= BOOST_VERSION_NUMBER(8, 0, 0)
+                        return Rounds == 24 ? "armv8" : "generic";
+#else
+                        return "generic";
+#endif
+                    }
                 };
 
-                template<std::size_t DigestBits>
-                constexpr typename keccak_1600_functions<DigestBits>::round_constants_type const
-                    keccak_1600_functions<DigestBits>::round_constants;
+                template<std::size_t DigestBits, std::size_t Rounds>
+                constexpr typename keccak_1600_functions<DigestBits, Rounds>::round_constants_type const
+                    keccak_1600_functions<DigestBits, Rounds>::round_constants;
             }    // namespace detail
         }        // namespace hashes
     }            // namespace crypto3
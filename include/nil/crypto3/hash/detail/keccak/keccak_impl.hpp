@@ -42,8 +42,10 @@ namespace nil {
 
                     typedef typename policy_type::state_type state_type;
 
-                    constexpr static const std::size_t round_constants_size = policy_type::rounds;
+                    constexpr static const std::size_t round_constants_size = 24;
                     typedef typename std::array<word_type, round_constants_size> round_constants_type;
+                    // Keccak-p[1600, n_r] runs the last n_r rounds of Keccak-f[1600]
+                    constexpr static const std::size_t first_round = round_constants_size - policy_type::rounds;
 
                     constexpr static const round_constants_type round_constants = {
                         UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082), UINT64_C(0x800000000000808a),
@@ -56,7 +58,7 @@ namespace nil {
                         UINT64_C(0x8000000000008080), UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008008)};
 
                     static inline void permute(state_type &A) {
-                        for (typename round_constants_type::value_type c : round_constants) {
+                        for (std::size_t r = first_round; r != round_constants_size; ++r) {
                             const word_type C0 = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
                             const word_type C1 = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
                             const word_type C2 = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
@@ -121,7 +123,7 @@ namespace nil {
                             A[23] = B23 ^ (~B24 & B20);
                             A[24] = B24 ^ (~B20 & B21);
 
-                            A[0] ^= c;
+                            A[0] ^= round_constants[r];
                         }
                     }
                 };
@@ -29,6 +29,8 @@
 #include <nil/crypto3/detail/inject.hpp>
 #include <nil/crypto3/detail/unbounded_shift.hpp>
 
+#include <nil/crypto3/hash/detail/octet_injector.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace hashes {
@@ -54,6 +56,7 @@ namespace nil {
                     typedef ::nil::crypto3::detail::injector<stream_endian::big_octet_little_bit, word_bits,
                                                              block_words, block_bits>
                         injector_type;
+                    typedef octet_injector<stream_endian::big_octet_little_bit, block_type> octet_injector_type;
 
                     bool is_last;
 
@@ -68,7 +71,14 @@ namespace nil {
                     void operator()(block_type &block, std::size_t &block_seen) {
                         using namespace nil::crypto3::detail;
 
-                        if ((block_bits - block_seen) > 1) {
+                        if (!(block_seen % octet_bits)) {
+                            // Octet-aligned message: 1 and the final 1 bit are whole octets, 0x01 ... 0x80
+                            std::size_t seen_octets = block_seen / octet_bits;
+                            octet_injector_type::truncate(block, seen_octets);
+                            octet_injector_type::xor_octet(block, seen_octets, 0x01);
+                            octet_injector_type::xor_octet(block, octet_injector_type::block_octets - 1, 0x80);
+                            block_seen = block_bits;
+                        } else if ((block_bits - block_seen) > 1) {
                             // try to handle bit NIST tests
                             /*if (block_seen % octet_bits) {
                                 pack<stream_endian::big_octet_big_bit, stream_endian::big_octet_little_bit,
@@ -26,14 +26,22 @@
 #ifndef CRYPTO3_KECCAK_POLICY_HPP
 #define CRYPTO3_KECCAK_POLICY_HPP
 
+#include <boost/static_assert.hpp>
+
 #include <nil/crypto3/detail/basic_functions.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace hashes {
             namespace detail {
-                template<std::size_t DigestBits>
+                /*!
+                 * @tparam DigestBits Digest size, the capacity being twice as large
+                 * @tparam Rounds Rounds of the permutation: Keccak-p[1600, Rounds] runs the last Rounds
+                 * of the 24 rounds of Keccak-f[1600]
+                 */
+                template<std::size_t DigestBits, std::size_t Rounds = 24>
                 struct keccak_1600_policy : public ::nil::crypto3::detail::basic_functions<64> {
+                    BOOST_STATIC_ASSERT(Rounds >= 1 && Rounds <= 24);
 
                     constexpr static const std::size_t digest_bits = DigestBits;
                     typedef static_digest<digest_bits> digest_type;
@@ -50,7 +58,7 @@ namespace nil {
 
                     typedef typename stream_endian::big_octet_big_bit digest_endian;
 
-                    constexpr static const std::size_t rounds = 24;
+                    constexpr static const std::size_t rounds = Rounds;
 
                     struct iv_generator {
                         state_type const &operator()() const {
@@ -41,8 +41,10 @@ namespace nil {
 
                     typedef typename policy_type::state_type state_type;
 
-                    constexpr static const std::size_t round_constants_size = policy_type::rounds;
+                    constexpr static const std::size_t round_constants_size = 24;
                     typedef typename std::array<word_type, round_constants_size> round_constants_type;
+                    // Keccak-p[1600, n_r] runs the last n_r rounds of Keccak-f[1600]
+                    constexpr static const std::size_t first_round = round_constants_size - policy_type::rounds;
 
                     constexpr static const round_constants_type round_constants = {
                         UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082), UINT64_C(0x800000000000808a),
@@ -58,7 +60,7 @@ namespace nil {
                         std::array<word_type, 10> C;
                         std::array<word_type, 25> B;
                         __asm__(
-                            "mov $24, %%r13 \n\t"
+                            "mov %[rounds], %%r13 \n\t"
                             "1:\n\t"
 
                             "mov (%[A]), %%r15\n\t"
@@ -399,7 +401,8 @@ namespace nil {
                             "jnz 1b \n\t"
                             :
                             :
-                            [A] "r"(A.begin()), [C] "r"(C.begin()), [B] "r"(B.begin()), [c] "r"(round_constants.begin())
+                            [A] "r"(A.begin()), [C] "r"(C.begin()), [B] "r"(B.begin()),
+                            [c] "r"(round_constants.begin() + first_round), [rounds] "i"(policy_type::rounds)
                             : "cc", "memory", "%r8", "%r9", "%r10", "%r11", "%r12",    // D0, D1, D2, D3, D4
                               "%r13",                                                  // Circle
                               "%r15"                                                   // tmp
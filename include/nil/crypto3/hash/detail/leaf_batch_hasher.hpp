@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_DETAIL_LEAF_BATCH_HASHER_HPP
+#define CRYPTO3_HASH_DETAIL_LEAF_BATCH_HASHER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <nil/crypto3/hash/detail/parallel_for.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Leaf layer of the SHAKE tree hashes, KangarooTwelve and ParallelHash: runs of
+                 * equally sized leaves are absorbed several at a time by LeafBatch, one per vector
+                 * lane, and spread over threads.
+                 *
+                 * @tparam LeafBatch shake_xof_batch hashing the leaves
+                 * @tparam DigestOctets digest written for each leaf
+                 */
+                template<typename LeafBatch, std::size_t DigestOctets>
+                struct leaf_batch_hasher {
+                    typedef LeafBatch leaf_batch_type;
+
+                    constexpr static const std::size_t digest_octets = DigestOctets;
+
+                    // Leaves handed over to each thread at once
+                    constexpr static const std::size_t batch_leaves = 64;
+
+                    /*!
+                     * @brief Hashes count leaves of leaf_octets octets each, starting at data, and hands
+                     * their digests over in order to absorb(digests, amount), a run of leaves at a time
+                     */
+                    template<typename Absorb>
+                    static inline void process(const std::uint8_t *data, std::size_t count, std::size_t leaf_octets,
+                                               std::size_t threads, Absorb absorb) {
+                        std::vector<std::uint8_t> digests(std::min(count, batch_leaves * threads) * digest_octets);
+
+                        while (count) {
+                            std::size_t amount = std::min(count, batch_leaves * threads);
+                            parallel_for(amount, threads, [&](std::size_t first, std::size_t last) {
+                                hash(data + first * leaf_octets, last - first, leaf_octets,
+                                     digests.data() + first * digest_octets);
+                            });
+
+                            absorb(digests.data(), amount);
+                            data += amount * leaf_octets;
+                            count -= amount;
+                        }
+                    }
+
+                    static inline void hash(const std::uint8_t *data, std::size_t count, std::size_t leaf_octets,
+                                            std::uint8_t *digests) {
+                        std::vector<const std::uint8_t *> leaves(count);
+                        std::vector<std::size_t> sizes(count, leaf_octets);
+                        std::vector<std::uint8_t *> out(count);
+                        for (std::size_t i = 0; i != count; ++i) {
+                            leaves[i] = data + i * leaf_octets;
+                            out[i] = digests + i * digest_octets;
+                        }
+
+                        leaf_batch_type batch;
+                        batch.absorb(leaves.data(), sizes.data(), count);
+                        batch.squeeze(out.data(), digest_octets);
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_LEAF_BATCH_HASHER_HPP
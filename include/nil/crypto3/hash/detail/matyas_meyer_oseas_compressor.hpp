@@ -68,6 +68,12 @@ namespace nil {
                     f(new_state, block);
                     state = new_state;
                 }
+
+                static inline void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                    for (; n; --n) {
+                        process_block(state, *blocks++);
+                    }
+                }
             };
         }    // namespace hash
     }        // namespace crypto3
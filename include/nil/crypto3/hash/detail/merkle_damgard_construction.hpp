@@ -94,6 +94,13 @@ namespace nil {
                     return *this;
                 }
 
+                template<typename Integer = std::size_t>
+                inline merkle_damgard_construction &process_blocks(const block_type *blocks, std::size_t n,
+                                                                   Integer = Integer()) {
+                    compressor_functor::process_blocks(state_, blocks, n);
+                    return *this;
+                }
+
                 inline digest_type digest(const block_type &block = block_type(),
                                           length_type total_seen = length_type()) {
                     using namespace nil::crypto3::detail;
@@ -147,6 +154,13 @@ namespace nil {
                     return state_;
                 }
 
+                /*!
+                 * @brief Loads a chaining state previously obtained with state()
+                 */
+                inline void restore(const state_type &s) {
+                    state_ = s;
+                }
+
             protected:
                 template<typename Dummy>
                 typename std::enable_if<length_bits && sizeof(Dummy)>::type append_length(block_type &block,
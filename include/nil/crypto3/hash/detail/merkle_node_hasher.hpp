@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_DETAIL_MERKLE_NODE_HASHER_HPP
+#define CRYPTO3_HASH_DETAIL_MERKLE_NODE_HASHER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/type_traits.hpp>
+#include <nil/crypto3/hash/detail/batch_hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Hashes the nodes of a Merkle tree level. A leaf is the digest of its octets,
+                 * a parent the digest of the concatenation of its children. Whole runs of nodes
+                 * go through batch_hasher, so the multi-buffer kernels hash several at a time.
+                 *
+                 * Leaf messages start with leaf_prefix and parent messages with node_prefix, so the
+                 * concatenation of some children can never be passed off as a leaf and the other
+                 * way round.
+                 *
+                 * @tparam Hash
+                 */
+                template<typename Hash, typename = void>
+                struct merkle_node_hasher {
+                    typedef batch_hasher<Hash> batch_hasher_type;
+                    typedef typename batch_hasher_type::digest_type digest_type;
+
+                    BOOST_STATIC_ASSERT(sizeof(digest_type) == Hash::digest_bits / octet_bits);
+
+                    constexpr static const std::uint8_t leaf_prefix = 0x00;
+                    constexpr static const std::uint8_t node_prefix = 0x01;
+
+                    /*!
+                     * @param leaves Random access iterator to contiguous containers of octets
+                     */
+                    template<typename LeafIterator>
+                    static inline void hash_leaves(LeafIterator leaves, std::size_t n, digest_type *out) {
+                        std::vector<std::size_t> sizes(n);
+                        std::size_t total = 0;
+                        for (std::size_t i = 0; i != n; ++i) {
+                            const auto &leaf = leaves[i];
+                            typedef typename std::remove_cv<
+                                typename std::remove_pointer<decltype(std::data(leaf))>::type>::type leaf_value_type;
+                            BOOST_STATIC_ASSERT(sizeof(leaf_value_type) == 1);
+
+                            sizes[i] = 1 + std::size(leaf);
+                            total += sizes[i];
+                        }
+
+                        std::vector<std::uint8_t> messages(total);
+                        std::vector<const std::uint8_t *> data(n);
+                        std::uint8_t *message = messages.data();
+                        for (std::size_t i = 0; i != n; ++i) {
+                            const auto &leaf = leaves[i];
+                            data[i] = message;
+                            *message = leaf_prefix;
+                            std::copy_n(reinterpret_cast<const std::uint8_t *>(std::data(leaf)), sizes[i] - 1,
+                                        message + 1);
+                            message += sizes[i];
+                        }
+                        batch_hasher_type::process(data.data(), sizes.data(), n, out);
+                    }
+
+                    /*!
+                     * @brief Hashes count children into their parents, arity at a time. The last
+                     * parent takes whatever children remain.
+                     */
+                    static inline void hash_nodes(const digest_type *children, std::size_t count, std::size_t arity,
+                                                  digest_type *out) {
+                        std::size_t n = (count + arity - 1) / arity;
+                        std::vector<std::uint8_t> messages(n + count * sizeof(digest_type));
+                        std::vector<const std::uint8_t *> data(n);
+                        std::vector<std::size_t> sizes(n);
+                        std::uint8_t *message = messages.data();
+                        for (std::size_t i = 0; i != n; ++i) {
+                            std::size_t octets = std::min(arity, count - i * arity) * sizeof(digest_type);
+                            data[i] = message;
+                            sizes[i] = 1 + octets;
+                            *message = node_prefix;
+                            std::copy_n(reinterpret_cast<const std::uint8_t *>(children + i * arity), octets,
+                                        message + 1);
+                            message += sizes[i];
+                        }
+                        batch_hasher_type::process(data.data(), sizes.data(), n, out);
+                    }
+
+                    /*!
+                     * @brief Hashes a single parent, for the nodes which are updated one at a time
+                     */
+                    static inline digest_type hash_node(const digest_type *children, std::size_t count) {
+                        hasher<Hash> h;
+                        h.update(&node_prefix, 1);
+                        return h.update(reinterpret_cast<const std::uint8_t *>(children), count * sizeof(digest_type))
+                            .finalize();
+                    }
+                };
+
+                /*!
+                 * @brief Contiguous run of group elements, absorbed as a whole by the Poseidon hash
+                 * overloads
+                 */
+                template<typename T>
+                struct merkle_children {
+                    typedef T value_type;
+
+                    inline const T *begin() const {
+                        return first;
+                    }
+
+                    inline const T *end() const {
+                        return last;
+                    }
+
+                    const T *first;
+                    const T *last;
+                };
+
+                /*!
+                 * @brief Poseidon nodes are field elements. Leaves are hashed with the hash overloads
+                 * for a single element or for a container of integers, parents by absorbing their
+                 * children into one sponge. Leaf sponges start by absorbing zero and parent sponges
+                 * by absorbing one, which separates the two the way the octet prefixes do.
+                 */
+                template<typename Hash>
+                struct merkle_node_hasher<Hash, typename std::enable_if<is_poseidon<Hash>::value>::type> {
+                    typedef typename Hash::digest_type digest_type;
+
+                    template<typename LeafIterator>
+                    static inline void hash_leaves(LeafIterator leaves, std::size_t n, digest_type *out) {
+                        for (std::size_t i = 0; i != n; ++i) {
+                            out[i] = ::nil::crypto3::hash<Hash>(leaves[i], digest_type::zero());
+                        }
+                    }
+
+                    static inline void hash_nodes(const digest_type *children, std::size_t count, std::size_t arity,
+                                                  digest_type *out) {
+                        for (std::size_t i = 0; i * arity < count; ++i) {
+                            out[i] = hash_node(children + i * arity, std::min(arity, count - i * arity));
+                        }
+                    }
+
+                    static inline digest_type hash_node(const digest_type *children, std::size_t count) {
+                        merkle_children<digest_type> group = {children, children + count};
+                        return ::nil::crypto3::hash<Hash>(group, digest_type::one());
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_MERKLE_NODE_HASHER_HPP
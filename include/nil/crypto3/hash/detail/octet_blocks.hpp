@@ -0,0 +1,60 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_DETAIL_OCTET_BLOCKS_HPP
+#define CRYPTO3_HASH_DETAIL_OCTET_BLOCKS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Constructions absorbing in lane order take whole blocks straight from octets
+                 * with process_octets
+                 */
+                template<typename Construction, typename = void>
+                struct absorbs_octets : std::false_type { };
+
+                template<typename Construction>
+                struct absorbs_octets<Construction, typename std::enable_if<Construction::native_lane_order>::type>
+                    : std::true_type { };
+
+                /*!
+                 * @brief Run of whole blocks left in the input octets, handed to the hash accumulator
+                 * in one go instead of being packed into words batch by batch
+                 */
+                struct octet_blocks {
+                    const std::uint8_t *data;
+                    std::size_t amount;
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_OCTET_BLOCKS_HPP
@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_DETAIL_OCTET_INJECTOR_HPP
+#define CRYPTO3_HASH_DETAIL_OCTET_INJECTOR_HPP
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include <nil/crypto3/detail/octet.hpp>
+#include <nil/crypto3/detail/stream_endian.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Octet placement of a stream endianness: whether the first octet of a word is
+                 * its most significant one and whether the first bit of an octet is its most significant one.
+                 * Endiannesses without a specialization keep using the bit-level injector.
+                 */
+                template<typename Endianness>
+                struct octet_order {
+                    constexpr static const bool is_specialized = false;
+                };
+
+                template<>
+                struct octet_order<stream_endian::big_octet_big_bit> {
+                    constexpr static const bool is_specialized = true;
+                    constexpr static const bool big_octet = true;
+                    constexpr static const bool big_bit = true;
+                };
+
+                template<>
+                struct octet_order<stream_endian::little_octet_big_bit> {
+                    constexpr static const bool is_specialized = true;
+                    constexpr static const bool big_octet = false;
+                    constexpr static const bool big_bit = true;
+                };
+
+                template<>
+                struct octet_order<stream_endian::big_octet_little_bit> {
+                    constexpr static const bool is_specialized = true;
+                    constexpr static const bool big_octet = true;
+                    constexpr static const bool big_bit = false;
+                };
+
+                /*!
+                 * @brief Injector counterpart for octet-aligned positions. Works on whole words and octets
+                 * of a block instead of single bits.
+                 *
+                 * @tparam Endianness
+                 * @tparam BlockType
+                 */
+                template<typename Endianness, typename BlockType>
+                struct octet_injector {
+                    typedef octet_order<Endianness> order_type;
+                    typedef BlockType block_type;
+                    typedef typename block_type::value_type word_type;
+
+                    constexpr static const std::size_t word_bits = std::numeric_limits<word_type>::digits;
+                    constexpr static const std::size_t word_octets = word_bits / octet_bits;
+                    constexpr static const std::size_t block_octets = std::tuple_size<block_type>::value * word_octets;
+
+                    constexpr static const bool is_available = order_type::is_specialized;
+
+                    /*!
+                     * @brief Octet value holding the first bit of the stream
+                     */
+                    constexpr static octet_type first_bit() {
+                        return order_type::big_bit ? 0x80 : 0x01;
+                    }
+
+                    /*!
+                     * @brief Zeroes everything from the given octet to the end of the block
+                     */
+                    static inline void truncate(block_type &block, std::size_t octets) {
+                        std::size_t word = octets / word_octets;
+                        std::size_t kept = octets % word_octets;
+
+                        if (kept) {
+                            std::size_t dropped_bits = (word_octets - kept) * octet_bits;
+                            word_type mask = order_type::big_octet ? ~word_type() << dropped_bits :
+                                                                     ~word_type() >> dropped_bits;
+                            block[word] &= mask;
+                            ++word;
+                        }
+                        std::fill(block.begin() + word, block.end(), 0);
+                    }
+
+                    static inline void xor_octet(block_type &block, std::size_t octet, octet_type value) {
+                        block[octet / word_octets] ^= static_cast<word_type>(value) << shift(octet);
+                    }
+
+                protected:
+                    static inline std::size_t shift(std::size_t octet) {
+                        std::size_t j = octet % word_octets;
+                        return (order_type::big_octet ? word_octets - 1 - j : j) * octet_bits;
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_OCTET_INJECTOR_HPP
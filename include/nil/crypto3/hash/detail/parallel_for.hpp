@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_DETAIL_PARALLEL_FOR_HPP
+#define CRYPTO3_HASH_DETAIL_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#ifndef CRYPTO3_HASH_NO_THREADS
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+#ifndef CRYPTO3_HASH_NO_THREADS
+                /*!
+                 * @brief Worker threads shared by every parallel_for of the process. Workers are
+                 * started on demand, up to the most any call has asked for, and then kept until
+                 * exit, so a call costs a few queue operations rather than thread creation.
+                 *
+                 * A thread waiting for its tasks runs queued ones meanwhile, so parallel_for may be
+                 * nested without running out of workers.
+                 */
+                class parallel_for_pool {
+                public:
+                    static parallel_for_pool &instance() {
+                        static parallel_for_pool pool;
+                        return pool;
+                    }
+
+                    ~parallel_for_pool() {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            stopping_ = true;
+                        }
+                        signal_.notify_all();
+                        for (std::thread &worker : workers_) {
+                            worker.join();
+                        }
+                    }
+
+                    /*!
+                     * @brief Runs every task, the first one on the calling thread, and returns once all
+                     * of them are done. The first exception thrown by a task is rethrown here, after the
+                     * others have finished, since they refer to the caller's frame.
+                     */
+                    inline void run(std::vector<std::function<void()>> &tasks) {
+                        std::size_t pending = tasks.size() - 1;
+                        std::exception_ptr error;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            while (workers_.size() < pending) {
+                                workers_.emplace_back([this]() { work(); });
+                            }
+                            for (std::size_t i = 1; i != tasks.size(); ++i) {
+                                queue_.emplace_back([&tasks, &pending, &error, i, this]() {
+                                    std::exception_ptr e = guarded(tasks[i]);
+                                    std::lock_guard<std::mutex> lock(mutex_);
+                                    if (e && !error) {
+                                        error = e;
+                                    }
+                                    if (!--pending) {
+                                        signal_.notify_all();
+                                    }
+                                });
+                            }
+                        }
+                        signal_.notify_all();
+
+                        std::exception_ptr first_error = guarded(tasks[0]);
+
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        while (pending) {
+                            if (!queue_.empty()) {
+                                run_one(lock);
+                            } else {
+                                signal_.wait(lock);
+                            }
+                        }
+                        if (first_error || error) {
+                            std::rethrow_exception(first_error ? first_error : error);
+                        }
+                    }
+
+                protected:
+                    parallel_for_pool() : stopping_(false) {
+                    }
+
+                    static inline std::exception_ptr guarded(const std::function<void()> &task) {
+                        try {
+                            task();
+                        } catch (...) {
+                            return std::current_exception();
+                        }
+                        return std::exception_ptr();
+                    }
+
+                    // Pops the oldest task and runs it with the lock released
+                    inline void run_one(std::unique_lock<std::mutex> &lock) {
+                        std::function<void()> task = std::move(queue_.front());
+                        queue_.pop_front();
+                        lock.unlock();
+                        task();
+                        lock.lock();
+                    }
+
+                    inline void work() {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        while (true) {
+                            signal_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+                            if (queue_.empty()) {
+                                return;
+                            }
+                            run_one(lock);
+                        }
+                    }
+
+                    std::mutex mutex_;
+                    // Tasks were queued, a run finished, or the pool is stopping
+                    std::condition_variable signal_;
+                    std::deque<std::function<void()>> queue_;
+                    std::vector<std::thread> workers_;
+                    bool stopping_;
+                };
+#endif
+
+                /*!
+                 * @brief Splits [0, n) into at most threads contiguous ranges and runs f(first, last) on
+                 * each, the first range on the calling thread and the others on parallel_for_pool.
+                 * Returns once all of them are done. Built with CRYPTO3_HASH_NO_THREADS, every range
+                 * runs on the calling thread.
+                 */
+                template<typename Function>
+                inline void parallel_for(std::size_t n, std::size_t threads, Function f) {
+                    threads = std::max<std::size_t>(1, std::min(threads, n));
+#ifndef CRYPTO3_HASH_NO_THREADS
+                    if (threads != 1) {
+                        std::size_t step = (n + threads - 1) / threads;
+                        std::vector<std::function<void()>> tasks;
+                        for (std::size_t first = 0; first < n; first += step) {
+                            std::size_t last = std::min(n, first + step);
+                            tasks.emplace_back([&f, first, last]() { f(first, last); });
+                        }
+                        parallel_for_pool::instance().run(tasks);
+                        return;
+                    }
+#endif
+                    f(std::size_t(0), n);
+                }
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_PARALLEL_FOR_HPP
@@ -0,0 +1,390 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_DETAIL_PBKDF2_ENGINE_HPP
+#define CRYPTO3_HASH_DETAIL_PBKDF2_ENGINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <boost/config.hpp>
+
+#include <nil/crypto3/detail/pack.hpp>
+#include <nil/crypto3/detail/stream_endian.hpp>
+
+#include <nil/crypto3/hash/hmac.hpp>
+#include <nil/crypto3/hash/detail/merkle_damgard_construction.hpp>
+#include <nil/crypto3/hash/detail/nop_finalizer.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_multi_buffer.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            template<std::size_t Version>
+            class sha2;
+
+            namespace detail {
+                template<typename Construction>
+                struct is_merkle_damgard_construction : std::false_type { };
+
+                template<typename Params, typename IV, typename Compressor, typename Padding, typename Finalizer>
+                struct is_merkle_damgard_construction<
+                    merkle_damgard_construction<Params, IV, Compressor, Padding, Finalizer>>
+                    : std::is_same<Finalizer, nop_finalizer> { };
+
+                /*!
+                 * @brief PBKDF2 iterations straight on the compression function of a Merkle-Damgard hash.
+                 * Every U_j is the HMAC of a digest, so both of its hashes end with a single block
+                 * made of a digest and a padding that never changes: the block is built once and only
+                 * its digest words are replaced, from one chaining state to the next.
+                 *
+                 * @tparam Hash
+                 */
+                template<typename Hash>
+                struct pbkdf2_compression {
+                    typedef hmac<Hash> mac_type;
+                    typedef typename mac_type::hasher_type hasher_type;
+
+                    typedef typename hasher_type::construction_type construction_type;
+                    typedef typename construction_type::compressor_functor compressor_type;
+                    typedef typename construction_type::padding_functor padding_type;
+                    typedef typename hasher_type::endian_type endian_type;
+
+                    constexpr static const std::size_t word_bits = construction_type::word_bits;
+                    typedef typename construction_type::word_type word_type;
+
+                    typedef typename construction_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = construction_type::block_bits;
+                    constexpr static const std::size_t block_words = construction_type::block_words;
+                    typedef typename construction_type::block_type block_type;
+
+                    constexpr static const std::size_t digest_bits = construction_type::digest_bits;
+                    constexpr static const std::size_t digest_words = digest_bits / word_bits;
+                    typedef typename construction_type::digest_type digest_type;
+
+                    constexpr static const std::size_t length_bits = Hash::construction::params_type::length_bits;
+                    constexpr static const std::size_t length_words = length_bits / word_bits;
+
+                    // The digest, the padding and the length share the last block
+                    constexpr static const bool is_available =
+                        is_merkle_damgard_construction<construction_type>::value && digest_bits % word_bits == 0 &&
+                        digest_bits + octet_bits + length_bits <= block_bits;
+
+                    /*!
+                     * @brief Last block of the hash of one block followed by a digest, with zero
+                     * digest words
+                     */
+                    static inline block_type final_block() {
+                        block_type block;
+                        std::fill(block.begin(), block.end(), 0);
+                        std::size_t block_seen = digest_bits;
+                        padding_type()(block, block_seen);
+
+                        // The length fits in the least significant word of the length field
+                        const bool little_endian =
+                            std::is_same<endian_type, stream_endian::little_octet_big_bit>::value;
+                        block[little_endian ? block_words - length_words : block_words - 1] =
+                            static_cast<word_type>(block_bits + digest_bits);
+                        return block;
+                    }
+
+                    static inline state_type digest_words_of(const digest_type &d) {
+                        state_type words = {};
+                        ::nil::crypto3::detail::pack_to<endian_type, octet_bits, word_bits>(d.begin(), d.end(),
+                                                                                           words.begin());
+                        return words;
+                    }
+
+                    static inline digest_type digest_of(const state_type &words) {
+                        digest_type d;
+                        ::nil::crypto3::detail::pack_from<endian_type, word_bits, octet_bits>(
+                            words.begin(), words.begin() + digest_words, d.begin());
+                        return d;
+                    }
+
+                    /*!
+                     * @param t U_1 in its first digest words on entry, T on exit
+                     */
+                    static inline void iterate(const state_type &inner, const state_type &outer, state_type &t,
+                                               std::size_t iterations) {
+                        block_type block = final_block();
+                        std::copy(t.begin(), t.begin() + digest_words, block.begin());
+
+                        for (std::size_t j = 1; j < iterations; ++j) {
+                            state_type s = inner;
+                            compressor_type::process_block(s, block);
+                            std::copy(s.begin(), s.begin() + digest_words, block.begin());
+
+                            s = outer;
+                            compressor_type::process_block(s, block);
+                            std::copy(s.begin(), s.begin() + digest_words, block.begin());
+                            for (std::size_t i = 0; i != digest_words; ++i) {
+                                t[i] ^= s[i];
+                            }
+                        }
+                    }
+                };
+
+                /*!
+                 * @brief PBKDF2 iterations of several independent blocks at once, one per vector lane.
+                 * Hashes without a multi-buffer kernel are not available.
+                 *
+                 * @tparam Hash
+                 */
+                template<typename Hash, typename = void>
+                struct pbkdf2_multi_buffer {
+                    constexpr static const bool is_available = false;
+                };
+
+#ifdef CRYPTO3_HASH_SHA2_256_MULTI_BUFFER
+                /*!
+                 * @brief pbkdf2_compression::iterate for up to Lanes blocks of SHA-224/256, on the
+                 * compression of sha2_256_multi_buffer. Force-inlined like the kernel, so it runs on
+                 * the instruction set of the entry point it is compiled into.
+                 */
+                template<std::size_t Lanes, std::size_t Version>
+                struct pbkdf2_sha2_256_lanes : public sha2_256_multi_buffer<Lanes, sha2_policy<Version>> {
+                    typedef sha2_256_multi_buffer<Lanes, sha2_policy<Version>> base_type;
+                    typedef pbkdf2_compression<sha2<Version>> compression_type;
+
+                    typedef typename base_type::word_type word_type;
+                    typedef typename base_type::vector_type vector_type;
+                    typedef typename compression_type::state_type state_type;
+                    typedef typename compression_type::block_type block_type;
+
+                    constexpr static const std::size_t lanes = base_type::lanes;
+                    constexpr static const std::size_t state_words = base_type::state_words;
+                    constexpr static const std::size_t block_words = base_type::block_words;
+                    constexpr static const std::size_t digest_words = compression_type::digest_words;
+
+                    BOOST_FORCEINLINE static void iterate(const state_type *inner, const state_type *outer,
+                                                          state_type *t, std::size_t count, std::size_t iterations) {
+                        vector_type I[state_words], O[state_words], U[state_words], T[state_words];
+                        transpose(inner, count, I);
+                        transpose(outer, count, O);
+                        transpose(t, count, T);
+                        std::copy(T, T + state_words, U);
+
+                        const block_type block = compression_type::final_block();
+                        vector_type padding[block_words];
+                        for (std::size_t i = 0; i != block_words; ++i) {
+                            base_type::set1(padding[i], block[i]);
+                        }
+                        vector_type mask;
+                        base_type::set1(mask, ~word_type());
+
+                        for (std::size_t j = 1; j < iterations; ++j) {
+                            vector_type S[state_words], W[block_words];
+
+                            // The schedule is expanded in place, so the block is rebuilt for every compression
+                            std::copy(I, I + state_words, S);
+                            std::copy(U, U + digest_words, W);
+                            std::copy(padding + digest_words, padding + block_words, W + digest_words);
+                            base_type::compress(S, W, mask);
+
+                            std::copy(S, S + digest_words, W);
+                            std::copy(padding + digest_words, padding + block_words, W + digest_words);
+                            std::copy(O, O + state_words, S);
+                            base_type::compress(S, W, mask);
+
+                            for (std::size_t i = 0; i != digest_words; ++i) {
+                                U[i] = S[i];
+                                T[i] ^= S[i];
+                            }
+                        }
+
+                        for (std::size_t l = 0; l != count; ++l) {
+                            for (std::size_t i = 0; i != digest_words; ++i) {
+                                t[l][i] = T[i][l];
+                            }
+                        }
+                    }
+
+                protected:
+                    // Word i of every state goes to vector i, unused lanes are zero
+                    BOOST_FORCEINLINE static void transpose(const state_type *states, std::size_t count,
+                                                            vector_type *v) {
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            v[i] = vector_type {};
+                            for (std::size_t l = 0; l != count; ++l) {
+                                v[i][l] = states[l][i];
+                            }
+                        }
+                    }
+                };
+
+                /*!
+                 * @brief Multi-buffer PBKDF2 iterations for SHA-224/256, choosing between 16, 8 and 4
+                 * lanes from the features of the CPU it runs on, like sha2_256_multi_buffer_dispatch.
+                 */
+                template<std::size_t Version>
+                struct pbkdf2_multi_buffer<sha2<Version>,
+                                           typename std::enable_if<Version == 224 || Version == 256>::type> {
+                    typedef typename pbkdf2_compression<sha2<Version>>::state_type state_type;
+
+                    constexpr static const bool is_available = true;
+
+                    struct backend_type {
+                        const char *name;
+                        // Blocks iterated at once
+                        std::size_t lanes;
+                        void (*iterate)(const state_type *, const state_type *, state_type *, std::size_t,
+                                        std::size_t);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        if (features.avx512f) {
+                            return {"avx512", 16, &iterate_avx512};
+                        }
+                        if (features.avx2) {
+                            return {"avx2", 8, &iterate_avx2};
+                        }
+                        return {"sse2", 4, &iterate_sse2};
+                    }
+
+                    static inline std::size_t lanes() {
+                        return backend().lanes;
+                    }
+
+                    /*!
+                     * @brief pbkdf2_compression::iterate for up to lanes() blocks
+                     */
+                    static inline void iterate(const state_type *inner, const state_type *outer, state_type *t,
+                                               std::size_t count, std::size_t iterations) {
+                        backend().iterate(inner, outer, t, count, iterations);
+                    }
+
+                protected:
+                    static void iterate_sse2(const state_type *inner, const state_type *outer, state_type *t,
+                                             std::size_t count, std::size_t iterations) {
+                        pbkdf2_sha2_256_lanes<4, Version>::iterate(inner, outer, t, count, iterations);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void iterate_avx2(const state_type *inner, const state_type *outer, state_type *t,
+                                             std::size_t count, std::size_t iterations) {
+                        pbkdf2_sha2_256_lanes<8, Version>::iterate(inner, outer, t, count, iterations);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void iterate_avx512(const state_type *inner, const state_type *outer, state_type *t,
+                                               std::size_t count, std::size_t iterations) {
+                        pbkdf2_sha2_256_lanes<16, Version>::iterate(inner, outer, t, count, iterations);
+                    }
+                };
+#endif
+
+                /*!
+                 * @brief Runs the iterations of PBKDF2 for independent output blocks, each keyed with
+                 * its own HMAC: blocks of one long key as well as keys of different passwords. Hashes
+                 * without a direct compression path go through hmac, which still starts every U_j from
+                 * the precomputed key midstates.
+                 *
+                 * @tparam Hash
+                 */
+                template<typename Hash, typename = void>
+                struct pbkdf2_engine {
+                    typedef hmac<Hash> mac_type;
+                    typedef typename mac_type::digest_type digest_type;
+
+                    /*!
+                     * @param blocks U_1 of every block on entry, the block T on exit
+                     */
+                    static inline void process(const mac_type *const *macs, digest_type *blocks, std::size_t count,
+                                               std::size_t iterations) {
+                        for (std::size_t b = 0; b != count; ++b) {
+                            digest_type u = blocks[b];
+                            for (std::size_t j = 1; j < iterations; ++j) {
+                                u = (*macs[b])(u);
+                                for (std::size_t i = 0; i != u.size(); ++i) {
+                                    blocks[b][i] ^= u[i];
+                                }
+                            }
+                        }
+                    }
+                };
+
+                template<typename Hash>
+                struct pbkdf2_engine<Hash, typename std::enable_if<pbkdf2_compression<Hash>::is_available>::type> {
+                    typedef hmac<Hash> mac_type;
+                    typedef typename mac_type::digest_type digest_type;
+
+                    typedef pbkdf2_compression<Hash> compression_type;
+                    typedef pbkdf2_multi_buffer<Hash> multi_buffer_type;
+                    typedef typename compression_type::state_type state_type;
+
+                    static inline void process(const mac_type *const *macs, digest_type *blocks, std::size_t count,
+                                               std::size_t iterations) {
+                        std::vector<state_type> inner(count), outer(count), t(count);
+                        for (std::size_t b = 0; b != count; ++b) {
+                            inner[b] = macs[b]->inner_state();
+                            outer[b] = macs[b]->outer_state();
+                            t[b] = compression_type::digest_words_of(blocks[b]);
+                        }
+
+                        std::size_t b = 0;
+                        iterate_lanes(inner.data(), outer.data(), t.data(), count, iterations, b,
+                                      std::integral_constant<bool, multi_buffer_type::is_available>());
+                        // A lone block is cheaper on the scalar compression than in a mostly empty vector
+                        for (; b != count; ++b) {
+                            compression_type::iterate(inner[b], outer[b], t[b], iterations);
+                        }
+
+                        for (b = 0; b != count; ++b) {
+                            blocks[b] = compression_type::digest_of(t[b]);
+                        }
+                    }
+
+                protected:
+                    static inline void iterate_lanes(const state_type *inner, const state_type *outer, state_type *t,
+                                                     std::size_t count, std::size_t iterations, std::size_t &b,
+                                                     std::true_type) {
+                        const std::size_t lanes = multi_buffer_type::lanes();
+                        for (; count - b > 1; b += std::min(lanes, count - b)) {
+                            multi_buffer_type::iterate(inner + b, outer + b, t + b, std::min(lanes, count - b),
+                                                       iterations);
+                        }
+                    }
+
+                    static inline void iterate_lanes(const state_type *, const state_type *, state_type *,
+                                                     std::size_t, std::size_t, std::size_t &, std::false_type) {
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_DETAIL_PBKDF2_ENGINE_HPP
@@ -0,0 +1,135 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_SHA1_SHA_NI_IMPL_HPP
+#define CRYPTO3_HASH_SHA1_SHA_NI_IMPL_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include <immintrin.h>
+
+#include <nil/crypto3/hash/detail/sha1/sha1_policy.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief SHA-1 compression function on the x86 SHA extensions. Implements the
+                 * compressor interface of davies_meyer_compressor<shacal1, state_adder>.
+                 *
+                 * The round instructions expect the first message word in the highest lane,
+                 * so the already big-endian block words only need their order reversed.
+                 */
+                struct sha1_sha_ni_impl {
+                    typedef sha1_policy policy_type;
+                    typedef typename policy_type::block_cipher_type block_cipher_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_bits = policy_type::state_bits;
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = policy_type::block_bits;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    typedef typename policy_type::block_type block_type;
+
+                    constexpr static const std::size_t rounds = 80;
+
+                    inline static void process_block(state_type &state, const block_type &block) {
+                        process_blocks(state, &block, 1);
+                    }
+
+                    CRYPTO3_HASH_TARGET("sha,sse4.1")
+                    inline static void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                        __m128i abcd =
+                            _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0])), 0x1B);
+                        __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+                        for (; n; --n, ++blocks) {
+                            const __m128i abcd_save = abcd;
+                            const __m128i e0_save = e0;
+
+                            __m128i w[4];
+                            for (std::size_t i = 0; i != 4; ++i) {
+                                w[i] = _mm_shuffle_epi32(
+                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(&(*blocks)[4 * i])), 0x1B);
+                            }
+
+                            __m128i e1;
+                            process_quads(abcd, e0, e1, w, std::make_index_sequence<rounds / 4>());
+
+                            abcd = _mm_add_epi32(abcd, abcd_save);
+                            e0 = _mm_sha1nexte_epu32(e0, e0_save);
+                        }
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), _mm_shuffle_epi32(abcd, 0x1B));
+                        state[4] = static_cast<word_type>(_mm_extract_epi32(e0, 3));
+                    }
+
+                protected:
+                    template<std::size_t... Quads>
+                    CRYPTO3_HASH_TARGET("sha,sse4.1")
+                    inline static void process_quads(__m128i &abcd, __m128i &e0, __m128i &e1, __m128i *w,
+                                                     std::index_sequence<Quads...>) {
+                        (quad<Quads>(abcd, e0, e1, w), ...);
+                    }
+
+                    /*!
+                     * @brief Rounds 4 * Quad .. 4 * Quad + 3, interleaved with the message schedule
+                     * of the words three quads ahead. E alternates between e0 and e1: one holds the
+                     * rotated E for this quad, the other receives the one for the following quad.
+                     */
+                    template<std::size_t Quad>
+                    CRYPTO3_HASH_TARGET("sha,sse4.1")
+                    inline static void quad(__m128i &abcd, __m128i &e0, __m128i &e1, __m128i *w) {
+                        __m128i &e = Quad % 2 ? e1 : e0;
+                        __m128i &next = Quad % 2 ? e0 : e1;
+                        __m128i &cur = w[Quad % 4];
+
+                        e = Quad ? _mm_sha1nexte_epu32(e, cur) : _mm_add_epi32(e, cur);
+                        next = abcd;
+                        if (Quad >= 3 && Quad <= 18) {
+                            w[(Quad + 1) % 4] = _mm_sha1msg2_epu32(w[(Quad + 1) % 4], cur);
+                        }
+                        abcd = _mm_sha1rnds4_epu32(abcd, e, Quad / 5);
+                        if (Quad >= 1 && Quad <= 16) {
+                            w[(Quad + 3) % 4] = _mm_sha1msg1_epu32(w[(Quad + 3) % 4], cur);
+                        }
+                        if (Quad >= 2 && Quad <= 17) {
+                            w[(Quad + 2) % 4] = _mm_xor_si128(w[(Quad + 2) % 4], cur);
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHA1_SHA_NI_IMPL_HPP
@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_SHA2_256_DISPATCH_IMPL_HPP
+#define CRYPTO3_HASH_SHA2_256_DISPATCH_IMPL_HPP
+
+#include <cstddef>
+
+#include <nil/crypto3/hash/detail/sha2/sha2_policy.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_sha_ni_impl.hpp>
+#include <nil/crypto3/hash/detail/state_adder.hpp>
+#include <nil/crypto3/hash/detail/davies_meyer_compressor.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief SHA-224/256 compression choosing between the SHA extensions and the portable
+                 * Davies-Meyer compressor from the features of the CPU it runs on. The choice is made
+                 * once, on first use, and every run of blocks goes to the chosen kernel as a whole.
+                 *
+                 * @tparam PolicyType sha2_policy<224> or sha2_policy<256>
+                 */
+                template<typename PolicyType>
+                struct sha2_256_dispatch_impl {
+                    typedef PolicyType policy_type;
+                    typedef typename policy_type::block_cipher_type block_cipher_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_bits = policy_type::state_bits;
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = policy_type::block_bits;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    typedef typename policy_type::block_type block_type;
+
+                    struct backend_type {
+                        const char *name;
+                        void (*process_blocks)(state_type &, const block_type *, std::size_t);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        if (features.sha_ni && features.sse4_1) {
+                            return {"sha_ni", &sha2_256_sha_ni_impl<policy_type>::process_blocks};
+                        }
+                        return {"generic",
+                                &davies_meyer_compressor<block_cipher_type, detail::state_adder>::process_blocks};
+                    }
+
+                    inline static void process_block(state_type &state, const block_type &block) {
+                        backend().process_blocks(state, &block, 1);
+                    }
+
+                    inline static void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                        backend().process_blocks(state, blocks, n);
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHA2_256_DISPATCH_IMPL_HPP
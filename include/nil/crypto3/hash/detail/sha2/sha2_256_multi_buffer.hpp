@@ -0,0 +1,292 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_SHA2_256_MULTI_BUFFER_HPP
+#define CRYPTO3_HASH_SHA2_256_MULTI_BUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/config.hpp>
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+#include <nil/crypto3/hash/detail/sha2/sha2_policy.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Multi-buffer SHA-256: hashes independent messages at once, one message per
+                 * vector lane. Messages of different lengths share the same block loop, and a lane
+                 * that has run out of blocks keeps its state through a per-lane mask.
+                 *
+                 * Vectors are written with the compiler's generic vector extension and everything is
+                 * force-inlined, so the instruction set is the one of the entry point in
+                 * sha2_256_multi_buffer_simd the kernel ends up in.
+                 *
+                 * @tparam Lanes 4, 8 or 16
+                 * @tparam Policy sha2_policy<224> or sha2_policy<256>
+                 */
+                template<std::size_t Lanes, typename Policy>
+                struct sha2_256_multi_buffer {
+                    constexpr static const std::size_t lanes = Lanes;
+
+                    typedef Policy policy_type;
+                    typedef sha2_constants<32> constants_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+                    typedef word_type vector_type __attribute__((vector_size(lanes * sizeof(word_type))));
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t block_octets = policy_type::block_bits / octet_bits;
+                    constexpr static const std::size_t length_octets = policy_type::length_bits / octet_bits;
+
+                    constexpr static const std::size_t digest_octets = policy_type::digest_bits / octet_bits;
+                    typedef typename policy_type::digest_type digest_type;
+
+                    BOOST_FORCEINLINE static void process(const std::uint8_t *const *data, const std::size_t *sizes,
+                                                          std::size_t n, digest_type *digests) {
+                        for (std::size_t i = 0; i < n; i += lanes) {
+                            process_group(data + i, sizes + i, std::min(lanes, n - i), digests + i);
+                        }
+                    }
+
+                protected:
+                    BOOST_FORCEINLINE static void process_group(const std::uint8_t *const *data,
+                                                                const std::size_t *sizes, std::size_t count,
+                                                                digest_type *digests) {
+                        // The last one or two blocks of every message, with the Merkle-Damgard padding applied
+                        std::array<std::array<std::uint8_t, 2 * block_octets>, lanes> tails;
+                        std::array<std::size_t, lanes> full_blocks;
+                        std::array<std::size_t, lanes> total_blocks;
+                        std::size_t max_blocks = 0;
+
+                        for (std::size_t l = 0; l != lanes; ++l) {
+                            std::fill(tails[l].begin(), tails[l].end(), 0);
+                            if (l >= count) {
+                                full_blocks[l] = total_blocks[l] = 0;
+                                continue;
+                            }
+
+                            std::size_t rem = sizes[l] % block_octets;
+                            std::size_t tail_blocks = rem + 1 + length_octets > block_octets ? 2 : 1;
+                            full_blocks[l] = sizes[l] / block_octets;
+                            total_blocks[l] = full_blocks[l] + tail_blocks;
+                            max_blocks = std::max(max_blocks, total_blocks[l]);
+
+                            if (rem) {
+                                std::memcpy(tails[l].data(), data[l] + full_blocks[l] * block_octets, rem);
+                            }
+                            tails[l][rem] = 0x80;
+
+                            std::uint64_t total_bits = static_cast<std::uint64_t>(sizes[l]) * octet_bits;
+                            for (std::size_t i = 0; i != 8; ++i) {
+                                tails[l][tail_blocks * block_octets - 1 - i] =
+                                    static_cast<std::uint8_t>(total_bits >> (i * octet_bits));
+                            }
+                        }
+
+                        vector_type H[state_words];
+                        typename policy_type::iv_generator iv;
+                        for (std::size_t i = 0; i != state_words; ++i) {
+                            set1(H[i], iv()[i]);
+                        }
+
+                        vector_type W[block_words];
+                        vector_type mask;
+
+                        for (std::size_t b = 0; b != max_blocks; ++b) {
+                            for (std::size_t l = 0; l != lanes; ++l) {
+                                const std::uint8_t *p;
+                                if (b < full_blocks[l]) {
+                                    p = data[l] + b * block_octets;
+                                } else if (b < total_blocks[l]) {
+                                    p = tails[l].data() + (b - full_blocks[l]) * block_octets;
+                                } else {
+                                    // Finished lanes compress garbage which the mask throws away
+                                    p = tails[l].data();
+                                }
+                                mask[l] = b < total_blocks[l] ? ~word_type() : word_type();
+
+                                for (std::size_t t = 0; t != block_words; ++t, p += 4) {
+                                    W[t][l] = (word_type(p[0]) << 24) | (word_type(p[1]) << 16) |
+                                              (word_type(p[2]) << 8) | word_type(p[3]);
+                                }
+                            }
+                            compress(H, W, mask);
+                        }
+
+                        for (std::size_t l = 0; l != count; ++l) {
+                            for (std::size_t i = 0; i != digest_octets; ++i) {
+                                digests[l][i] = static_cast<std::uint8_t>(H[i / 4][l] >> (24 - (i % 4) * octet_bits));
+                            }
+                        }
+                    }
+
+                    // Helpers take and hand back vectors by reference, so no vector crosses a call by value
+                    BOOST_FORCEINLINE static void set1(vector_type &v, word_type x) {
+                        v = vector_type {} + x;
+                    }
+
+                    // Rotations right by A, B and C, XORed together
+                    template<int A, int B, int C>
+                    BOOST_FORCEINLINE static void big_sigma(vector_type &r, const vector_type &x) {
+                        r = ((x >> A) | (x << (word_bits - A))) ^ ((x >> B) | (x << (word_bits - B))) ^
+                            ((x >> C) | (x << (word_bits - C)));
+                    }
+
+                    // Rotations right by A and B and a shift right by S, XORed together
+                    template<int A, int B, int S>
+                    BOOST_FORCEINLINE static void small_sigma(vector_type &r, const vector_type &x) {
+                        r = ((x >> A) | (x << (word_bits - A))) ^ ((x >> B) | (x << (word_bits - B))) ^ (x >> S);
+                    }
+
+                    /*!
+                     * @brief Compresses W into H in the lanes set in mask. The schedule is expanded in
+                     * place, so W is clobbered.
+                     */
+                    BOOST_FORCEINLINE static void compress(vector_type *H, vector_type *W, const vector_type &mask) {
+                        vector_type a = H[0], b = H[1], c = H[2], d = H[3], e = H[4], f = H[5], g = H[6], h = H[7];
+
+                        for (std::size_t t = 0; t != constants_type::rounds; ++t) {
+                            if (t >= block_words) {
+                                vector_type s0, s1;
+                                small_sigma<7, 18, 3>(s0, W[(t - 15) % 16]);
+                                small_sigma<17, 19, 10>(s1, W[(t - 2) % 16]);
+                                W[t % 16] += s0 + s1 + W[(t - 7) % 16];
+                            }
+
+                            vector_type S0, S1;
+                            big_sigma<6, 11, 25>(S1, e);
+                            const vector_type T1 =
+                                h + S1 + ((e & f) ^ (~e & g)) + constants_type::round_constants[t] + W[t % 16];
+                            big_sigma<2, 13, 22>(S0, a);
+                            const vector_type T2 = S0 + ((a & b) | (c & (a | b)));
+
+                            h = g;
+                            g = f;
+                            f = e;
+                            e = d + T1;
+                            d = c;
+                            c = b;
+                            b = a;
+                            a = T1 + T2;
+                        }
+
+                        H[0] += a & mask;
+                        H[1] += b & mask;
+                        H[2] += c & mask;
+                        H[3] += d & mask;
+                        H[4] += e & mask;
+                        H[5] += f & mask;
+                        H[6] += g & mask;
+                        H[7] += h & mask;
+                    }
+                };
+
+#if BOOST_ARCH_X86_64
+                /*!
+                 * @brief Entry points compiling sha2_256_multi_buffer for the instruction sets
+                 * cpu_features reports. Only reachable through sha2_256_multi_buffer_dispatch.
+                 */
+                template<typename Policy>
+                struct sha2_256_multi_buffer_simd {
+                    typedef typename Policy::digest_type digest_type;
+
+                    static void process_sse2(const std::uint8_t *const *data, const std::size_t *sizes,
+                                             std::size_t n, digest_type *digests) {
+                        sha2_256_multi_buffer<4, Policy>::process(data, sizes, n, digests);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx2")
+                    static void process_avx2(const std::uint8_t *const *data, const std::size_t *sizes,
+                                             std::size_t n, digest_type *digests) {
+                        sha2_256_multi_buffer<8, Policy>::process(data, sizes, n, digests);
+                    }
+
+                    CRYPTO3_HASH_TARGET("avx512f")
+                    static void process_avx512(const std::uint8_t *const *data, const std::size_t *sizes,
+                                               std::size_t n, digest_type *digests) {
+                        sha2_256_multi_buffer<16, Policy>::process(data, sizes, n, digests);
+                    }
+                };
+
+                /*!
+                 * @brief Multi-buffer SHA-224/256 choosing between 16, 8 and 4 lanes from the
+                 * features of the CPU it runs on. The choice is made once, on first use.
+                 *
+                 * @tparam Policy sha2_policy<224> or sha2_policy<256>
+                 */
+                template<typename Policy>
+                struct sha2_256_multi_buffer_dispatch {
+                    typedef typename Policy::digest_type digest_type;
+
+                    struct backend_type {
+                        const char *name;
+                        // Messages hashed at once
+                        std::size_t lanes;
+                        void (*process)(const std::uint8_t *const *, const std::size_t *, std::size_t,
+                                        digest_type *);
+                    };
+
+                    static const backend_type &backend() {
+                        static const backend_type selected = select(cpu_features::host());
+                        return selected;
+                    }
+
+                    static backend_type select(const cpu_features &features) {
+                        typedef sha2_256_multi_buffer_simd<Policy> simd_type;
+
+                        if (features.avx512f) {
+                            return {"avx512", 16, &simd_type::process_avx512};
+                        }
+                        if (features.avx2) {
+                            return {"avx2", 8, &simd_type::process_avx2};
+                        }
+                        return {"sse2", 4, &simd_type::process_sse2};
+                    }
+
+                    static inline void process(const std::uint8_t *const *data, const std::size_t *sizes,
+                                               std::size_t n, digest_type *digests) {
+                        backend().process(data, sizes, n, digests);
+                    }
+                };
+
+#define CRYPTO3_HASH_SHA2_256_MULTI_BUFFER
+#endif
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHA2_256_MULTI_BUFFER_HPP
@@ -0,0 +1,125 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_SHA2_256_SHA_NI_IMPL_HPP
+#define CRYPTO3_HASH_SHA2_256_SHA_NI_IMPL_HPP
+
+#include <cstddef>
+
+#include <immintrin.h>
+
+#include <nil/crypto3/hash/detail/sha2/sha2_policy.hpp>
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief SHA-256 compression function on the x86 SHA extensions. Implements the
+                 * compressor interface of davies_meyer_compressor<shacal2<256>, state_adder>, so
+                 * it is a drop-in replacement for sha2<224> and sha2<256>.
+                 *
+                 * Blocks arrive already packed into big-endian words, so the message words are
+                 * loaded as they are, without the byte shuffle a raw octet input would need.
+                 *
+                 * @tparam PolicyType sha2_policy<224> or sha2_policy<256>
+                 */
+                template<typename PolicyType>
+                struct sha2_256_sha_ni_impl {
+                    typedef PolicyType policy_type;
+                    typedef typename policy_type::block_cipher_type block_cipher_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+
+                    constexpr static const std::size_t state_bits = policy_type::state_bits;
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = policy_type::block_bits;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    typedef typename policy_type::block_type block_type;
+
+                    static_assert(word_bits == 32 && state_words == 8 && block_words == 16,
+                                  "SHA extensions implement the 32-bit SHA-2 compression only");
+
+                    typedef sha2_constants<word_bits> constants_type;
+
+                    inline static void process_block(state_type &state, const block_type &block) {
+                        process_blocks(state, &block, 1);
+                    }
+
+                    CRYPTO3_HASH_TARGET("sha,sse4.1")
+                    inline static void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                        // The round instructions keep the state as ABEF and CDGH
+                        __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0])),
+                                                        0xB1);
+                        __m128i cdgh =
+                            _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4])), 0x1B);
+                        __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+                        cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+                        for (; n; --n, ++blocks) {
+                            const __m128i abef_save = abef;
+                            const __m128i cdgh_save = cdgh;
+
+                            __m128i w[4];
+                            for (std::size_t i = 0; i != 4; ++i) {
+                                w[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&(*blocks)[4 * i]));
+                            }
+
+                            for (std::size_t r = 0; r != constants_type::rounds / 4; ++r) {
+                                __m128i &cur = w[r % 4];
+                                if (r >= 4) {
+                                    // w[r % 4] holds W[t - 16], the rest of the ring W[t - 12 .. t - 1]
+                                    tmp = _mm_sha256msg1_epu32(cur, w[(r + 1) % 4]);
+                                    tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(w[(r + 3) % 4], w[(r + 2) % 4], 4));
+                                    cur = _mm_sha256msg2_epu32(tmp, w[(r + 3) % 4]);
+                                }
+
+                                const __m128i wk = _mm_add_epi32(
+                                    cur, _mm_loadu_si128(
+                                             reinterpret_cast<const __m128i *>(&constants_type::round_constants[4 * r])));
+                                cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+                                abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0E));
+                            }
+
+                            abef = _mm_add_epi32(abef, abef_save);
+                            cdgh = _mm_add_epi32(cdgh, cdgh_save);
+                        }
+
+                        tmp = _mm_shuffle_epi32(abef, 0x1B);
+                        cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), _mm_blend_epi16(tmp, cdgh, 0xF0));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), _mm_alignr_epi8(cdgh, tmp, 8));
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHA2_256_SHA_NI_IMPL_HPP
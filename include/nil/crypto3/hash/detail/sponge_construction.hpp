@@ -26,6 +26,9 @@
 #ifndef CRYPTO3_HASH_SPONGE_CONSTRUCTION_HPP
 #define CRYPTO3_HASH_SPONGE_CONSTRUCTION_HPP
 
+#include <cstdint>
+#include <type_traits>
+
 #include <nil/crypto3/detail/static_digest.hpp>
 #include <nil/crypto3/detail/pack.hpp>
 
@@ -34,6 +37,41 @@
 namespace nil {
     namespace crypto3 {
         namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Converts between the state form exchanged through state()/restore() and
+                 * the order a compressor keeps it in while absorbing. Compressors declaring
+                 * native_lane_order provide the conversions, for the others both forms coincide.
+                 */
+                template<typename Compressor, typename = void>
+                struct sponge_lane_order {
+                    constexpr static const bool value = false;
+
+                    template<typename StateType>
+                    static void to_lane_order(StateType &) {
+                    }
+
+                    template<typename StateType>
+                    static void from_lane_order(StateType &) {
+                    }
+                };
+
+                template<typename Compressor>
+                struct sponge_lane_order<Compressor, typename std::enable_if<Compressor::native_lane_order>::type> {
+                    constexpr static const bool value = true;
+
+                    template<typename StateType>
+                    static void to_lane_order(StateType &s) {
+                        Compressor::to_lane_order(s);
+                    }
+
+                    template<typename StateType>
+                    static void from_lane_order(StateType &s) {
+                        Compressor::from_lane_order(s);
+                    }
+                };
+            }    // namespace detail
+
             /*!
              * @brief
              * @tparam DigestEndian
@@ -54,6 +92,8 @@ namespace nil {
                      typename Padding,
                      typename Finalizer = detail::nop_finalizer>
             class sponge_construction {
+                typedef detail::sponge_lane_order<Compressor> lane_order;
+
             public:
                 typedef IV iv_generator;
                 typedef Compressor compressor_functor;
@@ -78,12 +118,35 @@ namespace nil {
                 constexpr static const std::size_t digest_words = digest_bits / word_bits;
                 typedef static_digest<digest_bits> digest_type;
 
+                /*!
+                 * @brief Whether whole blocks may be absorbed straight from octets with process_octets
+                 */
+                constexpr static const bool native_lane_order = lane_order::value;
+
                 template<typename Integer = std::size_t>
                 inline sponge_construction &process_block(const block_type &block, Integer seen = Integer()) {
                     compressor_functor::process_block(state_, block);
                     return *this;
                 }
 
+                template<typename Integer = std::size_t>
+                inline sponge_construction &process_blocks(const block_type *blocks, std::size_t n,
+                                                           Integer = Integer()) {
+                    compressor_functor::process_blocks(state_, blocks, n);
+                    return *this;
+                }
+
+                /*!
+                 * @brief Absorbs n whole blocks of message octets, skipping the packing into words.
+                 * Only available when native_lane_order is set.
+                 */
+                template<typename Integer = std::size_t>
+                inline sponge_construction &process_octets(const std::uint8_t *data, std::size_t n,
+                                                           Integer = Integer()) {
+                    compressor_functor::process_octets(state_, data, n);
+                    return *this;
+                }
+
                 inline digest_type digest(const block_type &block = block_type(),
                                           std::size_t total_seen = std::size_t()) {
                     using namespace nil::crypto3::detail;
@@ -108,11 +171,13 @@ namespace nil {
                     }
 
                     // Apply finalizer
-                    finalizer_functor()(state_);
+                    state_type s = state_;
+                    lane_order::from_lane_order(s);
+                    finalizer_functor()(s);
 
                     // Convert digest to byte representation
                     std::array<octet_type, state_bits / octet_bits> d_full;
-                    pack_from<endian_type, word_bits, octet_bits>(state_.begin(), state_.end(), d_full.begin());
+                    pack_from<endian_type, word_bits, octet_bits>(s.begin(), s.end(), d_full.begin());
 
                     digest_type d;
                     std::copy(d_full.begin(), d_full.begin() + digest_bytes, d.begin());
@@ -126,6 +191,7 @@ namespace nil {
 
                 void reset(state_type const &s) {
                     state_ = s;
+                    lane_order::to_lane_order(state_);
                 }
 
                 void reset() {
@@ -133,8 +199,17 @@ namespace nil {
                     reset(iv());
                 }
 
-                state_type const &state() const {
-                    return state_;
+                state_type state() const {
+                    state_type s = state_;
+                    lane_order::from_lane_order(s);
+                    return s;
+                }
+
+                /*!
+                 * @brief Loads a chaining state previously obtained with state()
+                 */
+                void restore(state_type const &s) {
+                    reset(s);
                 }
 
             private:
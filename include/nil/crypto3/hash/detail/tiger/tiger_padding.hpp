@@ -25,10 +25,14 @@
 #ifndef CRYPTO3_TIGER_PADDING_HPP
 #define CRYPTO3_TIGER_PADDING_HPP
 
+#include <type_traits>
+
 #include <nil/crypto3/detail/inject.hpp>
 #include <nil/crypto3/detail/pack.hpp>
 #include <nil/crypto3/detail/octet.hpp>
 
+#include <nil/crypto3/hash/detail/octet_injector.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace hashes {
@@ -55,9 +59,35 @@ namespace nil {
 
                     typedef ::nil::crypto3::detail::injector<endian_type, word_bits, block_words, block_bits>
                         injector_type;
+                    typedef octet_injector<endian_type, block_type> octet_injector_type;
 
                 public:
                     void operator()(block_type &block, std::size_t &block_seen) {
+                        pad<int>(block, block_seen);
+                    }
+
+                protected:
+                    template<typename Dummy>
+                    typename std::enable_if<octet_injector_type::is_available && sizeof(Dummy)>::type
+                        pad(block_type &block, std::size_t &block_seen) {
+                        if (block_seen % octet_bits) {
+                            pad_bits(block, block_seen);
+                            return;
+                        }
+
+                        // Octet-aligned message: drop garbage and append the 0x01 octet
+                        octet_injector_type::truncate(block, block_seen / octet_bits);
+                        octet_injector_type::xor_octet(block, block_seen / octet_bits, 0x01);
+                        block_seen += octet_bits;
+                    }
+
+                    template<typename Dummy>
+                    typename std::enable_if<!(octet_injector_type::is_available && sizeof(Dummy))>::type
+                        pad(block_type &block, std::size_t &block_seen) {
+                        pad_bits(block, block_seen);
+                    }
+
+                    void pad_bits(block_type &block, std::size_t &block_seen) {
                         using namespace nil::crypto3::detail;
                         // Remove garbage
                         block_type block_of_zeros;
@@ -40,6 +40,8 @@
 
 #include <nil/crypto3/hash/detail/raw_stream_processor.hpp>
 #include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/hash_state.hpp>
+#include <nil/crypto3/hash/prefix_state.hpp>
 #include <nil/crypto3/hash/sha2.hpp>
 
 namespace nil {
@@ -106,9 +108,17 @@ namespace nil {
                     0x66, 0x66, 0x35, 0x62, 0x61, 0x38, 0x34, 0x61, 0x34, 0x34, 0x66, 0x32, 0x36, 0x64, 0x64, 0x64,
                     0x37, 0x65, 0x38, 0x64, 0x39, 0x66, 0x37, 0x39, 0x64, 0x35, 0x62, 0x34, 0x32, 0x64, 0x66, 0x30};
 
+                /*!
+                 * @brief State after the personalization and the URS, which start every message
+                 */
+                static inline const midstate<hash_type> &prefix_midstate() {
+                    static const midstate<hash_type> m =
+                        prefix_state<hash_type>(params::dst).absorb(urs).export_midstate();
+                    return m;
+                }
+
                 static inline void init_accumulator(internal_accumulator_type &acc) {
-                    hash<hash_type>(params::dst, acc);
-                    hash<hash_type>(urs, acc);
+                    import_midstate(acc, prefix_midstate());
                 }
 
                 template<typename InputRange>
@@ -126,15 +136,11 @@ namespace nil {
                     group_value_type point;
                     std::uint8_t i = 0;
 
+                    // Every attempt only appends its counter, so it starts from a plain copy of the message state
+                    const prefix_state<hash_type> message_state(export_midstate(acc));
+
                     while (true) {
-                        auto acc_copy = acc;
-                        hash<hash_type>(
-                            {
-                                i++,
-                            },
-                            acc_copy);
-                        typename hash_type::digest_type H =
-                            nil::crypto3::accumulators::extract::hash<hash_type>(acc_copy);
+                        typename hash_type::digest_type H = message_state(std::array<std::uint8_t, 1> {i++});
                         // TODO: generalize pack interface to accept arbitrary containers
                         std::vector<std::uint8_t> H_vec(std::cbegin(H), std::cend(H));
                         point = nil::marshalling::pack<nil::marshalling::option::little_endian>(H_vec, status);
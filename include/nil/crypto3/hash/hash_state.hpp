@@ -31,6 +31,7 @@
 #include <nil/crypto3/detail/type_traits.hpp>
 
 #include <nil/crypto3/hash/accumulators/hash.hpp>
+#include <nil/crypto3/hash/midstate.hpp>
 
 #include <nil/crypto3/detail/static_digest.hpp>
 
@@ -43,6 +44,22 @@ namespace nil {
                                                           std::size_t> {
             typedef Hash hash_type;
         };
+
+        /*!
+         * @brief Takes a snapshot of a running hash accumulator
+         */
+        template<typename Hash>
+        hashes::midstate<Hash> export_midstate(const accumulator_set<Hash> &acc) {
+            return boost::accumulators::find_accumulator<accumulators::tag::hash<Hash>>(acc).export_midstate();
+        }
+
+        /*!
+         * @brief Resumes a hash accumulator from a snapshot taken with export_midstate
+         */
+        template<typename Hash>
+        void import_midstate(accumulator_set<Hash> &acc, const hashes::midstate<Hash> &m) {
+            boost::accumulators::find_accumulator<accumulators::tag::hash<Hash>>(acc).import_midstate(m);
+        }
     }    // namespace crypto3
 }    // namespace nil
 
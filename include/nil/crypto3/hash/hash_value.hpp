@@ -26,6 +26,7 @@
 #define CRYPTO3_HASH_STREAM_POSTPROCESSOR_HPP
 
 #include <array>
+#include <iterator>
 
 #include <boost/assert.hpp>
 #include <boost/concept_check.hpp>
@@ -35,11 +36,25 @@
 
 #include <nil/crypto3/detail/pack.hpp>
 #include <nil/crypto3/hash/accumulators/hash.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace hashes {
             namespace detail {
+                /*!
+                 * @brief Hands a range over to a stream processor. Contiguous ranges go as pointers,
+                 * so whole blocks are taken straight from memory.
+                 */
+                template<typename StreamProcessor, typename SinglePassRange>
+                inline void process_range(StreamProcessor &&processor, const SinglePassRange &range) {
+                    if constexpr (is_contiguous_range<SinglePassRange>::value) {
+                        processor(std::data(range), std::data(range) + std::size(range));
+                    } else {
+                        processor(range.begin(), range.end());
+                    }
+                }
+
                 template<typename HashAccumulatorSet>
                 struct ref_hash_impl {
                     typedef HashAccumulatorSet accumulator_set_type;
@@ -115,7 +130,7 @@ namespace nil {
                             std::numeric_limits<value_type>::digits + std::numeric_limits<value_type>::is_signed>::type
                             stream_processor;
 
-                        stream_processor(this->accumulator_set)(range.begin(), range.end());
+                        process_range(stream_processor(this->accumulator_set), range);
                     }
 
                     template<typename InputIterator>
@@ -228,7 +243,7 @@ namespace nil {
                             std::numeric_limits<value_type>::digits + std::numeric_limits<value_type>::is_signed>::type
                             stream_processor;
 
-                        stream_processor(this->accumulator_set)(range.begin(), range.end());
+                        process_range(stream_processor(this->accumulator_set), range);
                     }
 
                     template<typename InputIterator>
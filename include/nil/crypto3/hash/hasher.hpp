@@ -0,0 +1,282 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_HASHER_HPP
+#define CRYPTO3_HASH_HASHER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/detail/octet.hpp>
+#include <nil/crypto3/detail/pack.hpp>
+
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/detail/octet_blocks.hpp>
+#include <nil/crypto3/hash/midstate.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief Plain initialize-update-finalize hasher over octet input. Drives the hash
+             * construction directly, without the accumulator set and its argument packs, and
+             * produces the same digests as the hash algorithms and accumulators.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             */
+            template<typename Hash>
+            class hasher {
+            public:
+                typedef Hash hash_type;
+                typedef typename hash_type::construction::type construction_type;
+                typedef typename hash_type::construction::params_type::digest_endian endian_type;
+
+                constexpr static const std::size_t word_bits = construction_type::word_bits;
+
+                constexpr static const std::size_t block_bits = construction_type::block_bits;
+                typedef typename construction_type::block_type block_type;
+
+                typedef typename construction_type::digest_type digest_type;
+
+                constexpr static const std::size_t value_bits = octet_bits;
+                typedef octet_type value_type;
+                constexpr static const std::size_t block_values = block_bits / value_bits;
+                typedef std::array<value_type, block_values> cache_type;
+
+            protected:
+                BOOST_STATIC_ASSERT(block_bits % value_bits == 0);
+
+                constexpr static const std::size_t batch_blocks = 8;
+                typedef std::array<block_type, batch_blocks> batch_type;
+
+                // Constructions absorbing in lane order take contiguous octets without packing
+                typedef std::integral_constant<bool, detail::absorbs_octets<construction_type>::value>
+                    octet_absorb_type;
+
+            public:
+                hasher() : cache(), cache_seen(0), total_seen(0) {
+                }
+
+                template<typename InputIterator>
+                inline hasher &update(InputIterator first, InputIterator last) {
+                    typedef typename std::iterator_traits<InputIterator>::value_type input_value_type;
+                    BOOST_STATIC_ASSERT(std::numeric_limits<input_value_type>::digits +
+                                            std::numeric_limits<input_value_type>::is_signed ==
+                                        value_bits);
+                    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+
+                    update(first, last, category());
+                    return *this;
+                }
+
+                template<typename SinglePassRange>
+                inline hasher &update(const SinglePassRange &range) {
+                    // Contiguous ranges take the pointer path, so whole blocks skip packing where they can
+                    if constexpr (detail::is_contiguous_range<SinglePassRange>::value) {
+                        return update(std::data(range), std::data(range) + std::size(range));
+                    } else {
+                        return update(std::cbegin(range), std::cend(range));
+                    }
+                }
+
+                inline hasher &update(const value_type *data, std::size_t n) {
+                    update_n(data, n);
+                    return *this;
+                }
+
+                /*!
+                 * @brief Pads the data seen so far, returns its digest and resets the hasher
+                 * for the next message.
+                 */
+                inline digest_type finalize() {
+                    // A compressed last block, as left by compress_cache(), can't be handed to digest()
+                    BOOST_ASSERT(cache_seen || !total_seen);
+
+                    block_type block;
+                    const std::size_t seen = last_block(block);
+
+                    digest_type d = construction.digest(block, seen);
+                    reset();
+                    return d;
+                }
+
+                inline void reset() {
+                    construction.reset();
+                    cache_seen = 0;
+                    total_seen = 0;
+                }
+
+                inline midstate<hash_type> export_midstate() const {
+                    midstate<hash_type> m;
+                    m.state = construction.state();
+                    m.total_seen = last_block(m.block);
+                    m.block_compressed = !cache_seen && total_seen;
+                    return m;
+                }
+
+                /*!
+                 * @brief Resumes hashing from a snapshot, which must cover a whole amount of octets.
+                 */
+                inline void import_midstate(const midstate<hash_type> &m) {
+                    BOOST_ASSERT(m.total_seen % value_bits == 0);
+
+                    construction.restore(m.state);
+                    ::nil::crypto3::detail::pack_from<endian_type, word_bits, value_bits>(
+                        m.block.begin(), m.block.end(), cache.begin());
+                    cache_seen = (m.total_seen % block_bits) / value_bits;
+                    if (!cache_seen && m.total_seen && !m.block_compressed) {
+                        // The last full block is still waiting in the cache
+                        cache_seen = block_values;
+                    }
+                    total_seen = m.total_seen - cache_seen * value_bits;
+                }
+
+            protected:
+                template<typename InputIterator>
+                inline void update(InputIterator first, InputIterator last, std::random_access_iterator_tag) {
+                    update_n(first, std::distance(first, last));
+                }
+
+                template<typename InputIterator, typename Category>
+                inline void update(InputIterator first, InputIterator last, Category) {
+                    while (first != last) {
+                        if (cache_seen == block_values) {
+                            process_cache();
+                        }
+                        cache[cache_seen++] = static_cast<value_type>(*first++);
+                    }
+                }
+
+                template<typename InputIterator>
+                inline void update_n(InputIterator p, std::size_t n) {
+                    // Complete a partially filled cache
+                    if (cache_seen != block_values) {
+                        std::size_t values_amount = std::min(n, block_values - cache_seen);
+                        std::copy_n(p, values_amount, cache.begin() + cache_seen);
+                        std::advance(p, values_amount);
+                        cache_seen += values_amount;
+                        n -= values_amount;
+                    }
+
+                    if (!n) {
+                        return;
+                    }
+
+                    // A full cache is only compressed once more data shows up, since the construction
+                    // expects the last full block to be handed over to digest()
+                    process_cache();
+
+                    // Compress whole blocks straight from the input, holding back the last one
+                    if (n > block_values) {
+                        std::size_t blocks_amount = (n - 1) / block_values;
+                        p = process_blocks(p, blocks_amount, octet_absorb_type());
+                        n -= blocks_amount * block_values;
+                    }
+
+                    std::copy_n(p, n, cache.begin());
+                    cache_seen = n;
+                }
+
+                // Packs the blocks into words, batch_blocks at a time
+                template<typename InputIterator>
+                inline InputIterator process_blocks(InputIterator p, std::size_t blocks_amount, std::false_type) {
+                    batch_type blocks;
+                    while (blocks_amount) {
+                        std::size_t batch_amount = std::min(blocks_amount, batch_blocks);
+                        for (std::size_t i = 0; i != batch_amount; ++i) {
+                            InputIterator block_end = p;
+                            std::advance(block_end, block_values);
+                            ::nil::crypto3::detail::pack_to<endian_type, value_bits, word_bits>(p, block_end,
+                                                                                               blocks[i].begin());
+                            p = block_end;
+                        }
+                        construction.process_blocks(blocks.data(), batch_amount, total_seen + block_bits);
+                        total_seen += batch_amount * block_bits;
+                        blocks_amount -= batch_amount;
+                    }
+                    return p;
+                }
+
+                template<typename InputIterator>
+                inline InputIterator process_blocks(InputIterator p, std::size_t blocks_amount, std::true_type) {
+                    return process_blocks(p, blocks_amount, std::false_type());
+                }
+
+                // Contiguous octets go to the construction as they are
+                template<typename ValueType>
+                inline ValueType *process_blocks(ValueType *p, std::size_t blocks_amount, std::true_type) {
+                    construction.process_octets(reinterpret_cast<const std::uint8_t *>(p), blocks_amount,
+                                                total_seen + block_bits);
+                    total_seen += blocks_amount * block_bits;
+                    return p + blocks_amount * block_values;
+                }
+
+                /*!
+                 * @brief Packs the cached values, zero-padded, into the block the construction
+                 * finishes with and returns the amount of bits seen so far, that block included.
+                 */
+                inline std::size_t last_block(block_type &block) const {
+                    cache_type padded_cache = cache;
+                    std::fill(padded_cache.begin() + cache_seen, padded_cache.end(), 0);
+                    ::nil::crypto3::detail::pack_to<endian_type, value_bits, word_bits>(
+                        padded_cache.begin(), padded_cache.end(), block.begin());
+                    return total_seen + cache_seen * value_bits;
+                }
+
+                /*!
+                 * @brief Compresses a full cache right away instead of keeping it for digest(), so
+                 * copies of the hasher don't compress it again. Only valid when more data follows.
+                 */
+                inline void compress_cache() {
+                    if (cache_seen == block_values) {
+                        process_cache();
+                    }
+                }
+
+                inline void process_cache() {
+                    process_blocks(cache.data(), 1, octet_absorb_type());
+                    cache_seen = 0;
+                }
+
+                construction_type construction;
+
+                cache_type cache;
+                std::size_t cache_seen;
+                std::size_t total_seen;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_HASHER_HPP
@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_HKDF_HPP
+#define CRYPTO3_HASH_HKDF_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/hmac.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief HKDF (RFC 5869) with HMAC over Hash. The pseudorandom key is extracted at
+             * construction and keyed into HMAC once; expand() then derives any number of outputs
+             * from the precomputed midstates.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             */
+            template<typename Hash>
+            class hkdf {
+            public:
+                typedef Hash hash_type;
+                typedef hmac<hash_type> mac_type;
+                typedef typename mac_type::digest_type digest_type;
+                typedef typename mac_type::value_type value_type;
+
+                constexpr static const std::size_t digest_octets = hash_type::digest_bits / octet_bits;
+                constexpr static const std::size_t max_output_octets = 255 * digest_octets;
+
+                /*!
+                 * @brief HKDF-Extract of the input keying material. An empty salt stands for
+                 * digest_octets zero octets, which HMAC pads to the same key block.
+                 */
+                hkdf(const value_type *salt, std::size_t salt_size, const value_type *key_material,
+                     std::size_t key_material_size) :
+                    hkdf(extract(salt, salt_size, key_material, key_material_size)) {
+                }
+
+                template<typename SaltRange, typename KeyMaterialRange>
+                hkdf(const SaltRange &salt, const KeyMaterialRange &key_material) :
+                    hkdf(detail::octets(salt), std::size(salt), detail::octets(key_material),
+                         std::size(key_material)) {
+                }
+
+                /*!
+                 * @brief Skips the extraction step, for an already uniformly random key
+                 */
+                explicit hkdf(const digest_type &prk) : prk_(prk), mac_(prk) {
+                }
+
+                inline const digest_type &prk() const {
+                    return prk_;
+                }
+
+                /*!
+                 * @brief HKDF-Expand: writes n octets of output keying material bound to info
+                 */
+                inline void expand(const value_type *info, std::size_t info_size, value_type *out,
+                                   std::size_t n) const {
+                    BOOST_ASSERT_MSG(n <= max_output_octets, "HKDF output is too long");
+
+                    mac_type mac = mac_;
+                    digest_type t;
+                    for (std::size_t i = 1, done = 0; done != n; ++i) {
+                        if (i > 1) {
+                            mac.update(t.data(), t.size());
+                        }
+                        const value_type counter = static_cast<value_type>(i);
+                        t = mac.update(info, info_size).update(&counter, 1).finalize();
+
+                        const std::size_t amount = std::min(n - done, digest_octets);
+                        std::copy(t.begin(), t.begin() + amount, out + done);
+                        done += amount;
+                    }
+                }
+
+                template<typename InfoRange>
+                inline std::vector<value_type> expand(const InfoRange &info, std::size_t n) const {
+                    std::vector<value_type> out(n);
+                    expand(detail::octets(info), std::size(info), out.data(), n);
+                    return out;
+                }
+
+            protected:
+                static inline digest_type extract(const value_type *salt, std::size_t salt_size,
+                                                  const value_type *key_material, std::size_t key_material_size) {
+                    mac_type mac(salt, salt_size);
+                    return mac.update(key_material, key_material_size).finalize();
+                }
+
+                digest_type prk_;
+                mac_type mac_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_HKDF_HPP
@@ -0,0 +1,212 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_HMAC_HPP
+#define CRYPTO3_HASH_HMAC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Hasher holding a padded HMAC key. The key fills exactly one block, which
+                 * the plain hasher keeps back for digest(); compress_key() hands it over to the
+                 * construction right away, for use when a non-empty message follows.
+                 */
+                template<typename Hash>
+                class hmac_key_hasher : public hasher<Hash> {
+                    typedef hasher<Hash> base_type;
+
+                public:
+                    inline void compress_key() {
+                        BOOST_ASSERT(this->cache_seen == base_type::block_values && !this->total_seen);
+                        this->process_cache();
+                    }
+                };
+            }    // namespace detail
+
+            /*!
+             * @brief HMAC (RFC 2104) over any of the block hashes: Merkle-Damgard, HAIFA and sponge
+             * constructions alike. The padded key blocks K ^ ipad and K ^ opad are compressed once,
+             * at construction, and every message starts from copies of the resulting midstates, so
+             * a short message costs two compressions instead of four.
+             *
+             * The block size of a sponge hash is its rate, as in the HMAC-SHA3 of NIST FIPS 202.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             */
+            template<typename Hash>
+            class hmac {
+            public:
+                typedef Hash hash_type;
+                typedef hasher<hash_type> hasher_type;
+                typedef typename hasher_type::digest_type digest_type;
+                typedef typename hasher_type::value_type value_type;
+                typedef typename hasher_type::construction_type::state_type state_type;
+
+                constexpr static const std::size_t block_octets = hasher_type::block_values;
+
+                constexpr static const value_type inner_pad = 0x36;
+                constexpr static const value_type outer_pad = 0x5c;
+
+            protected:
+                typedef detail::hmac_key_hasher<hash_type> key_hasher_type;
+                typedef std::array<value_type, block_octets> key_block_type;
+
+                BOOST_STATIC_ASSERT(hash_type::digest_bits / octet_bits <= block_octets);
+
+            public:
+                hmac(const value_type *key, std::size_t key_size) {
+                    key_block_type k = {};
+                    if (key_size > block_octets) {
+                        // Long keys are hashed first
+                        hasher_type h;
+                        digest_type d = h.update(key, key_size).finalize();
+                        std::copy(d.begin(), d.end(), k.begin());
+                    } else {
+                        std::copy(key, key + key_size, k.begin());
+                    }
+
+                    key_hasher_type inner = keyed(k, inner_pad);
+                    empty_inner_ = inner;
+                    inner.compress_key();
+                    inner_ = inner;
+
+                    key_hasher_type outer = keyed(k, outer_pad);
+                    outer.compress_key();
+                    outer_ = outer;
+
+                    reset();
+                }
+
+                template<typename KeyRange>
+                explicit hmac(const KeyRange &key) : hmac(detail::octets(key), std::size(key)) {
+                }
+
+                template<typename InputIterator>
+                inline hmac &update(InputIterator first, InputIterator last) {
+                    if (first != last) {
+                        message_.update(first, last);
+                        empty_ = false;
+                    }
+                    return *this;
+                }
+
+                template<typename SinglePassRange>
+                inline hmac &update(const SinglePassRange &range) {
+                    return update(std::cbegin(range), std::cend(range));
+                }
+
+                inline hmac &update(const value_type *data, std::size_t n) {
+                    if (n) {
+                        message_.update(data, n);
+                        empty_ = false;
+                    }
+                    return *this;
+                }
+
+                /*!
+                 * @brief Returns the MAC of the message seen so far and goes back to the keyed state
+                 */
+                inline digest_type finalize() {
+                    digest_type d = empty_ ? mac(empty_inner_) : mac(message_);
+                    reset();
+                    return d;
+                }
+
+                /*!
+                 * @return MAC of a whole message, leaving the running one untouched
+                 */
+                template<typename SinglePassRange>
+                inline digest_type operator()(const SinglePassRange &message) const {
+                    if (std::cbegin(message) == std::cend(message)) {
+                        return mac(empty_inner_);
+                    }
+                    hasher_type inner = inner_;
+                    inner.update(message);
+                    return mac(inner);
+                }
+
+                /*!
+                 * @brief Chaining states right after the K ^ ipad and K ^ opad blocks, for callers
+                 * driving the compression function themselves
+                 */
+                inline state_type inner_state() const {
+                    return inner_.export_midstate().state;
+                }
+
+                inline state_type outer_state() const {
+                    return outer_.export_midstate().state;
+                }
+
+                inline void reset() {
+                    message_ = inner_;
+                    empty_ = true;
+                }
+
+            protected:
+                static inline key_hasher_type keyed(const key_block_type &key, value_type pad) {
+                    key_block_type block;
+                    std::transform(key.begin(), key.end(), block.begin(),
+                                   [pad](value_type k) { return static_cast<value_type>(k ^ pad); });
+
+                    key_hasher_type h;
+                    h.update(block.data(), block.size());
+                    return h;
+                }
+
+                // Completes the inner hash and runs the outer one over its digest
+                inline digest_type mac(hasher_type inner) const {
+                    digest_type inner_digest = inner.finalize();
+                    hasher_type outer = outer_;
+                    return outer.update(inner_digest.data(), inner_digest.size()).finalize();
+                }
+
+                // The inner hash with the key block held back, as an empty message needs it
+                hasher_type empty_inner_;
+                hasher_type inner_;
+                hasher_type outer_;
+
+                hasher_type message_;
+                bool empty_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_HMAC_HPP
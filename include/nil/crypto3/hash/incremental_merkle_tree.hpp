@@ -0,0 +1,172 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_INCREMENTAL_MERKLE_TREE_HPP
+#define CRYPTO3_HASH_INCREMENTAL_MERKLE_TREE_HPP
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/detail/merkle_node_hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief Append-only binary Merkle tree of fixed depth, as used for note commitments.
+             * Only the right edge is kept: for every level, the last left child still waiting for
+             * its sibling. Positions not appended yet hold the empty leaf, and the roots of the
+             * empty subtrees of every height are computed once, at construction.
+             *
+             * Appending a leaf hashes Depth parents, one per level, and refreshes the root, which
+             * root() then returns as it is. Nodes are hashed as in merkle_tree<Hash, 2>, so a full
+             * tree has the root of a merkle_tree over the same leaves.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             * @tparam Depth Levels above the leaves, the tree holds up to 2^Depth of them
+             */
+            template<typename Hash, std::size_t Depth = 32>
+            class incremental_merkle_tree {
+            public:
+                typedef Hash hash_type;
+                typedef detail::merkle_node_hasher<Hash> node_hasher_type;
+                typedef typename node_hasher_type::digest_type digest_type;
+                typedef digest_type value_type;
+
+                constexpr static const std::size_t depth = Depth;
+                BOOST_STATIC_ASSERT(Depth > 0 && Depth < 64);
+
+                constexpr static const std::uint64_t capacity = std::uint64_t(1) << Depth;
+
+                /*!
+                 * @param empty_leaf Digest standing for the leaves not appended yet
+                 */
+                explicit incremental_merkle_tree(const digest_type &empty_leaf = digest_type()) : size_(0) {
+                    empty_[0] = empty_leaf;
+                    for (std::size_t l = 0; l != Depth; ++l) {
+                        std::array<digest_type, 2> children = {empty_[l], empty_[l]};
+                        empty_[l + 1] = node_hasher_type::hash_node(children.data(), children.size());
+                    }
+                    root_ = empty_[Depth];
+                }
+
+                /*!
+                 * @brief Hashes the leaf and appends its digest
+                 */
+                template<typename Leaf>
+                inline incremental_merkle_tree &append(const Leaf &leaf) {
+                    digest_type d;
+                    node_hasher_type::hash_leaves(&leaf, 1, &d);
+                    return append_digest(d);
+                }
+
+                /*!
+                 * @brief Appends a range of leaves, all hashed in one batch
+                 */
+                template<typename LeafRange>
+                inline incremental_merkle_tree &extend(const LeafRange &leaves) {
+                    std::vector<digest_type> digests(std::size(leaves));
+                    node_hasher_type::hash_leaves(std::begin(leaves), digests.size(), digests.data());
+                    for (const digest_type &d : digests) {
+                        append_digest(d);
+                    }
+                    return *this;
+                }
+
+                /*!
+                 * @brief Appends a leaf which is a digest already
+                 */
+                inline incremental_merkle_tree &append_digest(const digest_type &leaf) {
+                    BOOST_ASSERT_MSG(size_ < capacity, "Incremental Merkle tree is full");
+
+                    digest_type node = leaf;
+                    std::uint64_t index = size_;
+                    std::array<digest_type, 2> children;
+                    for (std::size_t l = 0; l != Depth; ++l, index >>= 1) {
+                        if (index & 1) {
+                            children = {frontier_[l], node};
+                        } else {
+                            // Left children are kept until their sibling comes
+                            frontier_[l] = node;
+                            children = {node, empty_[l]};
+                        }
+                        node = node_hasher_type::hash_node(children.data(), children.size());
+                    }
+
+                    root_ = node;
+                    ++size_;
+                    return *this;
+                }
+
+                inline const digest_type &root() const {
+                    return root_;
+                }
+
+                /*!
+                 * @brief Number of leaves appended so far
+                 */
+                inline std::uint64_t size() const {
+                    return size_;
+                }
+
+                inline bool full() const {
+                    return size_ == capacity;
+                }
+
+                /*!
+                 * @brief Root of an empty subtree with 2^height leaves
+                 */
+                inline const digest_type &empty_root(std::size_t height) const {
+                    BOOST_ASSERT(height <= Depth);
+                    return empty_[height];
+                }
+
+                /*!
+                 * @brief Left child waiting for its sibling at level l. Only meaningful for the
+                 * levels where the next leaf index has a one bit.
+                 */
+                inline const digest_type &frontier(std::size_t l) const {
+                    BOOST_ASSERT(l < Depth);
+                    return frontier_[l];
+                }
+
+            protected:
+                std::array<digest_type, Depth + 1> empty_;
+                std::array<digest_type, Depth> frontier_;
+                digest_type root_;
+                std::uint64_t size_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_INCREMENTAL_MERKLE_TREE_HPP
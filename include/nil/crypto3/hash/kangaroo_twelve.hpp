@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_KANGAROO_TWELVE_HPP
+#define CRYPTO3_HASH_KANGAROO_TWELVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/shake.hpp>
+#include <nil/crypto3/hash/turbo_shake.hpp>
+#include <nil/crypto3/hash/detail/cshake/cshake_functions.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/detail/leaf_batch_hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief KangarooTwelve, KT128 and KT256 (RFC 9861): a tree hash over TurboSHAKE. Messages
+             * of up to one 8 KiB chunk are hashed directly; longer ones have every chunk after the
+             * first reduced to a chaining value, and the first chunk and the chaining values are then
+             * hashed together. Chunks are absorbed several at a time by shake_xof_batch, one per
+             * vector lane, and spread over threads when more than one is requested.
+             *
+             * The output has arbitrary length: finalize() writes it and resets, squeeze() hands it
+             * out in as many calls as needed.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             */
+            template<std::size_t SecurityBits>
+            class kangaroo_twelve {
+                typedef detail::cshake_functions functions_type;
+                typedef functions_type::encoded_integer_type encoded_integer_type;
+
+            public:
+                typedef turbo_shake_xof<SecurityBits> xof_type;
+
+                constexpr static const std::size_t chunk_octets = 8192;
+                constexpr static const std::size_t chaining_value_octets = 2 * SecurityBits / octet_bits;
+
+                constexpr static const std::uint8_t single_node_domain = 0x07;
+                constexpr static const std::uint8_t final_node_domain = 0x06;
+                constexpr static const std::uint8_t leaf_domain = 0x0B;
+
+                typedef shake_xof_batch<SecurityBits, xof_type::rounds, leaf_domain> leaf_batch_type;
+
+            protected:
+                typedef detail::leaf_batch_hasher<leaf_batch_type, chaining_value_octets> leaf_hasher_type;
+
+            public:
+                kangaroo_twelve(const std::uint8_t *customization, std::size_t customization_size,
+                                std::size_t threads = 1) :
+                    customization_(customization, customization + customization_size),
+                    threads_(std::max<std::size_t>(threads, 1)), cache_(chunk_octets) {
+                    reset();
+                }
+
+                kangaroo_twelve() : kangaroo_twelve(static_cast<const std::uint8_t *>(nullptr), 0) {
+                }
+
+                template<typename CustomizationRange>
+                explicit kangaroo_twelve(const CustomizationRange &customization, std::size_t threads = 1) :
+                    kangaroo_twelve(detail::octets(customization), std::size(customization), threads) {
+                }
+
+                inline kangaroo_twelve &update(const std::uint8_t *data, std::size_t n) {
+                    BOOST_ASSERT_MSG(!squeezing_, "KangarooTwelve input can not be extended once squeezing started");
+
+                    absorb(data, n);
+                    return *this;
+                }
+
+                template<typename ContiguousRange>
+                inline kangaroo_twelve &update(const ContiguousRange &range) {
+                    return update(detail::octets(range), std::size(range));
+                }
+
+                /*!
+                 * @brief Writes the n-octet hash of the message seen so far and resets
+                 */
+                inline void finalize(std::uint8_t *out, std::size_t n) {
+                    squeeze(out, n);
+                    reset();
+                }
+
+                inline std::vector<std::uint8_t> finalize(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    finalize(out.data(), n);
+                    return out;
+                }
+
+                /*!
+                 * @brief Writes the next n octets of output. The first call ends the message.
+                 */
+                inline void squeeze(std::uint8_t *out, std::size_t n) {
+                    if (!squeezing_) {
+                        finish();
+                        squeezing_ = true;
+                    }
+                    final_.squeeze(out, n);
+                }
+
+                inline std::vector<std::uint8_t> squeeze(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    squeeze(out.data(), n);
+                    return out;
+                }
+
+                inline void reset() {
+                    final_ = xof_type(final_node_domain);
+                    cache_seen_ = 0;
+                    chunks_ = 0;
+                    tree_ = false;
+                    squeezing_ = false;
+                }
+
+            protected:
+                /*!
+                 * @brief length_encode of RFC 9861: the big-endian octets of x without leading zeros,
+                 * followed by their count. Zero encodes as a single zero octet.
+                 */
+                static inline encoded_integer_type length_encode(std::uint64_t x) {
+                    encoded_integer_type e = functions_type::right_encode(x);
+                    if (!x) {
+                        e.octets[0] = 0;
+                        e.size = 1;
+                    }
+                    return e;
+                }
+
+                inline void absorb(const std::uint8_t *data, std::size_t n) {
+                    if (!tree_) {
+                        // The first chunk is only known to start a tree once more input follows it
+                        std::size_t amount = std::min(n, chunk_octets - cache_seen_);
+                        std::memcpy(cache_.data() + cache_seen_, data, amount);
+                        cache_seen_ += amount;
+                        data += amount;
+                        n -= amount;
+
+                        if (!n) {
+                            return;
+                        }
+
+                        static const std::array<std::uint8_t, 8> chunk_separator = {0x03, 0, 0, 0, 0, 0, 0, 0};
+                        final_.update(cache_.data(), chunk_octets);
+                        final_.update(chunk_separator.data(), chunk_separator.size());
+                        cache_seen_ = 0;
+                        tree_ = true;
+                    }
+
+                    if (cache_seen_) {
+                        std::size_t amount = std::min(n, chunk_octets - cache_seen_);
+                        std::memcpy(cache_.data() + cache_seen_, data, amount);
+                        cache_seen_ += amount;
+                        data += amount;
+                        n -= amount;
+
+                        if (cache_seen_ != chunk_octets) {
+                            return;
+                        }
+                        process_chunks(cache_.data(), 1);
+                        cache_seen_ = 0;
+                    }
+
+                    std::size_t chunks = n / chunk_octets;
+                    process_chunks(data, chunks);
+                    data += chunks * chunk_octets;
+                    n -= chunks * chunk_octets;
+
+                    std::memcpy(cache_.data(), data, n);
+                    cache_seen_ = n;
+                }
+
+                // Hashes count whole chunks starting at data and absorbs their chaining values in order
+                inline void process_chunks(const std::uint8_t *data, std::size_t count) {
+                    leaf_hasher_type::process(data, count, chunk_octets, threads_,
+                                              [this](const std::uint8_t *values, std::size_t amount) {
+                                                  final_.update(values, amount * chaining_value_octets);
+                                                  chunks_ += amount;
+                                              });
+                }
+
+                // Appends the customization string and closes the single node or the tree
+                inline void finish() {
+                    absorb(customization_.data(), customization_.size());
+                    encoded_integer_type c = length_encode(customization_.size());
+                    absorb(c.data(), c.size);
+
+                    if (!tree_) {
+                        final_ = xof_type(single_node_domain);
+                        final_.update(cache_.data(), cache_seen_);
+                        return;
+                    }
+
+                    if (cache_seen_) {
+                        std::array<std::uint8_t, chaining_value_octets> value;
+                        xof_type leaf(leaf_domain);
+                        leaf.update(cache_.data(), cache_seen_);
+                        leaf.squeeze(value.data(), value.size());
+                        final_.update(value.data(), value.size());
+                        ++chunks_;
+                        cache_seen_ = 0;
+                    }
+
+                    static const std::array<std::uint8_t, 2> tree_terminator = {0xFF, 0xFF};
+                    encoded_integer_type n = length_encode(chunks_);
+                    final_.update(n.data(), n.size);
+                    final_.update(tree_terminator.data(), tree_terminator.size());
+                }
+
+                xof_type final_;
+                std::vector<std::uint8_t> customization_;
+                std::size_t threads_;
+
+                std::vector<std::uint8_t> cache_;
+                std::size_t cache_seen_;
+                std::uint64_t chunks_;
+                bool tree_;
+                bool squeezing_;
+            };
+
+            typedef kangaroo_twelve<128> kt128;
+            typedef kangaroo_twelve<256> kt256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_KANGAROO_TWELVE_HPP
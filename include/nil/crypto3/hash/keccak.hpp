@@ -26,6 +26,9 @@
 #ifndef CRYPTO3_HASH_KECCAK_HPP
 #define CRYPTO3_HASH_KECCAK_HPP
 
+#include <cstdint>
+#include <cstring>
+
 #include <nil/crypto3/hash/detail/sponge_construction.hpp>
 #include <nil/crypto3/hash/detail/block_stream_processor.hpp>
 
@@ -40,10 +43,26 @@
 namespace nil {
     namespace crypto3 {
         namespace hashes {
-            template<std::size_t DigestBits = 512>
+            /*!
+             * @brief Name of the Keccak-f[1600] kernel in use: "avx2", "x86_64", "armv8" or "generic".
+             * On x86_64 it is selected at run time from cpuid.
+             * @ingroup hashes
+             */
+            inline const char *keccak_1600_backend() {
+                return detail::keccak_1600_functions<512>::backend();
+            }
+
+            /*!
+             * @brief Absorbs blocks into a Keccak-p[1600, Rounds] state. Keccak and SHA-3 run the
+             * full 24 rounds, TurboSHAKE and KangarooTwelve 12.
+             *
+             * @tparam DigestBits Digest size, the capacity being twice as large
+             * @tparam Rounds Rounds of the permutation
+             */
+            template<std::size_t DigestBits = 512, std::size_t Rounds = 24>
             class keccak_1600_compressor {
             protected:
-                typedef detail::keccak_1600_functions<DigestBits> policy_type;
+                typedef detail::keccak_1600_functions<DigestBits, Rounds> policy_type;
                 typedef typename policy_type::impl_type impl_type;
                 typedef typename policy_type::const_impl_type const_impl_type;
 
@@ -59,21 +78,63 @@ namespace nil {
                 constexpr static const std::size_t block_words = policy_type::block_words;
                 typedef typename policy_type::block_type block_type;
 
-                static constexpr void process_block(state_type &state, const block_type &block) {
-                    for (std::size_t i = 0; i != block_words; ++i)
-                        state[i] ^= block[i];
+                /*!
+                 * @brief The state is kept in the permutation's own lane order while absorbing, so
+                 * each block is reversed into lane order once instead of reversing the whole state
+                 * around every permutation. The construction converts it at its boundaries.
+                 */
+                constexpr static const bool native_lane_order = true;
 
+                static constexpr void to_lane_order(state_type &state) {
                     for (std::size_t i = 0; i != state_words; ++i)
                         boost::endian::endian_reverse_inplace(state[i]);
+                }
+
+                static constexpr void from_lane_order(state_type &state) {
+                    to_lane_order(state);
+                }
+
+                /*!
+                 * @brief Keccak-p[1600, Rounds] on a state in lane order, for squeezing output beyond one block
+                 */
+                static void permute(state_type &state) {
+                    impl_type::permute(state);
+                }
+
+                static constexpr void process_block(state_type &state, const block_type &block) {
+                    for (std::size_t i = 0; i != block_words; ++i)
+                        state[i] ^= boost::endian::endian_reverse(block[i]);
 
                     if (!CRYPTO3_IS_CONST_EVALUATED(state)) {
                         impl_type::permute(state);
                     } else {
                         const_impl_type::permute(state);
                     }
+                }
 
-                    for (std::size_t i = 0; i != state_words; ++i)
-                        boost::endian::endian_reverse_inplace(state[i]);
+                static void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                    for (; n; --n, ++blocks) {
+                        for (std::size_t i = 0; i != block_words; ++i)
+                            state[i] ^= boost::endian::endian_reverse((*blocks)[i]);
+
+                        impl_type::permute(state);
+                    }
+                }
+
+                /*!
+                 * @brief Absorbs n whole blocks straight from message octets. Lanes are little-endian
+                 * octet strings, so on little-endian hosts the loads need no conversion at all.
+                 */
+                static void process_octets(state_type &state, const std::uint8_t *data, std::size_t n) {
+                    for (; n; --n) {
+                        for (std::size_t i = 0; i != block_words; ++i, data += word_bits / octet_bits) {
+                            word_type w;
+                            std::memcpy(&w, data, sizeof(w));
+                            state[i] ^= boost::endian::little_to_native(w);
+                        }
+
+                        impl_type::permute(state);
+                    }
                 }
             };
 
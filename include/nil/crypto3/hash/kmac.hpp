@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_KMAC_HPP
+#define CRYPTO3_HASH_KMAC_HPP
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <nil/crypto3/hash/cshake.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief KMAC128/KMAC256 and their XOF variants (NIST SP 800-185). The key is absorbed
+             * once, padded to whole blocks, at construction; reset() goes back to the keyed state,
+             * so every further message costs a single pass over its own blocks.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             */
+            template<std::size_t SecurityBits>
+            class kmac {
+                typedef detail::cshake_functions functions_type;
+
+            public:
+                typedef cshake_xof<SecurityBits> xof_type;
+
+                constexpr static const std::size_t block_octets = xof_type::block_octets;
+
+                kmac(const std::uint8_t *key, std::size_t key_size, const std::uint8_t *customization,
+                     std::size_t customization_size) :
+                    keyed_(function_name().data(), function_name().size(), customization, customization_size),
+                    xof_started_(false) {
+                    std::vector<std::uint8_t> prefix = functions_type::bytepad({{key, key_size}}, block_octets);
+                    keyed_.update(prefix.data(), prefix.size());
+                    xof_ = keyed_;
+                }
+
+                template<typename KeyRange>
+                explicit kmac(const KeyRange &key) :
+                    kmac(detail::octets(key), std::size(key), nullptr, 0) {
+                }
+
+                template<typename KeyRange, typename CustomizationRange>
+                kmac(const KeyRange &key, const CustomizationRange &customization) :
+                    kmac(detail::octets(key), std::size(key), detail::octets(customization),
+                         std::size(customization)) {
+                }
+
+                inline kmac &update(const std::uint8_t *data, std::size_t n) {
+                    xof_.update(data, n);
+                    return *this;
+                }
+
+                template<typename InputIterator>
+                inline kmac &update(InputIterator first, InputIterator last) {
+                    xof_.update(first, last);
+                    return *this;
+                }
+
+                template<typename SinglePassRange>
+                inline kmac &update(const SinglePassRange &range) {
+                    xof_.update(range);
+                    return *this;
+                }
+
+                /*!
+                 * @brief Writes the n-octet KMAC of the message seen so far and resets to the keyed state
+                 */
+                inline void finalize(std::uint8_t *out, std::size_t n) {
+                    functions_type::encoded_integer_type length =
+                        functions_type::right_encode(static_cast<std::uint64_t>(n) * octet_bits);
+                    xof_.update(length.data(), length.size);
+                    xof_.squeeze(out, n);
+                    reset();
+                }
+
+                inline std::vector<std::uint8_t> finalize(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    finalize(out.data(), n);
+                    return out;
+                }
+
+                /*!
+                 * @brief KMACXOF: writes the next n octets of output of arbitrary length
+                 */
+                inline void squeeze(std::uint8_t *out, std::size_t n) {
+                    if (!xof_started_) {
+                        functions_type::encoded_integer_type length = functions_type::right_encode(0);
+                        xof_.update(length.data(), length.size);
+                        xof_started_ = true;
+                    }
+                    xof_.squeeze(out, n);
+                }
+
+                inline void reset() {
+                    xof_ = keyed_;
+                    xof_started_ = false;
+                }
+
+            protected:
+                static inline const std::array<std::uint8_t, 4> &function_name() {
+                    static const std::array<std::uint8_t, 4> name = {'K', 'M', 'A', 'C'};
+                    return name;
+                }
+
+                xof_type keyed_;
+                xof_type xof_;
+                bool xof_started_;
+            };
+
+            typedef kmac<128> kmac128;
+            typedef kmac<256> kmac256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_KMAC_HPP
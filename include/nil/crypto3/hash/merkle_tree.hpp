@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_MERKLE_TREE_HPP
+#define CRYPTO3_HASH_MERKLE_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/detail/merkle_node_hasher.hpp>
+#include <nil/crypto3/hash/detail/parallel_for.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief Authentication path of one leaf of a merkle_tree: for every level from the
+             * leaves up, the other children of the parent the path goes through, in order.
+             *
+             * @tparam Hash
+             * @tparam Arity
+             */
+            template<typename Hash, std::size_t Arity = 2>
+            class merkle_proof {
+            public:
+                typedef detail::merkle_node_hasher<Hash> node_hasher_type;
+                typedef typename node_hasher_type::digest_type digest_type;
+                typedef std::vector<digest_type> siblings_type;
+
+                constexpr static const std::size_t arity = Arity;
+
+                merkle_proof() : leaf_index_(0) {
+                }
+
+                merkle_proof(std::size_t leaf_index, std::vector<siblings_type> path) :
+                    leaf_index_(leaf_index), path_(std::move(path)) {
+                }
+
+                inline std::size_t leaf_index() const {
+                    return leaf_index_;
+                }
+
+                inline const std::vector<siblings_type> &path() const {
+                    return path_;
+                }
+
+                /*!
+                 * @brief Recomputes the root from the digest of the leaf
+                 */
+                inline digest_type root(const digest_type &leaf) const {
+                    BOOST_ASSERT(well_formed());
+
+                    digest_type node = leaf;
+                    std::size_t index = leaf_index_;
+                    siblings_type group;
+                    for (const siblings_type &siblings : path_) {
+                        std::size_t position = index % Arity;
+                        group.assign(siblings.begin(), siblings.begin() + position);
+                        group.push_back(node);
+                        group.insert(group.end(), siblings.begin() + position, siblings.end());
+
+                        node = node_hasher_type::hash_node(group.data(), group.size());
+                        index /= Arity;
+                    }
+                    return node;
+                }
+
+                /*!
+                 * @brief Checks the proof against the root of a tree with depth levels above its
+                 * leaves, i.e. merkle_tree::levels() - 1. A path of any other length is rejected,
+                 * so an inner node can not be presented as a leaf.
+                 */
+                inline bool validate(const digest_type &leaf, const digest_type &expected_root,
+                                     std::size_t depth) const {
+                    return path_.size() == depth && well_formed() && root(leaf) == expected_root;
+                }
+
+            protected:
+                inline bool well_formed() const {
+                    std::size_t index = leaf_index_;
+                    for (const siblings_type &siblings : path_) {
+                        if (siblings.size() >= Arity || index % Arity > siblings.size()) {
+                            return false;
+                        }
+                        index /= Arity;
+                    }
+                    return !index;
+                }
+
+                std::size_t leaf_index_;
+                std::vector<siblings_type> path_;
+            };
+
+            /*!
+             * @brief Merkle tree of any arity over any of the hashes. Each level is hashed in
+             * parallel, in contiguous runs of nodes: octet hashes pass every run to batch_hasher,
+             * so SHA-224/256, Keccak and SHA-3 nodes go through the multi-buffer kernels, while
+             * Poseidon hashes field elements through the hash overloads of algorithm/hash.hpp.
+             *
+             * A leaf is the hash of 0x00 followed by its data, a parent the hash of 0x01 followed
+             * by its children; Poseidon absorbs zero and one first instead. The last node of a
+             * level whose size is not a multiple of the arity takes fewer children. The nodes are
+             * stored level by level in one array, from the leaves up to the root.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             * @tparam Arity
+             */
+            template<typename Hash, std::size_t Arity = 2>
+            class merkle_tree {
+            public:
+                typedef Hash hash_type;
+                typedef detail::merkle_node_hasher<Hash> node_hasher_type;
+                typedef typename node_hasher_type::digest_type digest_type;
+                typedef digest_type value_type;
+                typedef merkle_proof<Hash, Arity> proof_type;
+
+                constexpr static const std::size_t arity = Arity;
+                BOOST_STATIC_ASSERT(Arity >= 2);
+
+            protected:
+                // Nodes handed over to each thread at least, so that the upper levels stay on one
+                constexpr static const std::size_t grain_nodes = 256;
+
+            public:
+                /*!
+                 * @param leaves Random access range of leaves: contiguous containers of octets, or
+                 * group elements for Poseidon
+                 * @param threads Threads hashing each level
+                 */
+                template<typename LeafRange>
+                explicit merkle_tree(const LeafRange &leaves, std::size_t threads = 1) :
+                    threads_(std::max<std::size_t>(threads, 1)) {
+                    std::size_t n = std::size(leaves);
+                    BOOST_ASSERT_MSG(n, "Merkle tree needs at least one leaf");
+
+                    offsets_.push_back(0);
+                    offsets_.push_back(n);
+                    for (std::size_t size = n; size > 1;) {
+                        size = (size + Arity - 1) / Arity;
+                        offsets_.push_back(offsets_.back() + size);
+                    }
+                    nodes_.resize(offsets_.back());
+
+                    auto first = std::begin(leaves);
+                    detail::parallel_for(n, level_threads(n), [&](std::size_t begin, std::size_t end) {
+                        node_hasher_type::hash_leaves(first + begin, end - begin, nodes_.data() + begin);
+                    });
+
+                    for (std::size_t l = 1; l != levels(); ++l) {
+                        const digest_type *children = level(l - 1);
+                        std::size_t count = level_size(l - 1);
+                        digest_type *parents = nodes_.data() + offsets_[l];
+
+                        detail::parallel_for(
+                            level_size(l), level_threads(level_size(l)), [&](std::size_t begin, std::size_t end) {
+                                node_hasher_type::hash_nodes(children + begin * Arity,
+                                                             std::min(count, end * Arity) - begin * Arity, Arity,
+                                                             parents + begin);
+                            });
+                    }
+                }
+
+                inline const digest_type &root() const {
+                    return nodes_.back();
+                }
+
+                inline std::size_t leaves_count() const {
+                    return level_size(0);
+                }
+
+                /*!
+                 * @brief Number of levels, the leaves and the root included
+                 */
+                inline std::size_t levels() const {
+                    return offsets_.size() - 1;
+                }
+
+                inline std::size_t level_size(std::size_t l) const {
+                    return offsets_[l + 1] - offsets_[l];
+                }
+
+                inline const digest_type *level(std::size_t l) const {
+                    return nodes_.data() + offsets_[l];
+                }
+
+                inline const digest_type &node(std::size_t l, std::size_t index) const {
+                    BOOST_ASSERT(index < level_size(l));
+                    return level(l)[index];
+                }
+
+                /*!
+                 * @brief All the nodes, level by level from the leaves up
+                 */
+                inline const std::vector<digest_type> &nodes() const {
+                    return nodes_;
+                }
+
+                inline proof_type proof(std::size_t leaf_index) const {
+                    BOOST_ASSERT(leaf_index < leaves_count());
+
+                    std::size_t index = leaf_index;
+                    std::vector<typename proof_type::siblings_type> path(levels() - 1);
+                    for (std::size_t l = 0; l + 1 < levels(); ++l) {
+                        std::size_t first = index - index % Arity;
+                        std::size_t last = std::min(first + Arity, level_size(l));
+                        for (std::size_t i = first; i != last; ++i) {
+                            if (i != index) {
+                                path[l].push_back(level(l)[i]);
+                            }
+                        }
+                        index /= Arity;
+                    }
+                    return proof_type(leaf_index, std::move(path));
+                }
+
+                /*!
+                 * @brief Digest of a leaf, as stored in the bottom level
+                 */
+                template<typename Leaf>
+                static inline digest_type hash_leaf(const Leaf &leaf) {
+                    digest_type d;
+                    node_hasher_type::hash_leaves(&leaf, 1, &d);
+                    return d;
+                }
+
+            protected:
+                inline std::size_t level_threads(std::size_t n) const {
+                    return std::min(threads_, std::max<std::size_t>(n / grain_nodes, 1));
+                }
+
+                std::size_t threads_;
+                std::vector<std::size_t> offsets_;
+                std::vector<digest_type> nodes_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_MERKLE_TREE_HPP
@@ -0,0 +1,196 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_MIDSTATE_HPP
+#define CRYPTO3_HASH_MIDSTATE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief Snapshot of a running hash: the construction chaining state, the buffered
+             * words of the current block and the amount of message bits seen so far.
+             *
+             * When the amount of bits seen is a non-zero multiple of the block size, the buffered
+             * block is the last full block, which is not compressed yet, unless block_compressed is
+             * set. Such a snapshot, taken from a prefix_state, has nothing buffered and has to be
+             * resumed with more message data, since digest() expects to be handed the last block.
+             *
+             * The binary form is stable across builds and hosts: a version octet, a tag naming the
+             * hash, the state and block sizes in words, a flags octet, then the amount of bits seen,
+             * the state words and the block words, all written as little-endian integers. The tag is the start of the
+             * digest of the empty message, so a snapshot is only read back by the hash that wrote it,
+             * even when another one has the same state layout, as SHA-224 and SHA-256 do.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             */
+            template<typename Hash>
+            struct midstate {
+                typedef Hash hash_type;
+                typedef typename hash_type::construction::type construction_type;
+
+                constexpr static const std::size_t word_bits = construction_type::word_bits;
+                constexpr static const std::size_t word_octets = word_bits / octet_bits;
+                typedef typename construction_type::word_type word_type;
+
+                constexpr static const std::size_t state_words = construction_type::state_words;
+                typedef typename construction_type::state_type state_type;
+
+                constexpr static const std::size_t block_words = construction_type::block_words;
+                typedef typename construction_type::block_type block_type;
+
+                BOOST_STATIC_ASSERT(word_bits % octet_bits == 0);
+                BOOST_STATIC_ASSERT(state_words < 0x100 && block_words < 0x100);
+
+                constexpr static const std::uint8_t version = 3;
+                constexpr static const std::size_t tag_octets = 4;
+                typedef std::array<octet_type, tag_octets> tag_type;
+                BOOST_STATIC_ASSERT(hash_type::digest_bits >= tag_octets * octet_bits);
+
+                constexpr static const std::uint8_t block_compressed_flag = 1;
+
+                constexpr static const std::size_t header_octets = 4 + tag_octets;
+                constexpr static const std::size_t length_octets = 8;
+                constexpr static const std::size_t serialized_octets =
+                    header_octets + length_octets + (state_words + block_words) * word_octets;
+                typedef std::array<octet_type, serialized_octets> serialized_type;
+
+                template<typename OutputIterator>
+                OutputIterator serialize(OutputIterator out) const {
+                    *out++ = version;
+                    out = std::copy(tag().begin(), tag().end(), out);
+                    *out++ = static_cast<octet_type>(state_words);
+                    *out++ = static_cast<octet_type>(block_words);
+                    *out++ = block_compressed ? block_compressed_flag : 0;
+
+                    out = write(static_cast<std::uint64_t>(total_seen), length_octets, out);
+                    for (const word_type &w : state) {
+                        out = write(w, word_octets, out);
+                    }
+                    for (const word_type &w : block) {
+                        out = write(w, word_octets, out);
+                    }
+                    return out;
+                }
+
+                serialized_type serialize() const {
+                    serialized_type s;
+                    serialize(s.begin());
+                    return s;
+                }
+
+                /*!
+                 * @return false if the input is too short or was written for a different hash
+                 */
+                template<typename InputIterator>
+                bool deserialize(InputIterator first, InputIterator last) {
+                    if (std::distance(first, last) < static_cast<std::ptrdiff_t>(serialized_octets)) {
+                        return false;
+                    }
+                    if (static_cast<std::uint8_t>(*first++) != version) {
+                        return false;
+                    }
+                    for (octet_type t : tag()) {
+                        if (static_cast<octet_type>(*first++) != t) {
+                            return false;
+                        }
+                    }
+                    if (static_cast<std::size_t>(*first++) != state_words ||
+                        static_cast<std::size_t>(*first++) != block_words) {
+                        return false;
+                    }
+                    const std::uint8_t flags = static_cast<std::uint8_t>(*first++);
+                    if (flags & ~block_compressed_flag) {
+                        return false;
+                    }
+
+                    block_compressed = flags & block_compressed_flag;
+                    total_seen = static_cast<std::size_t>(read<std::uint64_t>(first, length_octets));
+                    for (word_type &w : state) {
+                        w = read<word_type>(first, word_octets);
+                    }
+                    for (word_type &w : block) {
+                        w = read<word_type>(first, word_octets);
+                    }
+                    return true;
+                }
+
+                template<typename SinglePassRange>
+                bool deserialize(const SinglePassRange &range) {
+                    return deserialize(std::cbegin(range), std::cend(range));
+                }
+
+                /*!
+                 * @brief Tag written with every snapshot: the first octets of the digest of the empty message
+                 */
+                static const tag_type &tag() {
+                    static const tag_type t = []() {
+                        typename construction_type::digest_type d = construction_type().digest();
+                        tag_type empty_message;
+                        std::copy(d.begin(), d.begin() + tag_octets, empty_message.begin());
+                        return empty_message;
+                    }();
+                    return t;
+                }
+
+                state_type state;
+                block_type block;
+                std::size_t total_seen;
+                bool block_compressed;
+
+            protected:
+                template<typename Integral, typename OutputIterator>
+                static OutputIterator write(Integral value, std::size_t octets, OutputIterator out) {
+                    for (std::size_t i = 0; i != octets; ++i) {
+                        *out++ = static_cast<octet_type>(value >> (i * octet_bits));
+                    }
+                    return out;
+                }
+
+                template<typename Integral, typename InputIterator>
+                static Integral read(InputIterator &first, std::size_t octets) {
+                    Integral value = 0;
+                    for (std::size_t i = 0; i != octets; ++i) {
+                        value |= static_cast<Integral>(static_cast<octet_type>(*first++)) << (i * octet_bits);
+                    }
+                    return value;
+                }
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_MIDSTATE_HPP
@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_PARALLEL_HASH_HPP
+#define CRYPTO3_HASH_PARALLEL_HASH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/cshake.hpp>
+#include <nil/crypto3/hash/shake.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/detail/leaf_batch_hasher.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief ParallelHash128/ParallelHash256 and their XOF variants (NIST SP 800-185). The
+             * message is cut into block_size-octet leaves which are hashed independently with
+             * SHAKE, and the leaf digests are then hashed in order. Leaves are absorbed and
+             * squeezed several at a time by shake_xof_batch, and spread over threads when more
+             * than one is requested.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             */
+            template<std::size_t SecurityBits>
+            class parallel_hash {
+                typedef detail::cshake_functions functions_type;
+
+            public:
+                typedef cshake_xof<SecurityBits> xof_type;
+                typedef shake_xof<SecurityBits> leaf_xof_type;
+                typedef shake_xof_batch<SecurityBits> leaf_batch_type;
+
+                constexpr static const std::size_t leaf_digest_octets = 2 * SecurityBits / octet_bits;
+
+            protected:
+                typedef detail::leaf_batch_hasher<leaf_batch_type, leaf_digest_octets> leaf_hasher_type;
+
+            public:
+                parallel_hash(std::size_t block_size, const std::uint8_t *customization, std::size_t customization_size,
+                              std::size_t threads = 1) :
+                    outer_(function_name().data(), function_name().size(), customization, customization_size),
+                    block_size_(block_size), threads_(std::max<std::size_t>(threads, 1)), cache_(block_size) {
+                    BOOST_ASSERT(block_size);
+                    reset();
+                }
+
+                explicit parallel_hash(std::size_t block_size) :
+                    parallel_hash(block_size, static_cast<const std::uint8_t *>(nullptr), 0) {
+                }
+
+                template<typename CustomizationRange>
+                parallel_hash(std::size_t block_size, const CustomizationRange &customization,
+                              std::size_t threads = 1) :
+                    parallel_hash(block_size, detail::octets(customization), std::size(customization),
+                                  threads) {
+                }
+
+                inline parallel_hash &update(const std::uint8_t *data, std::size_t n) {
+                    BOOST_ASSERT_MSG(!xof_started_, "ParallelHash input can not be extended once squeezing started");
+
+                    if (cache_seen_) {
+                        std::size_t amount = std::min(n, block_size_ - cache_seen_);
+                        std::memcpy(cache_.data() + cache_seen_, data, amount);
+                        cache_seen_ += amount;
+                        data += amount;
+                        n -= amount;
+
+                        if (cache_seen_ != block_size_) {
+                            return *this;
+                        }
+                        process_leaves(cache_.data(), 1);
+                        cache_seen_ = 0;
+                    }
+
+                    std::size_t leaves = n / block_size_;
+                    process_leaves(data, leaves);
+                    data += leaves * block_size_;
+                    n -= leaves * block_size_;
+
+                    std::memcpy(cache_.data(), data, n);
+                    cache_seen_ = n;
+                    return *this;
+                }
+
+                template<typename ContiguousRange>
+                inline parallel_hash &update(const ContiguousRange &range) {
+                    return update(detail::octets(range), std::size(range));
+                }
+
+                /*!
+                 * @brief Writes the n-octet hash of the message seen so far and resets
+                 */
+                inline void finalize(std::uint8_t *out, std::size_t n) {
+                    finish(static_cast<std::uint64_t>(n) * octet_bits);
+                    outer_.squeeze(out, n);
+                    reset();
+                }
+
+                inline std::vector<std::uint8_t> finalize(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    finalize(out.data(), n);
+                    return out;
+                }
+
+                /*!
+                 * @brief ParallelHashXOF: writes the next n octets of output of arbitrary length
+                 */
+                inline void squeeze(std::uint8_t *out, std::size_t n) {
+                    if (!xof_started_) {
+                        finish(0);
+                        xof_started_ = true;
+                    }
+                    outer_.squeeze(out, n);
+                }
+
+                inline void reset() {
+                    outer_.reset();
+                    functions_type::encoded_integer_type b = functions_type::left_encode(block_size_);
+                    outer_.update(b.data(), b.size);
+
+                    cache_seen_ = 0;
+                    leaves_ = 0;
+                    xof_started_ = false;
+                }
+
+            protected:
+                static inline const std::array<std::uint8_t, 12> &function_name() {
+                    static const std::array<std::uint8_t, 12> name = {'P', 'a', 'r', 'a', 'l', 'l',
+                                                                      'e', 'l', 'H', 'a', 's', 'h'};
+                    return name;
+                }
+
+                // Hashes count whole leaves starting at data and absorbs their digests in order
+                inline void process_leaves(const std::uint8_t *data, std::size_t count) {
+                    leaf_hasher_type::process(data, count, block_size_, threads_,
+                                              [this](const std::uint8_t *digests, std::size_t amount) {
+                                                  outer_.update(digests, amount * leaf_digest_octets);
+                                                  leaves_ += amount;
+                                              });
+                }
+
+                // Hashes the last, shorter leaf and appends the leaf count and the output length
+                inline void finish(std::uint64_t output_bits) {
+                    if (cache_seen_) {
+                        std::array<std::uint8_t, leaf_digest_octets> digest;
+                        leaf_xof_type leaf;
+                        leaf.update(cache_.data(), cache_seen_);
+                        leaf.squeeze(digest.data(), digest.size());
+                        outer_.update(digest.data(), digest.size());
+                        ++leaves_;
+                        cache_seen_ = 0;
+                    }
+
+                    functions_type::encoded_integer_type n = functions_type::right_encode(leaves_);
+                    outer_.update(n.data(), n.size);
+                    functions_type::encoded_integer_type l = functions_type::right_encode(output_bits);
+                    outer_.update(l.data(), l.size);
+                }
+
+                xof_type outer_;
+                std::size_t block_size_;
+                std::size_t threads_;
+
+                std::vector<std::uint8_t> cache_;
+                std::size_t cache_seen_;
+                std::uint64_t leaves_;
+                bool xof_started_;
+            };
+
+            typedef parallel_hash<128> parallel_hash128;
+            typedef parallel_hash<256> parallel_hash256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_PARALLEL_HASH_HPP
@@ -0,0 +1,144 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_PBKDF2_HPP
+#define CRYPTO3_HASH_PBKDF2_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/hmac.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+#include <nil/crypto3/hash/detail/pbkdf2_engine.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief PBKDF2 (RFC 8018) with HMAC over Hash. The password is keyed into HMAC once, at
+             * construction, so every key derived from it starts from the precomputed midstates.
+             *
+             * The iterations of Merkle-Damgard hashes run on the compression function directly, with
+             * the padded block of a digest built only once. Independent output blocks, whether of one
+             * long key or of the keys of several passwords, go through the SHA-224/256 multi-buffer
+             * kernel side by side where the target has one.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             */
+            template<typename Hash>
+            class pbkdf2 {
+            public:
+                typedef Hash hash_type;
+                typedef hmac<hash_type> mac_type;
+                typedef typename mac_type::digest_type digest_type;
+                typedef typename mac_type::value_type value_type;
+
+                constexpr static const std::size_t digest_octets = hash_type::digest_bits / octet_bits;
+
+            protected:
+                typedef detail::pbkdf2_engine<hash_type> engine_type;
+
+            public:
+                pbkdf2(const value_type *password, std::size_t password_size) : mac_(password, password_size) {
+                }
+
+                template<typename PasswordRange>
+                explicit pbkdf2(const PasswordRange &password) : mac_(password) {
+                }
+
+                /*!
+                 * @brief Writes the n-octet key derived from salt with the given amount of iterations
+                 */
+                inline void derive(const value_type *salt, std::size_t salt_size, std::size_t iterations,
+                                   value_type *out, std::size_t n) const {
+                    const pbkdf2 *key = this;
+                    derive(&key, &salt, &salt_size, 1, iterations, &out, n);
+                }
+
+                template<typename SaltRange>
+                inline std::vector<value_type> derive(const SaltRange &salt, std::size_t iterations,
+                                                      std::size_t n) const {
+                    std::vector<value_type> out(n);
+                    derive(detail::octets(salt), std::size(salt), iterations, out.data(), n);
+                    return out;
+                }
+
+                /*!
+                 * @brief Derives count keys of n octets at once, the i-th one from the password of keys[i]
+                 * and salts[i] into out[i]. Batching the passwords of several requests fills the vector
+                 * lanes even when every key is a single block.
+                 */
+                static inline void derive(const pbkdf2 *const *keys, const value_type *const *salts,
+                                          const std::size_t *salt_sizes, std::size_t count, std::size_t iterations,
+                                          value_type *const *out, std::size_t n) {
+                    BOOST_ASSERT(iterations);
+
+                    const std::size_t key_blocks = (n + digest_octets - 1) / digest_octets;
+                    BOOST_ASSERT_MSG(key_blocks <= 0xFFFFFFFF, "PBKDF2 derived key is too long");
+
+                    // U_1 of every block, and the key it is iterated with
+                    std::vector<const mac_type *> macs;
+                    std::vector<digest_type> blocks;
+                    macs.reserve(count * key_blocks);
+                    blocks.reserve(count * key_blocks);
+                    for (std::size_t k = 0; k != count; ++k) {
+                        mac_type mac = keys[k]->mac_;
+                        for (std::size_t i = 1; i <= key_blocks; ++i) {
+                            const std::array<value_type, 4> index = {
+                                static_cast<value_type>(i >> 24), static_cast<value_type>(i >> 16),
+                                static_cast<value_type>(i >> 8), static_cast<value_type>(i)};
+                            mac.update(salts[k], salt_sizes[k]).update(index.data(), index.size());
+                            blocks.push_back(mac.finalize());
+                            macs.push_back(&keys[k]->mac_);
+                        }
+                    }
+
+                    engine_type::process(macs.data(), blocks.data(), blocks.size(), iterations);
+
+                    for (std::size_t k = 0; k != count; ++k) {
+                        for (std::size_t i = 0, done = 0; done != n; ++i) {
+                            const digest_type &block = blocks[k * key_blocks + i];
+                            const std::size_t amount = std::min(n - done, digest_octets);
+                            std::copy(block.begin(), block.begin() + amount, out[k] + done);
+                            done += amount;
+                        }
+                    }
+                }
+
+            protected:
+                mac_type mac_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_PBKDF2_HPP
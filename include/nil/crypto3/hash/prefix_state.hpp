@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_PREFIX_STATE_HPP
+#define CRYPTO3_HASH_PREFIX_STATE_HPP
+
+#include <iterator>
+#include <type_traits>
+
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/midstate.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                template<typename Hash>
+                class prefix_hasher : public hasher<Hash> {
+                public:
+                    using hasher<Hash>::compress_cache;
+                };
+            }    // namespace detail
+
+            /*!
+             * @brief Hash state with a fixed prefix already absorbed. Messages sharing the prefix
+             * (domain separation tags, padded keys, protocol labels) are hashed from a plain copy
+             * of this state, so the prefix is compressed only once.
+             *
+             * The last block of a prefix spanning a whole number of blocks is compressed up front
+             * as well, whatever the construction. An untouched copy of the state still serves empty
+             * suffixes, which leave that block to digest(), as HMAC does with its key blocks.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             */
+            template<typename Hash>
+            class prefix_state {
+            public:
+                typedef Hash hash_type;
+                typedef hasher<hash_type> hasher_type;
+                typedef typename hasher_type::digest_type digest_type;
+
+            protected:
+                typedef detail::prefix_hasher<hash_type> prefix_hasher_type;
+
+                BOOST_STATIC_ASSERT(std::is_trivially_copyable<hasher_type>::value);
+
+            public:
+                prefix_state() {
+                    compress();
+                }
+
+                /*!
+                 * @brief Resumes from a snapshot. One with a compressed last block only takes non-empty suffixes.
+                 */
+                explicit prefix_state(const midstate<hash_type> &m) {
+                    prefix.import_midstate(m);
+                    compress();
+                }
+
+                template<typename SinglePassRange>
+                explicit prefix_state(const SinglePassRange &range) {
+                    prefix.update(range);
+                    compress();
+                }
+
+                template<typename InputIterator>
+                prefix_state(InputIterator first, InputIterator last) {
+                    prefix.update(first, last);
+                    compress();
+                }
+
+                /*!
+                 * @brief Extends the prefix
+                 */
+                template<typename SinglePassRange>
+                inline prefix_state &absorb(const SinglePassRange &range) {
+                    prefix.update(range);
+                    compress();
+                    return *this;
+                }
+
+                template<typename InputIterator>
+                inline prefix_state &absorb(InputIterator first, InputIterator last) {
+                    prefix.update(first, last);
+                    compress();
+                    return *this;
+                }
+
+                /*!
+                 * @return hasher which continues right after the prefix. It may be finalized right away,
+                 * so the last block of a block-aligned prefix is left to it.
+                 */
+                inline hasher_type fork() const {
+                    return prefix;
+                }
+
+                /*!
+                 * @return digest of the prefix followed by the suffix
+                 */
+                template<typename SinglePassRange>
+                inline digest_type operator()(const SinglePassRange &suffix) const {
+                    return (*this)(std::cbegin(suffix), std::cend(suffix));
+                }
+
+                template<typename InputIterator>
+                inline digest_type operator()(InputIterator first, InputIterator last) const {
+                    hasher_type h = first == last ? prefix : static_cast<const hasher_type &>(compressed);
+                    return h.update(first, last).finalize();
+                }
+
+                /*!
+                 * @return snapshot with the last block compressed, to be resumed with non-empty data
+                 */
+                inline midstate<hash_type> export_midstate() const {
+                    return compressed.export_midstate();
+                }
+
+            protected:
+                inline void compress() {
+                    static_cast<hasher_type &>(compressed) = prefix;
+                    compressed.compress_cache();
+                }
+
+                hasher_type prefix;
+                prefix_hasher_type compressed;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_PREFIX_STATE_HPP
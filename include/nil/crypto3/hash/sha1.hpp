@@ -34,6 +34,14 @@
 #include <nil/crypto3/hash/detail/block_stream_processor.hpp>
 #include <nil/crypto3/hash/detail/merkle_damgard_padding.hpp>
 
+#include <boost/predef/architecture.h>
+
+#if BOOST_ARCH_X86_64 && defined(CRYPTO3_HAS_SHA_NI)
+#include <nil/crypto3/hash/detail/sha1/sha1_sha_ni_impl.hpp>
+#elif BOOST_ARCH_X86_64
+#include <nil/crypto3/hash/detail/sha1/sha1_dispatch_impl.hpp>
+#endif
+
 namespace nil {
     namespace crypto3 {
         namespace hashes {
@@ -47,6 +55,14 @@ namespace nil {
                 typedef detail::sha1_policy policy_type;
                 typedef typename policy_type::block_cipher_type block_cipher_type;
 
+#if BOOST_ARCH_X86_64 && defined(CRYPTO3_HAS_SHA_NI)
+                typedef detail::sha1_sha_ni_impl compressor_type;
+#elif BOOST_ARCH_X86_64
+                typedef detail::sha1_dispatch_impl compressor_type;
+#else
+                typedef davies_meyer_compressor<block_cipher_type, detail::state_adder> compressor_type;
+#endif
+
             public:
                 constexpr static const std::size_t word_bits = policy_type::word_bits;
                 typedef typename policy_type::word_type word_type;
@@ -67,8 +83,7 @@ namespace nil {
                     };
 
                     typedef merkle_damgard_construction<params_type, typename policy_type::iv_generator,
-                                                        davies_meyer_compressor<block_cipher_type, detail::state_adder>,
-                                                        detail::merkle_damgard_padding<policy_type>>
+                                                        compressor_type, detail::merkle_damgard_padding<policy_type>>
                         type;
                 };
 
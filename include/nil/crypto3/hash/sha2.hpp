@@ -30,12 +30,22 @@
 #ifdef __ZKLLVM__
 #include <nil/crypto3/algebra/curves/pallas.hpp>
 #else
+#include <type_traits>
+
 #include <nil/crypto3/hash/detail/sha2/sha2_policy.hpp>
 #include <nil/crypto3/hash/detail/state_adder.hpp>
 #include <nil/crypto3/hash/detail/davies_meyer_compressor.hpp>
 #include <nil/crypto3/hash/detail/merkle_damgard_construction.hpp>
 #include <nil/crypto3/hash/detail/block_stream_processor.hpp>
 #include <nil/crypto3/hash/detail/merkle_damgard_padding.hpp>
+
+#include <boost/predef/architecture.h>
+
+#if BOOST_ARCH_X86_64 && defined(CRYPTO3_HAS_SHA_NI)
+#include <nil/crypto3/hash/detail/sha2/sha2_256_sha_ni_impl.hpp>
+#elif BOOST_ARCH_X86_64
+#include <nil/crypto3/hash/detail/sha2/sha2_256_dispatch_impl.hpp>
+#endif
 #endif
 
 namespace nil {
@@ -65,6 +75,17 @@ namespace nil {
                 typedef detail::sha2_policy<Version> policy_type;
                 typedef typename policy_type::block_cipher_type block_cipher_type;
 
+                typedef typename std::conditional<policy_type::word_bits == 32,
+#if BOOST_ARCH_X86_64 && defined(CRYPTO3_HAS_SHA_NI)
+                                                  detail::sha2_256_sha_ni_impl<policy_type>,
+#elif BOOST_ARCH_X86_64
+                                                  detail::sha2_256_dispatch_impl<policy_type>,
+#else
+                                                  davies_meyer_compressor<block_cipher_type, detail::state_adder>,
+#endif
+                                                  davies_meyer_compressor<block_cipher_type, detail::state_adder>>::type
+                    compressor_type;
+
             public:
                 constexpr static const std::size_t version = Version;
 
@@ -93,8 +114,7 @@ namespace nil {
                     };
 
                     typedef merkle_damgard_construction<params_type, typename policy_type::iv_generator,
-                                                        davies_meyer_compressor<block_cipher_type, detail::state_adder>,
-                                                        detail::merkle_damgard_padding<policy_type>>
+                                                        compressor_type, detail::merkle_damgard_padding<policy_type>>
                         type;
                 };
 
@@ -27,6 +27,9 @@
 #ifndef CRYPTO3_HASH_SHA3_HPP
 #define CRYPTO3_HASH_SHA3_HPP
 
+#include <cstdint>
+#include <cstring>
+
 #include <nil/crypto3/hash/detail/sponge_construction.hpp>
 #include <nil/crypto3/hash/detail/block_stream_processor.hpp>
 #include <nil/crypto3/hash/detail/sha3/sha3_functions.hpp>
@@ -56,17 +59,44 @@ namespace nil {
                 constexpr static const std::size_t block_words = policy_type::block_words;
                 typedef typename policy_type::block_type block_type;
 
-                static void process_block(state_type &state, const block_type &block) {
-                    for (std::size_t i = 0; i != block_words; ++i)
-                        state[i] ^= block[i];
+                // Absorbs in lane order, as keccak_1600_compressor does
+                constexpr static const bool native_lane_order = true;
 
+                static void to_lane_order(state_type &state) {
                     for (std::size_t i = 0; i != state_words; ++i)
                         boost::endian::endian_reverse_inplace(state[i]);
+                }
+
+                static void from_lane_order(state_type &state) {
+                    to_lane_order(state);
+                }
+
+                static void process_block(state_type &state, const block_type &block) {
+                    for (std::size_t i = 0; i != block_words; ++i)
+                        state[i] ^= boost::endian::endian_reverse(block[i]);
 
                     policy_type::permute(state);
+                }
 
-                    for (std::size_t i = 0; i != state_words; ++i)
-                        boost::endian::endian_reverse_inplace(state[i]);
+                static void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                    for (; n; --n, ++blocks) {
+                        for (std::size_t i = 0; i != block_words; ++i)
+                            state[i] ^= boost::endian::endian_reverse((*blocks)[i]);
+
+                        policy_type::permute(state);
+                    }
+                }
+
+                static void process_octets(state_type &state, const std::uint8_t *data, std::size_t n) {
+                    for (; n; --n) {
+                        for (std::size_t i = 0; i != block_words; ++i, data += word_bits / octet_bits) {
+                            word_type w;
+                            std::memcpy(&w, data, sizeof(w));
+                            state[i] ^= boost::endian::little_to_native(w);
+                        }
+
+                        policy_type::permute(state);
+                    }
                 }
             };
 
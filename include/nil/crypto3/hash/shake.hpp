@@ -0,0 +1,327 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_SHAKE_HPP
+#define CRYPTO3_HASH_SHAKE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/detail/octet.hpp>
+
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_1600_multi_buffer.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Copies n octets of the rate, starting at octet offset, out of lane-ordered words
+                 */
+                template<typename Words>
+                inline void keccak_1600_extract(const Words &words, std::size_t offset, std::uint8_t *out,
+                                                std::size_t n) {
+                    typedef typename Words::value_type word_type;
+                    constexpr const std::size_t word_octets = sizeof(word_type);
+
+                    for (; n && offset % word_octets; --n, ++offset) {
+                        *out++ = static_cast<std::uint8_t>(words[offset / word_octets] >>
+                                                           ((offset % word_octets) * octet_bits));
+                    }
+                    for (; n >= word_octets; n -= word_octets, offset += word_octets, out += word_octets) {
+                        word_type w = boost::endian::native_to_little(words[offset / word_octets]);
+                        std::memcpy(out, &w, word_octets);
+                    }
+                    for (; n; --n, ++offset) {
+                        *out++ = static_cast<std::uint8_t>(words[offset / word_octets] >>
+                                                           ((offset % word_octets) * octet_bits));
+                    }
+                }
+            }    // namespace detail
+
+            template<std::size_t SecurityBits, std::size_t Rounds, std::uint8_t DomainSeparator>
+            class shake_xof_batch;
+
+            /*!
+             * @brief SHAKE128/SHAKE256 extendable-output function (FIPS 202). Message octets are
+             * absorbed with update(), then squeeze() hands out any amount of output in as many
+             * calls as needed. The state is permuted lazily, only once the octets left in the
+             * current output block run out.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             * @tparam Rounds Rounds of the permutation: 24 for SHAKE, 12 for TurboSHAKE
+             */
+            template<std::size_t SecurityBits, std::size_t Rounds = 24>
+            class shake_xof {
+                BOOST_STATIC_ASSERT(SecurityBits == 128 || SecurityBits == 256);
+
+                template<std::size_t, std::size_t, std::uint8_t>
+                friend class shake_xof_batch;
+
+            public:
+                typedef keccak_1600_compressor<SecurityBits, Rounds> compressor_type;
+
+                constexpr static const std::size_t security_bits = SecurityBits;
+                // Output length with SecurityBits of collision resistance
+                constexpr static const std::size_t digest_bits = 2 * SecurityBits;
+
+                constexpr static const std::size_t word_bits = compressor_type::word_bits;
+                typedef typename compressor_type::word_type word_type;
+
+                constexpr static const std::size_t state_words = compressor_type::state_words;
+                typedef typename compressor_type::state_type state_type;
+
+                constexpr static const std::size_t block_bits = compressor_type::block_bits;
+                constexpr static const std::size_t block_octets = block_bits / octet_bits;
+
+                constexpr static const std::uint8_t domain_separator = 0x1F;
+
+                shake_xof() : domain_(domain_separator) {
+                    reset();
+                }
+
+                inline void reset() {
+                    std::fill(state_.begin(), state_.end(), 0);
+                    cache_seen_ = 0;
+                    squeezed_ = 0;
+                    squeezing_ = false;
+                }
+
+                inline shake_xof &update(const std::uint8_t *data, std::size_t n) {
+                    BOOST_ASSERT_MSG(!squeezing_, "SHAKE input can not be extended once squeezing started");
+
+                    if (cache_seen_) {
+                        std::size_t amount = std::min(n, block_octets - cache_seen_);
+                        std::memcpy(cache_.data() + cache_seen_, data, amount);
+                        cache_seen_ += amount;
+                        data += amount;
+                        n -= amount;
+
+                        if (cache_seen_ != block_octets) {
+                            return *this;
+                        }
+                        compressor_type::process_octets(state_, cache_.data(), 1);
+                        cache_seen_ = 0;
+                    }
+
+                    std::size_t blocks = n / block_octets;
+                    compressor_type::process_octets(state_, data, blocks);
+                    data += blocks * block_octets;
+                    n -= blocks * block_octets;
+
+                    std::memcpy(cache_.data(), data, n);
+                    cache_seen_ = n;
+                    return *this;
+                }
+
+                template<typename InputIterator>
+                inline shake_xof &update(InputIterator first, InputIterator last) {
+                    BOOST_ASSERT_MSG(!squeezing_, "SHAKE input can not be extended once squeezing started");
+
+                    while (first != last) {
+                        cache_[cache_seen_++] = static_cast<std::uint8_t>(*first++);
+                        if (cache_seen_ == block_octets) {
+                            compressor_type::process_octets(state_, cache_.data(), 1);
+                            cache_seen_ = 0;
+                        }
+                    }
+                    return *this;
+                }
+
+                template<typename SinglePassRange>
+                inline shake_xof &update(const SinglePassRange &range) {
+                    return update(std::cbegin(range), std::cend(range));
+                }
+
+                /*!
+                 * @brief Writes the next n octets of output. The first call pads the message.
+                 */
+                inline void squeeze(std::uint8_t *out, std::size_t n) {
+                    if (!squeezing_) {
+                        pad();
+                    }
+
+                    while (n) {
+                        if (squeezed_ == block_octets) {
+                            compressor_type::permute(state_);
+                            squeezed_ = 0;
+                        }
+
+                        std::size_t amount = std::min(n, block_octets - squeezed_);
+                        detail::keccak_1600_extract(state_, squeezed_, out, amount);
+                        squeezed_ += amount;
+                        out += amount;
+                        n -= amount;
+                    }
+                }
+
+                inline std::vector<std::uint8_t> squeeze(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    squeeze(out.data(), n);
+                    return out;
+                }
+
+            protected:
+                /*!
+                 * @brief For the functions built on SHAKE which pad with their own domain separator
+                 */
+                explicit shake_xof(std::uint8_t domain) : domain_(domain) {
+                    reset();
+                }
+
+                inline void pad() {
+                    std::fill(cache_.begin() + cache_seen_, cache_.end(), 0);
+                    cache_[cache_seen_] ^= domain_;
+                    cache_[block_octets - 1] ^= 0x80;
+                    compressor_type::process_octets(state_, cache_.data(), 1);
+
+                    cache_seen_ = 0;
+                    squeezing_ = true;
+                }
+
+                state_type state_;
+                std::array<std::uint8_t, block_octets> cache_;
+                std::size_t cache_seen_;
+                std::size_t squeezed_;
+                bool squeezing_;
+                std::uint8_t domain_;
+            };
+
+            /*!
+             * @brief Several SHAKE instances squeezed in lockstep. Each message gets its own sponge;
+             * on x86_64 the sponges are absorbed and permuted several at a time by the widest
+             * multi-buffer Keccak kernel the CPU supports, one sponge per vector lane.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             * @tparam Rounds Rounds of the permutation: 24 for SHAKE, 12 for TurboSHAKE
+             * @tparam DomainSeparator First padding octet of every sponge
+             */
+            template<std::size_t SecurityBits, std::size_t Rounds = 24, std::uint8_t DomainSeparator = 0x1F>
+            class shake_xof_batch {
+                typedef shake_xof<SecurityBits, Rounds> xof_type;
+
+            public:
+                typedef typename xof_type::compressor_type compressor_type;
+
+                constexpr static const std::size_t word_bits = xof_type::word_bits;
+                typedef typename xof_type::word_type word_type;
+
+                constexpr static const std::size_t state_words = xof_type::state_words;
+                typedef typename xof_type::state_type state_type;
+
+                constexpr static const std::size_t block_bits = xof_type::block_bits;
+                constexpr static const std::size_t block_words = block_bits / word_bits;
+                constexpr static const std::size_t block_octets = xof_type::block_octets;
+
+            protected:
+#ifdef CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER
+                typedef detail::keccak_1600_multi_buffer_dispatch<detail::keccak_1600_policy<SecurityBits, Rounds>,
+                                                                  DomainSeparator>
+                    multi_buffer_type;
+#endif
+
+            public:
+                shake_xof_batch() : squeezed_(0) {
+                }
+
+                /*!
+                 * @brief Starts a new batch, one sponge per message
+                 */
+                inline void absorb(const std::uint8_t *const *data, const std::size_t *sizes, std::size_t n) {
+                    states_.resize(n);
+                    squeezed_ = 0;
+
+#ifdef CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER
+                    multi_buffer_type::absorb(data, sizes, n, states_.data());
+#else
+                    for (std::size_t i = 0; i != n; ++i) {
+                        xof_type xof(DomainSeparator);
+                        xof.update(data[i], sizes[i]);
+                        xof.pad();
+                        states_[i] = xof.state_;
+                    }
+#endif
+                }
+
+                /*!
+                 * @brief Writes the next n octets of every sponge's output to out[0] ... out[size() - 1]
+                 */
+                inline void squeeze(std::uint8_t *const *out, std::size_t n) {
+                    std::size_t done = 0;
+                    while (done != n) {
+                        if (squeezed_ == block_octets) {
+                            permute();
+                            squeezed_ = 0;
+                        }
+
+                        std::size_t amount = std::min(n - done, block_octets - squeezed_);
+                        for (std::size_t m = 0; m != states_.size(); ++m) {
+                            std::array<word_type, block_words> words;
+                            std::copy(states_[m].begin(), states_[m].begin() + block_words, words.begin());
+                            detail::keccak_1600_extract(words, squeezed_, out[m] + done, amount);
+                        }
+                        squeezed_ += amount;
+                        done += amount;
+                    }
+                }
+
+                inline std::size_t size() const {
+                    return states_.size();
+                }
+
+            protected:
+                inline void permute() {
+#ifdef CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER
+                    multi_buffer_type::permute(states_.data(), states_.size());
+#else
+                    for (state_type &state : states_) {
+                        compressor_type::permute(state);
+                    }
+#endif
+                }
+
+                std::vector<state_type> states_;
+                std::size_t squeezed_;
+            };
+
+            typedef shake_xof<128> shake128;
+            typedef shake_xof<256> shake256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHAKE_HPP
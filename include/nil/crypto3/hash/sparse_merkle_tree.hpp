@@ -0,0 +1,465 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_SPARSE_MERKLE_TREE_HPP
+#define CRYPTO3_HASH_SPARSE_MERKLE_TREE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/hash/detail/merkle_node_hasher.hpp>
+#include <nil/crypto3/hash/detail/parallel_for.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Accessors for the bits of a big-endian key. Bit h is the branch taken at
+                 * height h, counted from the leaves, so it is the h-th least significant one.
+                 */
+                template<std::size_t KeyBits>
+                struct sparse_merkle_key {
+                    typedef std::array<std::uint8_t, KeyBits / octet_bits> key_type;
+
+                    static inline bool bit(const key_type &key, std::size_t h) {
+                        return (key[key.size() - 1 - h / octet_bits] >> (h % octet_bits)) & 1;
+                    }
+
+                    static inline void flip(key_type &key, std::size_t h) {
+                        key[key.size() - 1 - h / octet_bits] ^= std::uint8_t(1) << (h % octet_bits);
+                    }
+
+                    static inline void clear(key_type &key, std::size_t h) {
+                        key[key.size() - 1 - h / octet_bits] &= ~(std::uint8_t(1) << (h % octet_bits));
+                    }
+
+                    // Whether key lies in the subtree of height h under prefix, whose bits below h are cleared
+                    static inline bool in_subtree(const key_type &key, const key_type &prefix, std::size_t h) {
+                        const std::size_t octets = key.size() - h / octet_bits;
+                        if (!std::equal(key.begin(), key.begin() + octets - (h % octet_bits ? 1 : 0), prefix.begin())) {
+                            return false;
+                        }
+                        const std::uint8_t mask = std::uint8_t(0xFF << (h % octet_bits));
+                        return h % octet_bits == 0 || (key[octets - 1] & mask) == prefix[octets - 1];
+                    }
+
+                    // FNV-1a over the octets, keys are not assumed to be random
+                    struct hash {
+                        inline std::size_t operator()(const key_type &key) const {
+                            std::uint64_t h = 0xCBF29CE484222325ULL;
+                            for (std::uint8_t octet : key) {
+                                h = (h ^ octet) * 0x100000001B3ULL;
+                            }
+                            return static_cast<std::size_t>(h);
+                        }
+                    };
+                };
+            }    // namespace detail
+
+            /*!
+             * @brief Authentication path of one key of a sparse_merkle_tree: the sibling of every
+             * node on the way from the leaf to the root.
+             *
+             * @tparam Hash
+             * @tparam KeyBits
+             */
+            template<typename Hash, std::size_t KeyBits = 256>
+            class sparse_merkle_proof {
+                typedef detail::sparse_merkle_key<KeyBits> key_functions;
+
+            public:
+                typedef detail::merkle_node_hasher<Hash> node_hasher_type;
+                typedef typename node_hasher_type::digest_type digest_type;
+                typedef typename key_functions::key_type key_type;
+
+                sparse_merkle_proof(const key_type &key, std::vector<digest_type> siblings) :
+                    key_(key), siblings_(std::move(siblings)) {
+                }
+
+                inline const key_type &key() const {
+                    return key_;
+                }
+
+                /*!
+                 * @brief Siblings from the leaf level up
+                 */
+                inline const std::vector<digest_type> &siblings() const {
+                    return siblings_;
+                }
+
+                /*!
+                 * @brief Recomputes the root from the leaf stored under the key, the empty leaf
+                 * for a proof of absence
+                 */
+                inline digest_type root(const digest_type &leaf) const {
+                    BOOST_ASSERT(siblings_.size() == KeyBits);
+
+                    std::array<digest_type, 2> children;
+                    digest_type node = leaf;
+                    for (std::size_t h = 0; h != KeyBits; ++h) {
+                        if (key_functions::bit(key_, h)) {
+                            children = {siblings_[h], node};
+                        } else {
+                            children = {node, siblings_[h]};
+                        }
+                        node = node_hasher_type::hash_node(children.data(), children.size());
+                    }
+                    return node;
+                }
+
+                inline bool validate(const digest_type &leaf, const digest_type &expected_root) const {
+                    return siblings_.size() == KeyBits && root(leaf) == expected_root;
+                }
+
+            protected:
+                key_type key_;
+                std::vector<digest_type> siblings_;
+            };
+
+            /*!
+             * @brief Binary Merkle tree over the whole key space, holding a leaf digest for every
+             * key. Keys not set hold the empty leaf; the roots of the empty subtrees of every
+             * height are computed once, at construction.
+             *
+             * Memory grows with the number of keys, not with the key length: a subtree holding a
+             * single key is not stored node by node. Its key keeps the leaf and the root of the
+             * highest such subtree, right below the first node with another key under it, and only
+             * nodes with two keys or more below them are stored, level by level. For keys spread
+             * evenly over the key space that is about two nodes per key; keys sharing a long prefix
+             * cost a node per shared bit. The nodes of a single-key subtree below its top are
+             * rehashed from the leaf when asked for, which only proofs of absence and insertions next
+             * to a lone key do, once each.
+             *
+             * update() applies a batch of writes: the keys are sorted and de-duplicated, the last
+             * write winning, and the tree is then rehashed one level at a time, going up. Every
+             * touched node is hashed exactly once, however many of the written keys lie below it,
+             * and each level is hashed as one batch, through the multi-buffer kernels for octet
+             * hashes. Levels with enough touched nodes are spread over threads.
+             *
+             * @ingroup hashes
+             *
+             * @tparam Hash
+             * @tparam KeyBits
+             */
+            template<typename Hash, std::size_t KeyBits = 256>
+            class sparse_merkle_tree {
+                typedef detail::sparse_merkle_key<KeyBits> key_functions;
+
+            public:
+                typedef Hash hash_type;
+                typedef detail::merkle_node_hasher<Hash> node_hasher_type;
+                typedef typename node_hasher_type::digest_type digest_type;
+                typedef digest_type value_type;
+                typedef typename key_functions::key_type key_type;
+                typedef sparse_merkle_proof<Hash, KeyBits> proof_type;
+
+                constexpr static const std::size_t key_bits = KeyBits;
+                BOOST_STATIC_ASSERT(KeyBits > 0 && KeyBits % octet_bits == 0);
+
+            protected:
+                struct leaf_entry {
+                    digest_type leaf;
+                    // Height and root of the highest subtree holding this key alone
+                    std::size_t top;
+                    digest_type top_root;
+                };
+
+                // Leaves in key order, so the key of a single-key subtree is found by its prefix
+                typedef std::map<key_type, leaf_entry> leaves_type;
+                typedef std::unordered_map<key_type, digest_type, typename key_functions::hash> level_type;
+
+                // Root of a subtree and the number of keys below it, counted up to two
+                struct subtree_type {
+                    digest_type root;
+                    std::size_t keys;
+                };
+
+                // Parents handed over to each thread at least
+                constexpr static const std::size_t grain_nodes = 256;
+
+            public:
+                /*!
+                 * @param empty_leaf Digest held by the keys not set
+                 * @param threads Threads hashing each level of an update
+                 */
+                explicit sparse_merkle_tree(const digest_type &empty_leaf = digest_type(), std::size_t threads = 1) :
+                    threads_(std::max<std::size_t>(threads, 1)), nodes_(KeyBits + 1) {
+                    empty_[0] = empty_leaf;
+                    for (std::size_t h = 0; h != KeyBits; ++h) {
+                        std::array<digest_type, 2> children = {empty_[h], empty_[h]};
+                        empty_[h + 1] = node_hasher_type::hash_node(children.data(), children.size());
+                    }
+                }
+
+                /*!
+                 * @brief Sets the leaf of a single key. Setting the empty leaf removes the key.
+                 */
+                inline sparse_merkle_tree &update(const key_type &key, const digest_type &leaf) {
+                    std::array<std::pair<key_type, digest_type>, 1> updates = {std::make_pair(key, leaf)};
+                    return update(updates);
+                }
+
+                /*!
+                 * @param updates Range of (key, leaf digest) pairs, applied in order
+                 */
+                template<typename UpdateRange>
+                sparse_merkle_tree &update(const UpdateRange &updates) {
+                    std::vector<std::pair<key_type, digest_type>> sorted(std::begin(updates), std::end(updates));
+                    if (sorted.empty()) {
+                        return *this;
+                    }
+
+                    std::stable_sort(sorted.begin(), sorted.end(),
+                                     [](const std::pair<key_type, digest_type> &a,
+                                        const std::pair<key_type, digest_type> &b) { return a.first < b.first; });
+
+                    std::vector<key_type> keys;
+                    std::vector<subtree_type> layer;
+                    for (const std::pair<key_type, digest_type> &u : sorted) {
+                        if (!keys.empty() && keys.back() == u.first) {
+                            layer.back().root = u.second;
+                        } else {
+                            keys.push_back(u.first);
+                            layer.push_back({u.second, 0});
+                        }
+                    }
+                    for (std::size_t i = 0; i != keys.size(); ++i) {
+                        if (layer[i].root == empty_[0]) {
+                            leaves_.erase(keys[i]);
+                        } else {
+                            leaves_[keys[i]].leaf = layer[i].root;
+                            layer[i].keys = 1;
+                        }
+                    }
+
+                    // Keys of the touched nodes keep the branch bits below their height cleared,
+                    // so they stay sorted and siblings stay next to each other
+                    std::vector<key_type> parent_keys;
+                    std::vector<subtree_type> parents;
+                    std::vector<digest_type> children;
+                    for (std::size_t h = 0; h != KeyBits; ++h) {
+                        parent_keys.clear();
+                        parents.clear();
+                        children.clear();
+                        for (std::size_t i = 0; i != keys.size(); ++i) {
+                            key_type parent = keys[i];
+                            key_functions::clear(parent, h);
+
+                            std::array<key_type, 2> pair_keys = {parent, parent};
+                            key_functions::flip(pair_keys[1], h);
+                            std::array<subtree_type, 2> pair;
+                            if (key_functions::bit(keys[i], h)) {
+                                pair = {subtree(h, pair_keys[0]), layer[i]};
+                            } else if (i + 1 != keys.size() && key_functions::bit(keys[i + 1], h) &&
+                                       same_parent(keys[i], keys[i + 1], h)) {
+                                pair = {layer[i], layer[i + 1]};
+                                ++i;
+                            } else {
+                                pair = {layer[i], subtree(h, pair_keys[1])};
+                            }
+
+                            // A lone key right below a node with more keys has the top of its subtree here
+                            const std::size_t count = pair[0].keys + pair[1].keys;
+                            if (count >= 2) {
+                                for (std::size_t c = 0; c != 2; ++c) {
+                                    if (pair[c].keys == 1) {
+                                        set_top(h, pair_keys[c], pair[c].root);
+                                    }
+                                }
+                            }
+
+                            children.push_back(pair[0].root);
+                            children.push_back(pair[1].root);
+                            parent_keys.push_back(parent);
+                            parents.push_back({digest_type(), std::min<std::size_t>(count, 2)});
+                        }
+
+                        std::vector<digest_type> roots(parents.size());
+                        detail::parallel_for(roots.size(), level_threads(roots.size()),
+                                             [&](std::size_t first, std::size_t last) {
+                                                 node_hasher_type::hash_nodes(children.data() + 2 * first,
+                                                                              2 * (last - first), 2,
+                                                                              roots.data() + first);
+                                             });
+                        for (std::size_t i = 0; i != parents.size(); ++i) {
+                            parents[i].root = roots[i];
+                        }
+
+                        keys.swap(parent_keys);
+                        layer.swap(parents);
+                        store(h + 1, keys, layer);
+                    }
+
+                    if (layer[0].keys == 1) {
+                        set_top(KeyBits, key_type(), layer[0].root);
+                    }
+                    return *this;
+                }
+
+                inline sparse_merkle_tree &erase(const key_type &key) {
+                    return update(key, empty_[0]);
+                }
+
+                /*!
+                 * @brief Leaf held by the key, the empty leaf if it is not set
+                 */
+                inline const digest_type &get(const key_type &key) const {
+                    typename leaves_type::const_iterator it = leaves_.find(key);
+                    return it == leaves_.end() ? empty_[0] : it->second.leaf;
+                }
+
+                inline digest_type root() const {
+                    return subtree(KeyBits, key_type()).root;
+                }
+
+                /*!
+                 * @brief Number of keys set
+                 */
+                inline std::size_t size() const {
+                    return leaves_.size();
+                }
+
+                /*!
+                 * @brief Number of inner nodes held in memory, those with two keys or more below them
+                 */
+                inline std::size_t stored_nodes() const {
+                    std::size_t n = 0;
+                    for (const level_type &level : nodes_) {
+                        n += level.size();
+                    }
+                    return n;
+                }
+
+                /*!
+                 * @brief Root of an empty subtree of the given height
+                 */
+                inline const digest_type &empty_root(std::size_t height) const {
+                    BOOST_ASSERT(height <= KeyBits);
+                    return empty_[height];
+                }
+
+                /*!
+                 * @brief Proof of the leaf held by the key, of absence if it is not set
+                 */
+                inline proof_type proof(const key_type &key) const {
+                    std::vector<digest_type> siblings(KeyBits);
+                    key_type sibling = key;
+                    for (std::size_t h = 0; h != KeyBits; ++h) {
+                        key_functions::flip(sibling, h);
+                        siblings[h] = subtree(h, sibling).root;
+                        key_functions::clear(sibling, h);
+                    }
+                    return proof_type(key, std::move(siblings));
+                }
+
+            protected:
+                // The only key of the subtree at height h under prefix, if it holds exactly one
+                inline typename leaves_type::const_iterator lone_key(std::size_t h, const key_type &prefix) const {
+                    typename leaves_type::const_iterator it = leaves_.lower_bound(prefix);
+                    if (it == leaves_.end() || !key_functions::in_subtree(it->first, prefix, h)) {
+                        return leaves_.end();
+                    }
+                    return it;
+                }
+
+                // Subtree at height h on the path of key, whose branch bits below h are cleared
+                inline subtree_type subtree(std::size_t h, const key_type &key) const {
+                    if (h) {
+                        typename level_type::const_iterator node = nodes_[h].find(key);
+                        if (node != nodes_[h].end()) {
+                            return {node->second, 2};
+                        }
+                    }
+
+                    typename leaves_type::const_iterator it = lone_key(h, key);
+                    if (it == leaves_.end()) {
+                        return {empty_[h], 0};
+                    }
+                    if (it->second.top == h) {
+                        return {it->second.top_root, 1};
+                    }
+
+                    // Below the top of a single-key subtree every sibling is empty
+                    digest_type node = it->second.leaf;
+                    std::array<digest_type, 2> children;
+                    for (std::size_t i = 0; i != h; ++i) {
+                        if (key_functions::bit(it->first, i)) {
+                            children = {empty_[i], node};
+                        } else {
+                            children = {node, empty_[i]};
+                        }
+                        node = node_hasher_type::hash_node(children.data(), children.size());
+                    }
+                    return {node, 1};
+                }
+
+                inline void set_top(std::size_t h, const key_type &prefix, const digest_type &root) {
+                    leaf_entry &entry = leaves_.find(lone_key(h, prefix)->first)->second;
+                    entry.top = h;
+                    entry.top_root = root;
+                }
+
+                inline void store(std::size_t h, const std::vector<key_type> &keys,
+                                  const std::vector<subtree_type> &subtrees) {
+                    for (std::size_t i = 0; i != keys.size(); ++i) {
+                        if (subtrees[i].keys < 2) {
+                            nodes_[h].erase(keys[i]);
+                        } else {
+                            nodes_[h][keys[i]] = subtrees[i].root;
+                        }
+                    }
+                }
+
+                static inline bool same_parent(key_type a, key_type b, std::size_t h) {
+                    key_functions::clear(a, h);
+                    key_functions::clear(b, h);
+                    return a == b;
+                }
+
+                inline std::size_t level_threads(std::size_t n) const {
+                    return std::min(threads_, std::max<std::size_t>(n / grain_nodes, 1));
+                }
+
+                std::size_t threads_;
+                std::array<digest_type, KeyBits + 1> empty_;
+                leaves_type leaves_;
+                // Nodes with two keys or more below them, by height; the leaf level is left empty
+                std::vector<level_type> nodes_;
+            };
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SPARSE_MERKLE_TREE_HPP
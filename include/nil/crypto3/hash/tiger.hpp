@@ -74,6 +74,12 @@ namespace nil {
                     state[1] = B - state[1];
                     state[2] += C;
                 }
+
+                static inline void process_blocks(state_type &state, const block_type *blocks, std::size_t n) {
+                    for (; n; --n) {
+                        process_block(state, *blocks++);
+                    }
+                }
             };
 
             /*!
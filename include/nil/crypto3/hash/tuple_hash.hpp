@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_TUPLE_HASH_HPP
+#define CRYPTO3_HASH_TUPLE_HASH_HPP
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <nil/crypto3/hash/cshake.hpp>
+#include <nil/crypto3/hash/detail/contiguous_range.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief TupleHash128/TupleHash256 and their XOF variants (NIST SP 800-185). Every
+             * update() call adds one element of the tuple, encoded with its length, so ("ab", "c")
+             * and ("a", "bc") hash differently.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             */
+            template<std::size_t SecurityBits>
+            class tuple_hash {
+                typedef detail::cshake_functions functions_type;
+
+            public:
+                typedef cshake_xof<SecurityBits> xof_type;
+
+                tuple_hash() : tuple_hash(nullptr, 0) {
+                }
+
+                tuple_hash(const std::uint8_t *customization, std::size_t customization_size) :
+                    xof_(function_name().data(), function_name().size(), customization, customization_size),
+                    xof_started_(false) {
+                }
+
+                template<typename CustomizationRange>
+                explicit tuple_hash(const CustomizationRange &customization) :
+                    tuple_hash(detail::octets(customization), std::size(customization)) {
+                }
+
+                /*!
+                 * @brief Appends one element to the tuple
+                 */
+                inline tuple_hash &update(const std::uint8_t *data, std::size_t n) {
+                    functions_type::encode_string(xof_, data, n);
+                    return *this;
+                }
+
+                template<typename ContiguousRange>
+                inline tuple_hash &update(const ContiguousRange &element) {
+                    return update(detail::octets(element), std::size(element));
+                }
+
+                /*!
+                 * @brief Writes the n-octet hash of the tuple seen so far and starts a new tuple
+                 */
+                inline void finalize(std::uint8_t *out, std::size_t n) {
+                    functions_type::encoded_integer_type length =
+                        functions_type::right_encode(static_cast<std::uint64_t>(n) * octet_bits);
+                    xof_.update(length.data(), length.size);
+                    xof_.squeeze(out, n);
+                    reset();
+                }
+
+                inline std::vector<std::uint8_t> finalize(std::size_t n) {
+                    std::vector<std::uint8_t> out(n);
+                    finalize(out.data(), n);
+                    return out;
+                }
+
+                /*!
+                 * @brief TupleHashXOF: writes the next n octets of output of arbitrary length
+                 */
+                inline void squeeze(std::uint8_t *out, std::size_t n) {
+                    if (!xof_started_) {
+                        functions_type::encoded_integer_type length = functions_type::right_encode(0);
+                        xof_.update(length.data(), length.size);
+                        xof_started_ = true;
+                    }
+                    xof_.squeeze(out, n);
+                }
+
+                inline void reset() {
+                    xof_.reset();
+                    xof_started_ = false;
+                }
+
+            protected:
+                static inline const std::array<std::uint8_t, 9> &function_name() {
+                    static const std::array<std::uint8_t, 9> name = {'T', 'u', 'p', 'l', 'e', 'H', 'a', 's', 'h'};
+                    return name;
+                }
+
+                xof_type xof_;
+                bool xof_started_;
+            };
+
+            typedef tuple_hash<128> tuple_hash128;
+            typedef tuple_hash<256> tuple_hash256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_TUPLE_HASH_HPP
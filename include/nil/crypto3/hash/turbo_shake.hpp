@@ -0,0 +1,70 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_HASH_TURBO_SHAKE_HPP
+#define CRYPTO3_HASH_TURBO_SHAKE_HPP
+
+#include <cstdint>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/shake.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            /*!
+             * @brief TurboSHAKE128/TurboSHAKE256 (RFC 9861): SHAKE on Keccak-p[1600, 12], the last 12
+             * rounds of Keccak-f[1600], with a domain separation octet chosen by the caller. Half the
+             * rounds make it about twice as fast as SHAKE for the same rate.
+             *
+             * @ingroup hashes
+             *
+             * @tparam SecurityBits 128 or 256
+             */
+            template<std::size_t SecurityBits>
+            class turbo_shake_xof : public shake_xof<SecurityBits, 12> {
+                typedef shake_xof<SecurityBits, 12> base_type;
+
+            public:
+                constexpr static const std::size_t rounds = 12;
+
+                constexpr static const std::uint8_t domain_separator = 0x1F;
+
+                /*!
+                 * @param domain Domain separation octet, 0x01 to 0x7F
+                 */
+                explicit turbo_shake_xof(std::uint8_t domain = domain_separator) : base_type(domain) {
+                    BOOST_ASSERT_MSG(domain >= 0x01 && domain <= 0x7F, "TurboSHAKE domain separator out of range");
+                }
+            };
+
+            typedef turbo_shake_xof<128> turbo_shake128;
+            typedef turbo_shake_xof<256> turbo_shake256;
+        }    // namespace hashes
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_TURBO_SHAKE_HPP
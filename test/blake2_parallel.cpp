@@ -0,0 +1,239 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE blake2_parallel_test
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/blake2bp.hpp>
+#include <nil/crypto3/hash/blake2sp.hpp>
+#include <nil/crypto3/hash/detail/blake2_multi_buffer.hpp>
+
+using namespace nil::crypto3;
+
+// Keyed vectors follow the BLAKE2 reference known-answer tests: the key is 00 01 02 ... of the
+// maximum key size and the message 00 01 02 ... of the given length
+
+std::vector<std::uint8_t> sequence(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i);
+    }
+    return v;
+}
+
+template<typename Hash>
+std::string hash_in_pieces(const std::vector<std::uint8_t> &m, std::size_t piece,
+                           const std::vector<std::uint8_t> &key = {}) {
+    Hash h(key);
+    for (std::size_t i = 0; i < m.size(); i += piece) {
+        h.update(m.data() + i, std::min(piece, m.size() - i));
+    }
+    return std::to_string(h.finalize());
+}
+
+BOOST_AUTO_TEST_SUITE(blake2bp_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2bp_keyed_reference) {
+    const std::vector<std::uint8_t> key = sequence(64);
+    const std::vector<std::pair<std::size_t, const char *>> vectors = {
+        {0, "9d9461073e4eb640a255357b839f394b838c6ff57c9b686a3f76107c1066728f"
+            "3c9956bd785cbc3bf79dc2ab578c5a0c063b9d9c405848de1dbe821cd05c940a"},
+        {1, "ff8e90a37b94623932c59f7559f26035029c376732cb14d41602001cbb73adb7"
+            "9293a2dbda5f60703025144d158e2735529596251c73c0345ca6fccb1fb1e97e"},
+        {255, "96fbcbb60bd313b8845033e5bc058a38027438572d7e7957f3684f6268aadd3a"
+              "d08d21767ed6878685331ba98571487e12470aad669326716e46667f69f8d7e8"},
+        {256, "9915a97dc3df81251f1778dfc4fa02a2ad8cfc8f89b51ac19e90a45f37206901"
+              "5d8b4e877b330d7e53d1ef636fa7b6f8736b2e049aa98d2f7c85c9615df9e2ec"},
+        {2049, "8f9d23fe78af91f8d6a7aec605c3090aa9b096a0708dbb63c6b59f2e49de121b"
+               "53064178d1d322f23fef93f31fbca9d46e2d31f9dc6d416f2cf3de6a8596f196"}};
+
+    for (const auto &v : vectors) {
+        hashes::blake2bp<> h(key);
+        h.update(sequence(v.first));
+        BOOST_CHECK_EQUAL(std::to_string(h.finalize()), v.second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blake2bp_unkeyed) {
+    hashes::blake2bp<> h;
+    BOOST_CHECK_EQUAL(std::to_string(h.finalize()),
+                      "b5ef811a8038f70b628fa8b294daae7492b1ebe343a80eaabbf1f6ae664dd67b"
+                      "9d90b0120791eab81dc96985f28849f6a305186a85501b405114bfa678df9380");
+
+    h.update(sequence(2049));
+    BOOST_CHECK_EQUAL(std::to_string(h.finalize()),
+                      "67c9e065513f30f5eecdb93f384d93d9bab10790b565ac586ba87942702171d3"
+                      "7aec3d688c02e948fe9c7e1c35d2e311d0362ed922d1a694972f8830cb25d8c2");
+
+    // Leaves hash with the digest length of the root in their parameter block
+    hashes::blake2bp<256> h256;
+    h256.update(std::string("abc"));
+    BOOST_CHECK_EQUAL(std::to_string(h256.finalize()), "4792f00c05827a437fc55481e447eea1c9a39add28087733b3e53f1c04430dc7");
+}
+
+BOOST_AUTO_TEST_CASE(blake2bp_incremental) {
+    const std::vector<std::uint8_t> m = sequence(5000);
+    const std::string whole = hash_in_pieces<hashes::blake2bp<>>(m, m.size(), sequence(17));
+
+    for (std::size_t piece : {1, 127, 128, 512, 1025}) {
+        BOOST_CHECK_EQUAL(hash_in_pieces<hashes::blake2bp<>>(m, piece, sequence(17)), whole);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(blake2sp_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2sp_keyed_reference) {
+    const std::vector<std::uint8_t> key = sequence(32);
+    const std::vector<std::pair<std::size_t, const char *>> vectors = {
+        {0, "715cb13895aeb678f6124160bff21465b30f4f6874193fc851b4621043f09cc6"},
+        {1, "40578ffa52bf51ae1866f4284d3a157fc1bcd36ac13cbdcb0377e4d0cd0b6603"},
+        {255, "0c8a36597d7461c63a94732821c941856c668376606c86a52de0ee4104c615db"},
+        {256, "e5f46751ed888c5fb7436c3088dea8d398066a43e521cb13133438f2c80e60e5"},
+        {2049, "d3a1ab2f4a46798aa1153a3317a14946c9ee2e7a5ef81e4047cb657664075039"}};
+
+    for (const auto &v : vectors) {
+        hashes::blake2sp<> h(key);
+        h.update(sequence(v.first));
+        BOOST_CHECK_EQUAL(std::to_string(h.finalize()), v.second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blake2sp_unkeyed) {
+    hashes::blake2sp<> h;
+    BOOST_CHECK_EQUAL(std::to_string(h.finalize()), "dd0e891776933f43c7d032b08a917e25741f8aa9a12c12e1cac8801500f2ca4f");
+
+    h.update(sequence(2049));
+    BOOST_CHECK_EQUAL(std::to_string(h.finalize()), "e49a04e1acbb4b17a75a1a77434baae49650b6c8dbf0670a5cedcd29e3bb45df");
+
+    hashes::blake2sp<128> h128;
+    h128.update(std::string("abc"));
+    BOOST_CHECK_EQUAL(std::to_string(h128.finalize()), "88f52143a5acf10702b0a0de90530472");
+}
+
+BOOST_AUTO_TEST_CASE(blake2sp_incremental) {
+    const std::vector<std::uint8_t> m = sequence(5000);
+    const std::string whole = hash_in_pieces<hashes::blake2sp<>>(m, m.size(), sequence(17));
+
+    for (std::size_t piece : {1, 63, 64, 512, 1025}) {
+        BOOST_CHECK_EQUAL(hash_in_pieces<hashes::blake2sp<>>(m, piece, sequence(17)), whole);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#ifdef CRYPTO3_HASH_BLAKE2_MULTI_BUFFER
+template<typename Policy>
+typename Policy::block_type load_block(const std::uint8_t *p) {
+    typename Policy::block_type block;
+    for (std::size_t t = 0; t != block.size(); ++t) {
+        block[t] = 0;
+        for (std::size_t i = 0; i != Policy::word_bits / 8; ++i) {
+            block[t] |= typename Policy::word_type(*p++) << (i * 8);
+        }
+    }
+    return block;
+}
+
+// Runs every multi-buffer backend the host supports, from the widest down, against the scalar compressor
+template<typename Policy, typename Compressor>
+void check_multi_buffer_backends() {
+    typedef hashes::detail::blake2_multi_buffer_dispatch<Policy> dispatch_type;
+    typedef typename Policy::word_type word_type;
+    typedef typename Policy::state_type state_type;
+
+    constexpr std::size_t lanes = dispatch_type::stripe_lanes;
+    constexpr std::size_t block_octets = Policy::block_bits / 8;
+    constexpr std::size_t stripes = 3;
+    const std::vector<std::uint8_t> data = sequence(stripes * lanes * block_octets);
+
+    hashes::detail::cpu_features narrower = hashes::detail::cpu_features::host();
+    narrower.avx512f = false;
+    hashes::detail::cpu_features narrowest = narrower;
+    narrowest.avx2 = false;
+
+    for (const hashes::detail::cpu_features &features : {hashes::detail::cpu_features::host(), narrower, narrowest}) {
+        const typename dispatch_type::backend_type backend = dispatch_type::select(features);
+
+        // Lane l takes blocks l, l + lanes, ... after a first block of its own
+        std::array<std::array<word_type, lanes>, Policy::state_words> h;
+        std::array<state_type, lanes> expected;
+        for (std::size_t l = 0; l != lanes; ++l) {
+            expected[l] = Policy::iv;
+            expected[l][0] ^= l;
+            for (std::size_t i = 0; i != Policy::state_words; ++i) {
+                h[i][l] = expected[l][i];
+            }
+        }
+        backend.compress_stripes(h[0].data(), data.data(), stripes, block_octets);
+        for (std::size_t s = 0; s != stripes; ++s) {
+            for (std::size_t l = 0; l != lanes; ++l) {
+                Compressor::process_block(expected[l],
+                                          load_block<Policy>(data.data() + (s * lanes + l) * block_octets),
+                                          (s + 2) * block_octets * 8);
+            }
+        }
+        for (std::size_t l = 0; l != lanes; ++l) {
+            for (std::size_t i = 0; i != Policy::state_words; ++i) {
+                BOOST_CHECK_EQUAL(h[i][l], expected[l][i]);
+            }
+        }
+
+        // A count no backend's lanes divide
+        std::vector<state_type> states(13), reference(13);
+        for (std::size_t n = 0; n != states.size(); ++n) {
+            states[n] = Policy::iv;
+            states[n][1] ^= n;
+            reference[n] = states[n];
+        }
+        const typename Policy::block_type block = load_block<Policy>(data.data());
+        backend.compress_blocks(states.data(), states.size(), block, block_octets, 0, ~word_type());
+        for (std::size_t n = 0; n != states.size(); ++n) {
+            Compressor::process_block(reference[n], block, block_octets * 8, ~word_type());
+            BOOST_CHECK(states[n] == reference[n]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(blake2_multi_buffer_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2b_multi_buffer_backends) {
+    check_multi_buffer_backends<hashes::detail::blake2b_policy<512>, hashes::blake2b_compressor<512>>();
+}
+
+BOOST_AUTO_TEST_CASE(blake2s_multi_buffer_backends) {
+    check_multi_buffer_backends<hashes::detail::blake2s_policy<256>, hashes::blake2s_compressor<256>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -27,6 +27,11 @@
 #define BOOST_TEST_MODULE blake2b_test
 
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -41,6 +46,8 @@
 #include <nil/crypto3/hash/blake2b.hpp>
 #include <nil/crypto3/hash/hash_state.hpp>
 
+#include <dispatch.hpp>
+
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
 
@@ -296,6 +303,17 @@ BOOST_AUTO_TEST_CASE(blake2b_longmsg_byte1) {
     BOOST_CHECK_EQUAL("3d6c866ebaa149e0c6ad8ba5e9a685e1ad56d81a00fb99d9020f11c0", std::to_string(d).data());
 }
 
+BOOST_AUTO_TEST_CASE(blake2b_512_longmsg_range) {
+    // Million repetitions of "a"
+    std::string a(1000000, 'a');
+    hashes::blake2b<512>::digest_type d = hash<hashes::blake2b<512>>(a);
+
+    BOOST_CHECK_EQUAL(
+        "98fb3efb7206fd19ebf69b6f312cf7b64e3b94dbe1a17107913975a793f177e1"
+        "d077609d7fba363cbba00d05f7aa4e4fa8715d6428104c0a75643b0ff3fd3eaf",
+        std::to_string(d).data());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(blake2b_initializer_list_test_suite)
@@ -674,3 +692,150 @@ BOOST_AUTO_TEST_CASE(blake2b_512_preprocessor2) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(blake2b_parameters_test_suite)
+
+std::vector<std::uint8_t> blake2b_octets(const std::string &s) {
+    return std::vector<std::uint8_t>(s.begin(), s.end());
+}
+
+std::vector<std::uint8_t> blake2b_sequence(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i);
+    }
+    return v;
+}
+
+BOOST_AUTO_TEST_CASE(blake2b_512_keyed_reference) {
+    // Keyed test vectors of the BLAKE2 reference implementation, key 00 01 ... 3f
+    hashes::blake2b_hasher<512> mac(blake2b_sequence(64));
+
+    BOOST_CHECK_EQUAL(
+        "10ebb67700b1868efb4417987acf4690ae9d972fb7a590c2f02871799aaa4786"
+        "b5e996e8f0f4eb981fc214b005f42d2ff4233499391653df7aefcbc13fc51568",
+        std::to_string(mac.finalize()).data());
+
+    mac.update(blake2b_sequence(1));
+    BOOST_CHECK_EQUAL(
+        "961f6dd1e4dd30f63901690c512e78e4b45e4742ed197c3c5e45c549fd25f2e4"
+        "187b0bc9fe30492b16b0d0bc4ef9b0f34c7003fac09a5ef1532e69430234cebd",
+        std::to_string(mac.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2b_keyed_multiblock) {
+    std::vector<std::uint8_t> m(300);
+    for (std::size_t i = 0; i != m.size(); ++i) {
+        m[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+
+    hashes::blake2b_hasher<256> mac(blake2b_octets("secret key"));
+    for (std::size_t chunk : {1, 64, 128, 129, 300}) {
+        for (std::size_t i = 0; i < m.size(); i += chunk) {
+            mac.update(m.data() + i, std::min(chunk, m.size() - i));
+        }
+        BOOST_CHECK_EQUAL("d0c0e78e72536dc4e58de182e5186396c8761e593f7df77c324bac382512c278",
+                          std::to_string(mac.finalize()).data());
+    }
+
+    // A message of exactly one block follows the key block
+    hashes::blake2b_hasher<512> block_mac(blake2b_sequence(64));
+    block_mac.update(m.data(), 128);
+    BOOST_CHECK_EQUAL(
+        "b890c4cfabce8bf698d74bdd2e630627f49c096096af6960dd6e5f4c9ec6b1fa"
+        "3c81d8d6ba2fb6abe0214812d00f166114b49a59eb9217d138d1a141673c4483",
+        std::to_string(block_mac.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2b_salt_and_personalization) {
+    hashes::blake2b_hasher<256> h(std::vector<std::uint8_t>(), blake2b_octets("0123456789abcdef"),
+                                  blake2b_octets("ZcashPersonal__x"));
+    h.update(blake2b_octets("abc"));
+    BOOST_CHECK_EQUAL("dd7e331ef0938014394a561b87aec7d4b4fc5ea3888bd69ddad7dfd265a3ecad",
+                      std::to_string(h.finalize()).data());
+
+    // Shorter personalization strings are zero-padded
+    hashes::blake2b_hasher<256> zcash(std::vector<std::uint8_t>(), std::vector<std::uint8_t>(),
+                                      blake2b_octets("Zcash_PH"));
+    BOOST_CHECK_EQUAL("567642b1ccc50b40aa9d3d2569d6641da3e3f0cb1e20f2fe1d47234ffd6a5d05",
+                      std::to_string(zcash.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2b_whole_block_messages) {
+    // A full last block is compressed once, as the final block
+    hashes::hasher<hashes::blake2b<256>> h;
+    h.update(std::vector<std::uint8_t>(128, 'a'));
+    BOOST_CHECK_EQUAL("ae2aa48507885c4c950fb809b2076f959cde9f8ea6da260d9a3587df33dac450",
+                      std::to_string(h.finalize()).data());
+
+    h.update(std::vector<std::uint8_t>(256, 'a'));
+    BOOST_CHECK_EQUAL("eae4d3a7627549b383179dc18049964f91a6fed14c9f3fb26705eda3eeda5558",
+                      std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2b_default_parameters) {
+    typedef hashes::blake2b_hasher<512>::parameter_block_type parameter_block_type;
+    constexpr parameter_block_type params(64);
+    BOOST_STATIC_ASSERT(params.to_octets()[0] == 64 && params.to_octets()[2] == 1 && params.to_octets()[3] == 1);
+
+    hashes::blake2b_hasher<512> h(params);
+    h.update(blake2b_octets("abc"));
+    BOOST_CHECK_EQUAL(
+        "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+        "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923",
+        std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(blake2b_backend_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2b_backend_name) {
+    const char *backend = hashes::blake2b_backend();
+    const char *known[] = {"avx2", "generic"};
+
+    BOOST_CHECK(std::any_of(std::begin(known), std::end(known),
+                            [backend](const char *name) { return !std::strcmp(backend, name); }));
+}
+
+#if BOOST_ARCH_X86_64
+BOOST_AUTO_TEST_CASE(blake2b_dispatch_backends_agree) {
+    typedef hashes::detail::blake2b_policy<512> policy_type;
+    typedef hashes::detail::blake2b_dispatch_impl<policy_type> dispatch_type;
+
+    lcg_words input(0x9e3779b97f4a7c15);
+    policy_type::state_type state;
+    input.fill(state);
+    std::array<policy_type::block_type, 3> blocks;
+    input.fill_blocks(blocks);
+
+    // Every counter and flag word takes part
+    policy_type::state_type expected = state;
+    hashes::detail::blake2b_impl<policy_type>::compress(expected, blocks[0], 1024, 1, ~UINT64_C(0), ~UINT64_C(0));
+
+    // A run of blocks in one call, the counter advancing from block to block
+    typedef policy_type::word_type word_type;
+    const std::uint64_t t = 1024;
+    policy_type::state_type expected_run = state;
+    for (std::size_t b = 0; b != blocks.size(); ++b) {
+        const std::uint64_t seen = t + b * policy_type::block_bits / 8;
+        hashes::detail::blake2b_impl<policy_type>::compress(expected_run, blocks[b], static_cast<word_type>(seen),
+                                                         static_cast<word_type>(seen >> 63 >> 1), 0, 0);
+    }
+
+    for_each_backend<dispatch_type>(
+        {&hashes::detail::cpu_features::avx2}, [&](const dispatch_type::backend_type &backend) {
+            policy_type::state_type compressed = state;
+            backend.compress(compressed, blocks[0], 1024, 1, ~UINT64_C(0), ~UINT64_C(0));
+            BOOST_CHECK(compressed == expected);
+
+            compressed = state;
+            backend.compress_blocks(compressed, blocks.data(), blocks.size(), t);
+            BOOST_CHECK(compressed == expected_run);
+        });
+
+    BOOST_CHECK_EQUAL(dispatch_type::backend().name, hashes::blake2b_backend());
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
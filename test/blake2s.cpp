@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE blake2s_test
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/blake2s.hpp>
+
+#include <dispatch.hpp>
+
+using namespace nil::crypto3;
+
+std::vector<std::uint8_t> blake2s_octets(const std::string &s) {
+    return std::vector<std::uint8_t>(s.begin(), s.end());
+}
+
+std::vector<std::uint8_t> blake2s_sequence(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i);
+    }
+    return v;
+}
+
+BOOST_AUTO_TEST_SUITE(blake2s_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2s_256_shortmsg) {
+    hashes::hasher<hashes::blake2s<256>> h;
+    BOOST_CHECK_EQUAL("69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9",
+                      std::to_string(h.finalize()).data());
+
+    // RFC 7693, Appendix B
+    h.update(blake2s_octets("abc"));
+    BOOST_CHECK_EQUAL("508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982",
+                      std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2s_160_shortmsg) {
+    hashes::hasher<hashes::blake2s<160>> h;
+    h.update(blake2s_octets("abc"));
+    BOOST_CHECK_EQUAL("5ae3b99be29b01834c3b508521ede60438f8de17", std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2s_whole_block_messages) {
+    // A full last block is compressed once, as the final block
+    hashes::hasher<hashes::blake2s<256>> h;
+    h.update(std::vector<std::uint8_t>(64, 'a'));
+    BOOST_CHECK_EQUAL("651d2f5f20952eacaea2fba2f2af2bcd633e511ea2d2e4c9ae2ac0d9ffb7b252",
+                      std::to_string(h.finalize()).data());
+
+    h.update(std::vector<std::uint8_t>(128, 'a'));
+    BOOST_CHECK_EQUAL("3ac477e27353f9019b81694afe60c8049403784f91a58288428ea318bfa82809",
+                      std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(blake2s_parameters_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2s_256_keyed_reference) {
+    // Keyed test vectors of the BLAKE2 reference implementation, key 00 01 ... 1f
+    hashes::blake2s_hasher<256> mac(blake2s_sequence(32));
+    BOOST_CHECK_EQUAL("48a8997da407876b3d79c0d92325ad3b89cbb754d86ab71aee047ad345fd2c49",
+                      std::to_string(mac.finalize()).data());
+
+    mac.update(blake2s_sequence(1));
+    BOOST_CHECK_EQUAL("40d15fee7c328830166ac3f918650f807e7e01e177258cdc0a39b11f598066f1",
+                      std::to_string(mac.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2s_keyed_multiblock) {
+    std::vector<std::uint8_t> m(300);
+    for (std::size_t i = 0; i != m.size(); ++i) {
+        m[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+
+    hashes::blake2s_hasher<256> mac(blake2s_octets("secret key"));
+    for (std::size_t chunk : {1, 32, 64, 65, 300}) {
+        for (std::size_t i = 0; i < m.size(); i += chunk) {
+            mac.update(m.data() + i, std::min(chunk, m.size() - i));
+        }
+        BOOST_CHECK_EQUAL("65f6ddece53bbc8c3c051df34d232f618e476c0847f6f5d5b0c401fc57fe01f3",
+                          std::to_string(mac.finalize()).data());
+    }
+
+    // A message of exactly one block follows the key block
+    hashes::blake2s_hasher<256> block_mac(blake2s_sequence(32));
+    block_mac.update(m.data(), 64);
+    BOOST_CHECK_EQUAL("ce3c22b930e6395797de1e490600d305294ff2e30eb187bb63120e3f5e3fc129",
+                      std::to_string(block_mac.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake2s_salt_and_personalization) {
+    hashes::blake2s_hasher<256> h(std::vector<std::uint8_t>(), blake2s_octets("saltsalt"),
+                                  blake2s_octets("Zcash_PH"));
+    h.update(blake2s_octets("abc"));
+    BOOST_CHECK_EQUAL("441f512a7c59e2d2ba76bb2e0883b85c6da0f9667a2517eeaa8a1bdafbfbb52b",
+                      std::to_string(h.finalize()).data());
+
+    hashes::blake2s_hasher<256> zcash(std::vector<std::uint8_t>(), std::vector<std::uint8_t>(),
+                                      blake2s_octets("Zcash_PH"));
+    BOOST_CHECK_EQUAL("479cbfb374ecacb5f567b8185ddabb6d1ee703df40fc0dc9fe34d0c9f9e2b6b5",
+                      std::to_string(zcash.finalize()).data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(blake2s_backend_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2s_backend_name) {
+    const char *backend = hashes::blake2s_backend();
+    const char *known[] = {"sse4.1", "generic"};
+
+    BOOST_CHECK(std::any_of(std::begin(known), std::end(known),
+                            [backend](const char *name) { return !std::strcmp(backend, name); }));
+}
+
+#if BOOST_ARCH_X86_64
+BOOST_AUTO_TEST_CASE(blake2s_dispatch_backends_agree) {
+    typedef hashes::detail::blake2s_policy<256> policy_type;
+    typedef hashes::detail::blake2s_dispatch_impl<policy_type> dispatch_type;
+
+    lcg_words input(0x9e3779b97f4a7c15);
+    policy_type::state_type state;
+    input.fill(state);
+    std::array<policy_type::block_type, 3> blocks;
+    input.fill_blocks(blocks);
+
+    // Every counter and flag word takes part
+    policy_type::state_type expected = state;
+    hashes::detail::blake2s_impl<policy_type>::compress(expected, blocks[0], 1024, 1, ~UINT32_C(0), ~UINT32_C(0));
+
+    // A run of blocks in one call, the counter carrying into its high word on the way
+    typedef policy_type::word_type word_type;
+    const std::uint64_t t = UINT64_C(0xffffffc0);
+    policy_type::state_type expected_run = state;
+    for (std::size_t b = 0; b != blocks.size(); ++b) {
+        const std::uint64_t seen = t + b * policy_type::block_bits / 8;
+        hashes::detail::blake2s_impl<policy_type>::compress(expected_run, blocks[b], static_cast<word_type>(seen),
+                                                         static_cast<word_type>(seen >> 31 >> 1), 0, 0);
+    }
+
+    for_each_backend<dispatch_type>(
+        {&hashes::detail::cpu_features::sse4_1}, [&](const dispatch_type::backend_type &backend) {
+            policy_type::state_type compressed = state;
+            backend.compress(compressed, blocks[0], 1024, 1, ~UINT32_C(0), ~UINT32_C(0));
+            BOOST_CHECK(compressed == expected);
+
+            compressed = state;
+            backend.compress_blocks(compressed, blocks.data(), blocks.size(), t);
+            BOOST_CHECK(compressed == expected_run);
+        });
+
+    BOOST_CHECK_EQUAL(dispatch_type::backend().name, hashes::blake2s_backend());
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
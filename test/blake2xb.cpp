@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE blake2xb_test
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/blake2xb.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+// Keyed vectors follow the BLAKE2Xb reference known-answer tests: the key is 00 01 ... 3f and the
+// message 00 01 ... ff
+
+std::vector<std::uint8_t> sequence(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i);
+    }
+    return v;
+}
+
+BOOST_AUTO_TEST_SUITE(blake2xb_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake2xb_keyed_reference) {
+    const std::vector<std::pair<std::uint32_t, std::string>> expected = {
+        {1, "64"},
+        {64,
+         "4324561d76c370ef35ac36a4adf8f3773a50d86504bd284f71f7ce9e2bc4c1f1"
+         "d34a7fb2d67561d101955d448b67577eb30dfee96a95c7f921ef53e20be8bc44"},
+        {65,
+         "78f0ed6e220b3da3cc9381563b2f72c8dc830cb0f39a48c6ae479a6a78dcfa94"
+         "002631dec467e9e9b47cc8f0887eb680e340aec3ec009d4a33d241533c76c8ca8c"},
+        {130,
+         "83bed0d556798f2b419f7056e6d3ffada06e939b95a688d0ec8c6ac5ea45ab73"
+         "a4cf01043e0a170766e21395f27ab4b78c435f5f0dfe6e93ab80df38610e4115"
+         "8429ddf20296f53a06a017723359fe22dc08b5da33f0800a4fe50118e8d7eab2"
+         "f83a85cd764bf8a166903bd0e9dcfeeceba44ff4ca4439846458d31ea2bb5646"
+         "45d1"}};
+
+    for (const auto &e : expected) {
+        hashes::blake2xb x(e.first, sequence(64));
+        x.update(sequence(256));
+        BOOST_CHECK_EQUAL(e.second, to_hex(x.finalize()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blake2xb_squeeze_matches_finalize) {
+    hashes::blake2xb x(1000, sequence(64));
+    x.update(sequence(256));
+    const std::vector<std::uint8_t> expected = x.finalize();
+
+    x.update(sequence(256));
+    std::vector<std::uint8_t> out;
+    for (std::size_t n : {1, 7, 64, 100, 128, 200, 500}) {
+        std::vector<std::uint8_t> part = x.squeeze(n);
+        out.insert(out.end(), part.begin(), part.end());
+    }
+    BOOST_CHECK(out == expected);
+}
+
+BOOST_AUTO_TEST_CASE(blake2xb_unknown_length) {
+    hashes::blake2xb x;
+    x.update(sequence(256));
+    BOOST_CHECK_EQUAL(
+        "fb8dea91bb9ed97310d7efb7e7a4ac68b5b6c9f74203f6be1de786faf8c69a74"
+        "5f9268a4679b46c12f4d1b5cffd0cf5d7b6b661431951183bc7216618ace2f0b"
+        "3a9ce66a9d74ba1dea51cf0ba8fa9e70a980dea6a64fcd2c08aaad0b338ca9fa"
+        "0d9eef46",
+        to_hex(x.finalize(100)));
+
+    // The stream is made of whole blocks, so it agrees with finalize() on them
+    x.update(sequence(256));
+    std::vector<std::uint8_t> stream = x.squeeze(3);
+    std::vector<std::uint8_t> rest = x.squeeze(64 * 1000 - 3);
+    stream.insert(stream.end(), rest.begin(), rest.end());
+    BOOST_CHECK_EQUAL("306d0bfa61a922ab179e3c818efe28e0fb14f63d1397c69e047fec9d9d946e63",
+                      to_hex(std::vector<std::uint8_t>(stream.end() - 32, stream.end())));
+}
+
+BOOST_AUTO_TEST_CASE(blake2xb_salt_and_personalization) {
+    hashes::blake2xb x(64, std::vector<std::uint8_t>(), std::string("saltsalt"), std::string("person"));
+    x.update(std::string("abc"));
+    BOOST_CHECK_EQUAL(
+        "0eb50fd1029f083f18fa32686cb34a12798f3ae44ab5665258e993577ab469d9"
+        "2e489c80530fad7f6e41d8ddfb26f993cca8255179fa3e67e3ca94fe2092b3f6",
+        to_hex(x.finalize()));
+}
+
+BOOST_AUTO_TEST_CASE(blake2xb_threads) {
+    for (std::size_t threads : {1, 3}) {
+        hashes::blake2xb x(100000, sequence(64), threads);
+        x.update(sequence(256));
+        std::vector<std::uint8_t> out = x.finalize();
+        BOOST_CHECK_EQUAL("66c864b87a0f4582b1b3870926f62cc0890a17c8498360c19036e81b4c61c2d8",
+                          to_hex(std::vector<std::uint8_t>(out.end() - 32, out.end())));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
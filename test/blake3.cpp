@@ -0,0 +1,295 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE blake3_test
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/blake3.hpp>
+
+#include <dispatch.hpp>
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::accumulators;
+
+// Extendable output vectors follow the BLAKE3 reference test vectors: the input is i % 251 for
+// octet i and 131 octets of output are checked
+
+const std::string blake3_key = "whats the Elephant's name again?";
+const std::string blake3_context = "BLAKE3 2019-12-27 16:29:52 test vectors context";
+
+std::vector<std::uint8_t> blake3_input(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i % 251);
+    }
+    return v;
+}
+
+BOOST_AUTO_TEST_SUITE(blake3_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake3_256_shortmsg) {
+    hashes::hasher<hashes::blake3<256>> h;
+    BOOST_CHECK_EQUAL("af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262",
+                      std::to_string(h.finalize()).data());
+
+    h.update(std::string("abc"));
+    BOOST_CHECK_EQUAL("6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85",
+                      std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake3_256_range) {
+    hashes::blake3<256>::digest_type d = hash<hashes::blake3<256>>(std::string("abc"));
+    BOOST_CHECK_EQUAL("6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85", std::to_string(d).data());
+
+    const std::vector<std::uint8_t> input = blake3_input(8193);
+    d = hash<hashes::blake3<256>>(input.begin(), input.end());
+    BOOST_CHECK_EQUAL("bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b", std::to_string(d).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake3_256_split_range) {
+    // Pieces end inside a block, on a chunk boundary and inside a chunk, before whole subtrees
+    const std::vector<std::uint8_t> input = blake3_input(102400);
+    const std::vector<std::size_t> splits = {5, 64, 1024, 1025, 3000, 8192, 8193, 70000, input.size()};
+
+    accumulator_set<hashes::blake3<256>> acc;
+    std::size_t first = 0;
+    for (std::size_t last : splits) {
+        hash<hashes::blake3<256>>(input.begin() + first, input.begin() + last, acc);
+        first = last;
+    }
+    hashes::blake3<256>::digest_type d = extract::hash<hashes::blake3<256>>(acc);
+
+    BOOST_CHECK_EQUAL("bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085", std::to_string(d).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake3_256_contiguous_range) {
+    // A whole vector reaches the chunk kernels in one run, through hash<>, an accumulator and a hasher
+    const std::vector<std::uint8_t> input = blake3_input(102400);
+
+    hashes::blake3_hasher<> threaded(std::size_t(4));
+    const std::string expected = std::to_string(threaded.update(input.data(), input.size()).finalize()).data();
+    BOOST_CHECK_EQUAL("bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085", expected);
+
+    hashes::blake3<256>::digest_type d = hash<hashes::blake3<256>>(input);
+    BOOST_CHECK_EQUAL(expected, std::to_string(d).data());
+
+    accumulator_set<hashes::blake3<256>> acc;
+    hash<hashes::blake3<256>>(std::vector<std::uint8_t>(input.begin(), input.begin() + 100), acc);
+    hash<hashes::blake3<256>>(std::vector<std::uint8_t>(input.begin() + 100, input.end()), acc);
+    BOOST_CHECK_EQUAL(expected, std::to_string(extract::hash<hashes::blake3<256>>(acc)).data());
+
+    hashes::blake3_hasher<> h;
+    BOOST_CHECK_EQUAL(expected, std::to_string(h.update(input).finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(blake3_hash_reference) {
+    const std::vector<std::pair<std::size_t, std::string>> expected = {
+        {0,
+         "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"
+         "e00f03e7b69af26b7faaf09fcd333050338ddfe085b8cc869ca98b206c08243a"
+         "26f5487789e8f660afe6c99ef9e0c52b92e7393024a80459cf91f476f9ffdbda"
+         "7001c22e159b402631f277ca96f2defdf1078282314e763699a31c5363165421"
+         "cce14d"},
+        {1,
+         "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"
+         "c3a6cb8bf623e20cdb535f8d1a5ffb86342d9c0b64aca3bce1d31f60adfa137b"
+         "358ad4d79f97b47c3d5e79f179df87a3b9776ef8325f8329886ba42f07fb138b"
+         "b502f4081cbcec3195c5871e6c23e2cc97d3c69a613eba131e5f1351f3f1da78"
+         "6545e5"},
+        {1023,
+         "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"
+         "a182d27a591b05592b15607500e1e8dd56bc6c7fc063715b7a1d737df5bad333"
+         "9c56778957d870eb9717b57ea3d9fb68d1b55127bba6a906a4a24bbd5acb2d12"
+         "3a37b28f9e9a81bbaae360d58f85e5fc9d75f7c370a0cc09b6522d9c8d822f2f"
+         "28f485"},
+        {1024,
+         "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"
+         "1cf8107265ecdaf8505b95d8fcec83a98a6a96ea5109d2c179c47a387ffbb404"
+         "756f6eeae7883b446b70ebb144527c2075ab8ab204c0086bb22b7c93d465efc5"
+         "7f8d917f0b385c6df265e77003b85102967486ed57db5c5ca170ba441427ed9a"
+         "fa684e"},
+        {1025,
+         "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"
+         "f4c4a22b4b399155358a994e52bf255de60035742ec71bd08ac275a1b51cc6bf"
+         "e332b0ef84b409108cda080e6269ed4b3e2c3f7d722aa4cdc98d16deb554e562"
+         "7be8f955c98e1d5f9565a9194cad0c4285f93700062d9595adb992ae68ff1280"
+         "0ab67a"},
+        {8193,
+         "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"
+         "b2282aa69be089359ea1154b9a9286c4a56af4de975a9aa4a5c497654914d279"
+         "bea60bb6d2cf7225a2fa0ff5ef56bbe4b149f3ed15860f78b4e2ad04e158e375"
+         "c1e0c0b551cd7dfc82f1b155c11b6b3ed51ec9edb30d133653bb5709d1dbd55f"
+         "4e1ff6"},
+        {102400,
+         "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"
+         "e01c59dab908c04c3342b816941a26d69c2605ebee5ec5291cc55e15b76146e6"
+         "745f0601156c3596cb75065a9c57f35585a52e1ac70f69131c23d611ce11ee4a"
+         "b1ec2c009012d236648e77be9295dd0426f29b764d65de58eb7d01dd42248204"
+         "f45f8e"}};
+
+    for (const auto &e : expected) {
+        hashes::blake3_hasher<> h;
+        h.update(blake3_input(e.first));
+        BOOST_CHECK_EQUAL(e.second, to_hex(h.finalize(131)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blake3_keyed_hash_reference) {
+    const std::vector<std::pair<std::size_t, std::string>> expected = {
+        {0,
+         "ae4678625074e1e12a36f8261166c2730d05292ef72375e6fe94562aed07ee76"
+         "3f0659c95c9f11af36095c5e0defb41eb9f5026499a33a37e7e0650204a0f06e"
+         "17291fc0e41421ede6f5ecd947cf0b15d38f6bf090e32a3d627a762426d24f76"
+         "86fb1f4b28c64e3ca53ef302498e6e9afafc4223a1ae4f7100071f965801b201"
+         "f6f6fa"},
+        {1025,
+         "f74e91d977353b5f0621ef81b5e816123a2b7df64c5051f2702e5a793dc8b68d"
+         "0bbb76da35b6ae819348c96922bb1eb09deb6001aa8ed5e717ba719376bd15e4"
+         "393330d78550246e17ed21a7c5e446b59f5b0a75a04177f080b3ad68d8656fdc"
+         "fe162e70fb69b322f42d928c41d04493793a52967a0aa038d329b3084b9ef9b9"
+         "ad7abb"},
+        {102400,
+         "41adc66ff16c9acccef604e4c601f2011cbf8bac1dba89af7f319cb2a58772b6"
+         "ba5563b895d5c343e3eed7dbc80703e27b6313020a572d33bf65a93b29b7f548"
+         "50e0da4f1046bcf79708f8304a27dce19021af33e9bcc3b15afc57412cf95227"
+         "01b07a1bbaff451698bd40c1a0a68392b51fdde76549987ce4c4fa8e3b6b0311"
+         "ace050"}};
+
+    for (const auto &e : expected) {
+        hashes::blake3_hasher<> h(blake3_key);
+        h.update(blake3_input(e.first));
+        BOOST_CHECK_EQUAL(e.second, to_hex(h.finalize(131)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blake3_derive_key_reference) {
+    const std::vector<std::pair<std::size_t, std::string>> expected = {
+        {0,
+         "2cc39783c223154fea8dfb7c1b1660f2ac2dcbd1c1de8277b0b0dd39b7e50d7d"
+         "905630c8be290dfcf3e6842f13bddd573c098c3f17361f1f206b8cad9d088aa4"
+         "a3f746752c6b0ce6a83b0da81d59649257cdf8eb3e9f7d4998e41021fac119de"
+         "efb896224ac99f860011f73609e6e0e4540f93b273e56547dfd3aa1a035ba668"
+         "9d89a0"},
+        {1025,
+         "effaa245f065fbf82ac186839a249707c3bddf6d3fdda22d1b95a3c970379bcb"
+         "5d31013a167509e9066273ab6e2123bc835b408b067d88f96addb550d96b6852"
+         "dad38e320b9d940f86db74d398c770f462118b35d2724efa13da97194491d96d"
+         "d37c3c09cbef665953f2ee85ec83d88b88d11547a6f911c8217cca46defa2751"
+         "e7f3ad"},
+        {102400,
+         "4652cff7a3f385a6103b5c260fc1593e13c778dbe608efb092fe7ee69df6e9c6"
+         "d83a3e041bc3a48df2879f4a0a3ed40e7c961c73eff740f3117a0504c2dff478"
+         "6d44fb17f1549eb0ba585e40ec29bf7732f0b7e286ff8acddc4cb1e23b87ff5d"
+         "824a986458dcc6a04ac83969b80637562953df51ed1a7e90a7926924d2763778"
+         "be8560"}};
+
+    for (const auto &e : expected) {
+        hashes::blake3_hasher<> h = hashes::blake3_hasher<>::derive_key(blake3_context);
+        h.update(blake3_input(e.first));
+        BOOST_CHECK_EQUAL(e.second, to_hex(h.finalize(131)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blake3_output_offset) {
+    hashes::blake3_hasher<> h;
+    h.update(blake3_input(1025));
+    std::vector<std::uint8_t> out(100);
+    h.finalize(out.data(), out.size(), 100);
+    BOOST_CHECK_EQUAL("c98e1d5f9565a9194cad0c4285f93700062d9595adb992ae68ff12800ab67afe"
+                      "a516f221cf7d1f8434fc36d8f6fbdf38d445c44d96ba3bb1d4a2e2ae9a53fd46"
+                      "d39307628a47f890cab6ac333aad48c0c11edf69e2a6437e8abf42d335327eee"
+                      "b329bbc9",
+                      to_hex(out));
+}
+
+BOOST_AUTO_TEST_CASE(blake3_threads) {
+    const std::vector<std::uint8_t> input = blake3_input(1000000);
+
+    for (std::size_t threads : {1, 2, 3}) {
+        hashes::blake3_hasher<> h(threads);
+        // Uneven pieces leave partial chunks between the subtrees handed over to threads
+        for (std::size_t first = 0, size = 1; first != input.size(); size = size * 3 + 1) {
+            std::size_t amount = std::min(size, input.size() - first);
+            h.update(input.data() + first, amount);
+            first += amount;
+        }
+        BOOST_CHECK_EQUAL("5e82c663d164c54e4fcdfcd70e3ca464662228bdbad45cce2e0c2bff999064ef",
+                          std::to_string(h.finalize()).data());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(blake3_backend_test_suite)
+
+BOOST_AUTO_TEST_CASE(blake3_backend_name) {
+    const char *backend = hashes::blake3_backend();
+    const char *known[] = {"avx512", "avx2", "sse4.1", "generic"};
+
+    BOOST_CHECK(std::any_of(std::begin(known), std::end(known),
+                            [backend](const char *name) { return !std::strcmp(backend, name); }));
+}
+
+#if BOOST_ARCH_X86_64
+BOOST_AUTO_TEST_CASE(blake3_dispatch_backends_agree) {
+    typedef hashes::detail::blake3_policy<256> policy_type;
+    typedef hashes::detail::blake3_dispatch_impl<policy_type> dispatch_type;
+
+    // 37 chunks leave a remainder for every lane count
+    const std::size_t count = 37;
+    const std::vector<std::uint8_t> input = blake3_input(count * policy_type::chunk_octets);
+    std::vector<const std::uint8_t *> inputs(count);
+    for (std::size_t i = 0; i != count; ++i) {
+        inputs[i] = input.data() + i * policy_type::chunk_octets;
+    }
+
+    std::vector<std::uint8_t> expected(count * policy_type::state_bits / octet_bits);
+    hashes::detail::blake3_impl<policy_type>::hash_many(
+        inputs.data(), count, policy_type::chunk_blocks, policy_type::iv, 5, true, policy_type::keyed_hash,
+        policy_type::chunk_start, policy_type::chunk_end, expected.data());
+
+    for_each_backend<dispatch_type>(
+        {&hashes::detail::cpu_features::avx512f, &hashes::detail::cpu_features::avx2,
+         &hashes::detail::cpu_features::sse4_1},
+        [&](const dispatch_type::backend_type &backend) {
+            std::vector<std::uint8_t> out(expected.size());
+            backend.hash_many(inputs.data(), count, policy_type::chunk_blocks, policy_type::iv, 5, true,
+                              policy_type::keyed_hash, policy_type::chunk_start, policy_type::chunk_end, out.data());
+            BOOST_CHECK(out == expected);
+        });
+
+    BOOST_CHECK_EQUAL(dispatch_type::backend().name, hashes::blake3_backend());
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -42,6 +42,8 @@
 #include <nil/crypto3/hash/algorithm/hash.hpp>
 #include <nil/crypto3/hash/type_traits.hpp>
 
+#include <octets.hpp>
+
 using namespace nil::crypto3;
 using namespace nil::crypto3::multiprecision;
 using namespace nil::crypto3::algebra;
@@ -94,6 +96,21 @@ typename std::enable_if<hashes::is_h2f<Hash>::value>::type
     }
 }
 
+template<typename Xof, std::size_t k, std::size_t LenInBytes>
+void check_expand_message_xof(const std::string &dst_str, const std::string &msg_str, const std::string &result) {
+    typedef hashes::detail::expand_message_xof<k, LenInBytes, Xof> expand_message_type;
+
+    std::vector<std::uint8_t> dst(dst_str.begin(), dst_str.end());
+    std::vector<std::uint8_t> msg(msg_str.begin(), msg_str.end());
+
+    typename expand_message_type::internal_accumulator_type acc;
+    expand_message_type::init_accumulator(acc);
+    expand_message_type::update(acc, msg);
+    typename expand_message_type::result_type uniform_bytes = expand_message_type::process(acc, dst);
+
+    BOOST_CHECK_EQUAL(result, to_hex(uniform_bytes));
+}
+
 BOOST_AUTO_TEST_SUITE(hash_h2f_manual_tests)
 
 BOOST_AUTO_TEST_CASE(hash_to_field_bls12_381_g1_h2c_sha256_test) {
@@ -243,3 +260,91 @@ BOOST_AUTO_TEST_CASE(hash_to_field_bls12_381_g2_h2c_sha256_test) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(hash_h2f_expand_message_tests)
+
+BOOST_AUTO_TEST_CASE(expand_message_xof_shake128_test) {
+    // https://www.rfc-editor.org/rfc/rfc9380#appendix-K.3
+    typedef hashes::shake128 xof_type;
+    const std::string dst = "QUUX-V01-CS02-with-expander-SHAKE128";
+
+    check_expand_message_xof<xof_type, 128, 0x20>(dst, "",
+                                                  "86518c9cd86581486e9485aa74ab35ba150d1c75c88e26b7043e44e2acd735a2");
+    check_expand_message_xof<xof_type, 128, 0x20>(dst, "abc",
+                                                  "8696af52a4d862417c0763556073f47bc9b9ba43c99b505305cb1ec04a9ab468");
+    check_expand_message_xof<xof_type, 128, 0x20>(dst, "abcdef0123456789",
+                                                  "912c58deac4821c3509dbefa094df54b34b8f5d01a191d1d3108a2c89077acca");
+    check_expand_message_xof<xof_type, 128, 0x20>(dst, std::string("q128_") + std::string(128, 'q'),
+                                                  "1adbcc448aef2a0cebc71dac9f756b22e51839d348e031e63b33ebb50faeaf3f");
+    check_expand_message_xof<xof_type, 128, 0x20>(dst, std::string("a512_") + std::string(512, 'a'),
+                                                  "df3447cc5f3e9a77da10f819218ddf31342c310778e0e4ef72bbaecee786a4fe");
+    check_expand_message_xof<xof_type, 128, 0x80>(dst, "",
+                                                  "7314ff1a155a2fb99a0171dc71b89ab6e3b2b7d59e38e64419b8b6294d03ffee"
+                                                  "42491f11370261f436220ef787f8f76f5b26bdcd850071920ce023f3ac468477"
+                                                  "44f4612b8714db8f5db83205b2e625d95afd7d7b4d3094d3bdde815f52850bb4"
+                                                  "1ead9822e08f22cf41d615a303b0d9dde73263c049a7b9898208003a739a2e57");
+    check_expand_message_xof<xof_type, 128, 0x80>(dst, "abc",
+                                                  "c952f0c8e529ca8824acc6a4cab0e782fc3648c563ddb00da7399f2ae35654f4"
+                                                  "860ec671db2356ba7baa55a34a9d7f79197b60ddae6e64768a37d699a7832349"
+                                                  "6db3878c8d64d909d0f8a7de4927dcab0d3dbbc26cb20a49eceb0530b431cdf4"
+                                                  "7bc8c0fa3e0d88f53b318b6739fbed7d7634974f1b5c386d6230c76260d5337a");
+    check_expand_message_xof<xof_type, 128, 0x80>(dst, "abcdef0123456789",
+                                                  "19b65ee7afec6ac06a144f2d6134f08eeec185f1a890fe34e68f0e377b7d0312"
+                                                  "883c048d9b8a1d6ecc3b541cb4987c26f45e0c82691ea299b5e6889bbfe58915"
+                                                  "3016d8131717ba26f07c3c14ffbef1f3eff9752e5b6183f43871a78219a75e70"
+                                                  "00fbac6a7072e2b83c790a3a5aecd9d14be79f9fd4fb180960a3772e08680495");
+    check_expand_message_xof<xof_type, 128, 0x80>(dst, std::string("q128_") + std::string(128, 'q'),
+                                                  "ca1b56861482b16eae0f4a26212112362fcc2d76dcc80c93c4182ed66c5113fe"
+                                                  "41733ed68be2942a3487394317f3379856f4822a611735e50528a60e7ade8ec8"
+                                                  "c71670fec6661e2c59a09ed36386513221688b35dc47e3c3111ee8c67ff49579"
+                                                  "089d661caa29db1ef10eb6eace575bf3dc9806e7c4016bd50f3c0e2a6481ee6d");
+    check_expand_message_xof<xof_type, 128, 0x80>(dst, std::string("a512_") + std::string(512, 'a'),
+                                                  "9d763a5ce58f65c91531b4100c7266d479a5d9777ba761693d052acd37d149e7"
+                                                  "ac91c796a10b919cd74a591a1e38719fb91b7203e2af31eac3bff7ead2c195af"
+                                                  "7d88b8bc0a8adf3d1e90ab9bed6ddc2b7f655dd86c730bdeaea884e737410971"
+                                                  "42c92f0e3fc1811b699ba593c7fbd81da288a29d423df831652e3a01a9374999");
+}
+
+BOOST_AUTO_TEST_CASE(expand_message_xof_shake256_test) {
+    // https://www.rfc-editor.org/rfc/rfc9380#appendix-K.4
+    typedef hashes::shake256 xof_type;
+    const std::string dst = "QUUX-V01-CS02-with-expander-SHAKE256";
+
+    check_expand_message_xof<xof_type, 256, 0x20>(dst, "",
+                                                  "2ffc05c48ed32b95d72e807f6eab9f7530dd1c2f013914c8fed38c5ccc15ad76");
+    check_expand_message_xof<xof_type, 256, 0x20>(dst, "abc",
+                                                  "b39e493867e2767216792abce1f2676c197c0692aed061560ead251821808e07");
+    check_expand_message_xof<xof_type, 256, 0x20>(dst, "abcdef0123456789",
+                                                  "245389cf44a13f0e70af8665fe5337ec2dcd138890bb7901c4ad9cfceb054b65");
+    check_expand_message_xof<xof_type, 256, 0x20>(dst, std::string("q128_") + std::string(128, 'q'),
+                                                  "719b3911821e6428a5ed9b8e600f2866bcf23c8f0515e52d6c6c019a03f16f0e");
+    check_expand_message_xof<xof_type, 256, 0x20>(dst, std::string("a512_") + std::string(512, 'a'),
+                                                  "9181ead5220b1963f1b5951f35547a5ea86a820562287d6ca4723633d17ccbbc");
+    check_expand_message_xof<xof_type, 256, 0x80>(dst, "",
+                                                  "7a1361d2d7d82d79e035b8880c5a3c86c5afa719478c007d96e6c88737a3f631"
+                                                  "dd74a2c88df79a4cb5e5d9f7504957c70d669ec6bfedc31e01e2bacc4ff3fdf9"
+                                                  "b6a00b17cc18d9d72ace7d6b81c2e481b4f73f34f9a7505dccbe8f5485f3d20c"
+                                                  "5409b0310093d5d6492dea4e18aa6979c23c8ea5de01582e9689612afbb353df");
+    check_expand_message_xof<xof_type, 256, 0x80>(dst, "abc",
+                                                  "a54303e6b172909783353ab05ef08dd435a558c3197db0c132134649708e0b9b"
+                                                  "4e34fb99b92a9e9e28fc1f1d8860d85897a8e021e6382f3eea10577f968ff6df"
+                                                  "6c45fe624ce65ca25932f679a42a404bc3681efe03fcd45ef73bb3a8f79ba784"
+                                                  "f80f55ea8a3c367408f30381299617f50c8cf8fbb21d0f1e1d70b0131a7b6fbe");
+    check_expand_message_xof<xof_type, 256, 0x80>(dst, "abcdef0123456789",
+                                                  "e42e4d9538a189316e3154b821c1bafb390f78b2f010ea404e6ac063deb8c085"
+                                                  "2fcd412e098e231e43427bd2be1330bb47b4039ad57b30ae1fc94e34993b162f"
+                                                  "f4d695e42d59d9777ea18d3848d9d336c25d2acb93adcad009bcfb9cde12286d"
+                                                  "f267ada283063de0bb1505565b2eb6c90e31c48798ecdc71a71756a9110ff373");
+    check_expand_message_xof<xof_type, 256, 0x80>(dst, std::string("q128_") + std::string(128, 'q'),
+                                                  "4ac054dda0a38a65d0ecf7afd3c2812300027c8789655e47aecf1ecc1a2426b1"
+                                                  "7444c7482c99e5907afd9c25b991990490bb9c686f43e79b4471a23a703d4b02"
+                                                  "f23c669737a886a7ec28bddb92c3a98de63ebf878aa363a501a60055c048bea1"
+                                                  "1840c4717beae7eee28c3cfa42857b3d130188571943a7bd747de831bd6444e0");
+    check_expand_message_xof<xof_type, 256, 0x80>(dst, std::string("a512_") + std::string(512, 'a'),
+                                                  "09afc76d51c2cccbc129c2315df66c2be7295a231203b8ab2dd7f95c2772c68e"
+                                                  "500bc72e20c602abc9964663b7a03a389be128c56971ce81001a0b875e7fd178"
+                                                  "22db9d69792ddf6a23a151bf470079c518279aef3e75611f8f828994a9988f4a"
+                                                  "8a256ddb8bae161e658d5a2a09bcfe839c6396dc06ee5c8ff3c22d3b1f9deb7e");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE hash_batch_test
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/algorithm/hash_batch.hpp>
+
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/sha3.hpp>
+
+using namespace nil::crypto3;
+
+std::vector<std::vector<std::uint8_t>> make_messages(std::size_t count) {
+    // Unequal lengths around the padding boundaries, so lanes finish at different blocks
+    std::vector<std::vector<std::uint8_t>> messages(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        messages[i].resize((i * 37) % 300);
+        for (std::size_t j = 0; j < messages[i].size(); ++j) {
+            messages[i][j] = static_cast<std::uint8_t>(i + j * 3);
+        }
+    }
+    return messages;
+}
+
+template<typename Hash>
+void check_batch(std::size_t count) {
+    std::vector<std::vector<std::uint8_t>> messages = make_messages(count);
+
+    std::vector<typename Hash::digest_type> digests;
+    hash_batch<Hash>(messages, std::back_inserter(digests));
+
+    BOOST_REQUIRE_EQUAL(digests.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        typename Hash::digest_type expected = hash<Hash>(messages[i]);
+        BOOST_CHECK_EQUAL(std::to_string(digests[i]), std::to_string(expected));
+    }
+}
+
+// Runs the messages through every multi-buffer backend the host supports, from the widest down
+template<typename Hash, typename Dispatch>
+void check_backends(std::size_t count) {
+    std::vector<std::vector<std::uint8_t>> messages = make_messages(count);
+    std::vector<const std::uint8_t *> data;
+    std::vector<std::size_t> sizes;
+    for (const std::vector<std::uint8_t> &message : messages) {
+        data.push_back(message.data());
+        sizes.push_back(message.size());
+    }
+
+    hashes::detail::cpu_features narrower = hashes::detail::cpu_features::host();
+    narrower.avx512f = false;
+    hashes::detail::cpu_features narrowest = narrower;
+    narrowest.avx2 = false;
+
+    for (const hashes::detail::cpu_features &features : {hashes::detail::cpu_features::host(), narrower, narrowest}) {
+        std::vector<typename Hash::digest_type> digests(count);
+        Dispatch::select(features).process(data.data(), sizes.data(), count, digests.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            typename Hash::digest_type expected = hash<Hash>(messages[i]);
+            BOOST_CHECK_EQUAL(std::to_string(digests[i]), std::to_string(expected));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(hash_batch_test_suite)
+
+BOOST_AUTO_TEST_CASE(hash_batch_sha2_256_abc) {
+    std::vector<std::string> messages = {"abc", "", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"};
+
+    std::vector<hashes::sha2<256>::digest_type> digests;
+    hash_batch<hashes::sha2<256>>(messages, std::back_inserter(digests));
+
+    BOOST_CHECK_EQUAL("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", std::to_string(digests[0]));
+    BOOST_CHECK_EQUAL("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", std::to_string(digests[1]));
+    BOOST_CHECK_EQUAL("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", std::to_string(digests[2]));
+}
+
+BOOST_AUTO_TEST_CASE(hash_batch_sha2_256_merkle_nodes) {
+    std::vector<std::array<std::uint8_t, 64>> nodes(100);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].fill(static_cast<std::uint8_t>(i));
+    }
+
+    std::vector<hashes::sha2<256>::digest_type> digests(nodes.size());
+    hash_batch<hashes::sha2<256>>(nodes, digests.begin());
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        hashes::sha2<256>::digest_type expected = hash<hashes::sha2<256>>(nodes[i]);
+        BOOST_CHECK_EQUAL(std::to_string(digests[i]), std::to_string(expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_batch_sha2_256_lengths) {
+    // Batch sizes which leave some lanes of every vector width empty
+    for (std::size_t count : {1, 3, 4, 5, 8, 13, 16, 17, 40}) {
+        check_batch<hashes::sha2<256>>(count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_batch_sha2_224_lengths) {
+    check_batch<hashes::sha2<224>>(21);
+}
+
+#ifdef CRYPTO3_HASH_SHA2_256_MULTI_BUFFER
+BOOST_AUTO_TEST_CASE(hash_batch_sha2_256_backends) {
+    typedef hashes::detail::sha2_256_multi_buffer_dispatch<hashes::detail::sha2_policy<256>> dispatch_type;
+    check_backends<hashes::sha2<256>, dispatch_type>(37);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(hash_batch_keccak_256_empty_and_abc) {
+    std::vector<std::string> messages = {"", "abc"};
+
+    std::vector<hashes::keccak_1600<256>::digest_type> digests;
+    hash_batch<hashes::keccak_1600<256>>(messages, std::back_inserter(digests));
+
+    BOOST_CHECK_EQUAL("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470", std::to_string(digests[0]));
+    BOOST_CHECK_EQUAL("4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45", std::to_string(digests[1]));
+}
+
+BOOST_AUTO_TEST_CASE(hash_batch_keccak_256_storage_slots) {
+    // 32- and 64-octet inputs, each absorbed in a single permutation
+    std::vector<std::vector<std::uint8_t>> slots(37);
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        slots[i].assign(i % 2 ? 64 : 32, static_cast<std::uint8_t>(i));
+    }
+
+    std::vector<hashes::keccak_1600<256>::digest_type> digests(slots.size());
+    hash_batch<hashes::keccak_1600<256>>(slots, digests.begin());
+
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        hashes::keccak_1600<256>::digest_type expected = hash<hashes::keccak_1600<256>>(slots[i]);
+        BOOST_CHECK_EQUAL(std::to_string(digests[i]), std::to_string(expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_batch_keccak_and_sha3_lengths) {
+    for (std::size_t count : {1, 4, 7, 8, 9, 19}) {
+        check_batch<hashes::keccak_1600<256>>(count);
+        check_batch<hashes::sha3<256>>(count);
+    }
+    check_batch<hashes::keccak_1600<512>>(11);
+    check_batch<hashes::sha3<224>>(11);
+}
+
+#ifdef CRYPTO3_HASH_KECCAK_1600_MULTI_BUFFER
+BOOST_AUTO_TEST_CASE(hash_batch_keccak_and_sha3_backends) {
+    typedef hashes::detail::keccak_1600_multi_buffer_dispatch<hashes::detail::keccak_1600_policy<256>, 0x01>
+        keccak_dispatch_type;
+    typedef hashes::detail::keccak_1600_multi_buffer_dispatch<hashes::detail::sha3_policy<256>, 0x06>
+        sha3_dispatch_type;
+    check_backends<hashes::keccak_1600<256>, keccak_dispatch_type>(19);
+    check_backends<hashes::sha3<256>, sha3_dispatch_type>(19);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(hash_batch_scalar_fallback) {
+    check_batch<hashes::sha2<512>>(9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
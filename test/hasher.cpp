@@ -0,0 +1,153 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE hash_hasher_test
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/hasher.hpp>
+
+#include <nil/crypto3/hash/blake2b.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/md5.hpp>
+#include <nil/crypto3/hash/ripemd.hpp>
+#include <nil/crypto3/hash/sha1.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/sha3.hpp>
+#include <nil/crypto3/hash/tiger.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+template<typename Hash>
+void check_against_accumulator() {
+    hashes::hasher<Hash> h;
+
+    for (std::size_t size : {0, 1, 55, 56, 63, 64, 65, 111, 112, 127, 128, 129, 200, 1000, 4097}) {
+        std::vector<std::uint8_t> m = make_message(size);
+        typename Hash::digest_type d = hash<Hash>(m);
+        std::string expected = std::to_string(d);
+
+        // Whole message at once
+        BOOST_CHECK_EQUAL(std::to_string(h.update(m).finalize()), expected);
+
+        // Uneven chunks straddling block boundaries
+        for (std::size_t chunk : {1, 3, 17, 64, 100, 129}) {
+            for (std::size_t i = 0; i < size; i += chunk) {
+                h.update(m.data() + i, std::min(chunk, size - i));
+            }
+            BOOST_CHECK_EQUAL(std::to_string(h.finalize()), expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(hasher_test_suite)
+
+BOOST_AUTO_TEST_CASE(hasher_sha2_256_abc) {
+    hashes::hasher<hashes::sha2<256>> h;
+    h.update(std::string("abc"));
+
+    BOOST_CHECK_EQUAL("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+                      std::to_string(h.finalize()).data());
+
+    h.update(std::string("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+
+    BOOST_CHECK_EQUAL("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+                      std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(hasher_reset) {
+    hashes::hasher<hashes::sha2<256>> h;
+    h.update(std::string("garbage"));
+    h.reset();
+    h.update(std::string("abc"));
+
+    BOOST_CHECK_EQUAL("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+                      std::to_string(h.finalize()).data());
+}
+
+BOOST_AUTO_TEST_CASE(hasher_merkle_damgard) {
+    check_against_accumulator<hashes::md5>();
+    check_against_accumulator<hashes::sha1>();
+    check_against_accumulator<hashes::sha2<256>>();
+    check_against_accumulator<hashes::sha2<512>>();
+    check_against_accumulator<hashes::ripemd160>();
+    check_against_accumulator<hashes::tiger<>>();
+}
+
+BOOST_AUTO_TEST_CASE(hasher_sponge) {
+    check_against_accumulator<hashes::keccak_1600<256>>();
+    check_against_accumulator<hashes::sha3<256>>();
+    check_against_accumulator<hashes::sha3<512>>();
+}
+
+BOOST_AUTO_TEST_CASE(hasher_sponge_lane_order) {
+    typedef hashes::sha3<256> hash_type;
+    BOOST_STATIC_ASSERT(hashes::hasher<hash_type>::construction_type::native_lane_order);
+
+    // Pointers are absorbed as octets, other iterators are packed into words first
+    hashes::hasher<hash_type> contiguous, packed;
+    std::vector<std::uint8_t> m = make_message(1000);
+
+    contiguous.update(m.data(), 500);
+    packed.update(m.cbegin(), m.cbegin() + 500);
+    BOOST_CHECK(contiguous.export_midstate().state == packed.export_midstate().state);
+
+    contiguous.update(m.data() + 500, 500);
+    packed.update(m.cbegin() + 500, m.cend());
+    typename hash_type::digest_type expected = hash<hash_type>(m);
+    BOOST_CHECK_EQUAL(std::to_string(contiguous.finalize()), std::to_string(expected));
+    BOOST_CHECK_EQUAL(std::to_string(packed.finalize()), std::to_string(expected));
+}
+
+BOOST_AUTO_TEST_CASE(hasher_ranges) {
+    typedef hashes::sha3<256> hash_type;
+
+    // Vectors and strings are taken as pointers, lists are walked value by value
+    const std::vector<std::uint8_t> m = make_message(1000);
+    const std::string s(m.begin(), m.end());
+    const std::list<std::uint8_t> l(m.begin(), m.end());
+    typename hash_type::digest_type expected = hash<hash_type>(m);
+
+    hashes::hasher<hash_type> h;
+    BOOST_CHECK_EQUAL(std::to_string(h.update(m).finalize()), std::to_string(expected));
+    BOOST_CHECK_EQUAL(std::to_string(h.update(s).finalize()), std::to_string(expected));
+    BOOST_CHECK_EQUAL(std::to_string(h.update(l).finalize()), std::to_string(expected));
+}
+
+BOOST_AUTO_TEST_CASE(hasher_haifa) {
+    check_against_accumulator<hashes::blake2b<256>>();
+    check_against_accumulator<hashes::blake2b<512>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE hmac_test
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/hmac.hpp>
+
+#include <nil/crypto3/hash/blake2b.hpp>
+#include <nil/crypto3/hash/md5.hpp>
+#include <nil/crypto3/hash/ripemd.hpp>
+#include <nil/crypto3/hash/sha1.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/sha3.hpp>
+#include <nil/crypto3/hash/tiger.hpp>
+
+using namespace nil::crypto3;
+
+typedef std::pair<std::string, std::string> hmac_input;
+
+// RFC 4231 test cases 1, 2, 3 and 6, and an empty message
+const std::vector<hmac_input> hmac_inputs = {
+    {std::string(20, '\x0b'), "Hi There"},
+    {"Jefe", "what do ya want for nothing?"},
+    {std::string(20, '\xaa'), std::string(50, '\xdd')},
+    {std::string(131, '\xaa'), "Test Using Larger Than Block-Size Key - Hash Key First"},
+    {"key", ""}};
+
+template<typename Hash>
+void check_hmac(const std::vector<std::string> &expected) {
+    for (std::size_t i = 0; i != hmac_inputs.size(); ++i) {
+        hashes::hmac<Hash> mac(hmac_inputs[i].first);
+        BOOST_CHECK_EQUAL(std::to_string(mac(hmac_inputs[i].second)), expected[i]);
+
+        // The keyed state is reused for every message
+        for (std::size_t repeat = 0; repeat != 2; ++repeat) {
+            mac.update(hmac_inputs[i].second);
+            BOOST_CHECK_EQUAL(std::to_string(mac.finalize()), expected[i]);
+        }
+    }
+}
+
+// HMAC spelled out with two plain hashers, with the key blocks compressed for every message
+template<typename Hash>
+typename Hash::digest_type plain_hmac(const std::vector<std::uint8_t> &key, const std::vector<std::uint8_t> &m) {
+    const std::size_t block_octets = hashes::hasher<Hash>::block_values;
+    std::vector<std::uint8_t> k(key);
+    k.resize(block_octets);
+
+    std::vector<std::uint8_t> inner_pad(block_octets), outer_pad(block_octets);
+    for (std::size_t i = 0; i != block_octets; ++i) {
+        inner_pad[i] = k[i] ^ 0x36;
+        outer_pad[i] = k[i] ^ 0x5c;
+    }
+
+    hashes::hasher<Hash> inner, outer;
+    typename Hash::digest_type d = inner.update(inner_pad).update(m).finalize();
+    return outer.update(outer_pad).update(d.begin(), d.end()).finalize();
+}
+
+template<typename Hash>
+void check_block_boundaries() {
+    const std::size_t block_octets = hashes::hasher<Hash>::block_values;
+    const std::vector<std::uint8_t> key = {'k', 'e', 'y'};
+    hashes::hmac<Hash> mac(key);
+
+    for (std::size_t size :
+         {std::size_t(0), std::size_t(1), block_octets - 1, block_octets, block_octets + 1, 3 * block_octets}) {
+        std::vector<std::uint8_t> m(size);
+        for (std::size_t i = 0; i != size; ++i) {
+            m[i] = static_cast<std::uint8_t>(i * 7);
+        }
+
+        const std::string expected = std::to_string(plain_hmac<Hash>(key, m));
+        BOOST_CHECK_EQUAL(std::to_string(mac(m)), expected);
+
+        // Split updates, an empty one first
+        mac.update(m.begin(), m.begin());
+        mac.update(m.begin(), m.begin() + size / 2).update(m.data() + size / 2, size - size / 2);
+        BOOST_CHECK_EQUAL(std::to_string(mac.finalize()), expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(hmac_test_suite)
+
+BOOST_AUTO_TEST_CASE(hmac_sha1) {
+    check_hmac<hashes::sha1>({"b617318655057264e28bc0b6fb378c8ef146be00", "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+                              "125d7342b9ac11cd91a39af48aa17b4f63f175d3", "90d0dace1c1bdc957339307803160335bde6df2b",
+                              "f42bb0eeb018ebbd4597ae7213711ec60760843f"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_md5) {
+    check_hmac<hashes::md5>({"5ccec34ea9656392457fa1ac27f08fbc", "750c783e6ab0b503eaa86e310a5db738",
+                             "2ab8b9a9f7d3894d15ad8383b97044b2", "bfecaf4efff90a3a668f3922fec3762d",
+                             "63530468a04e386459855da0063b6596"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_sha2_256) {
+    check_hmac<hashes::sha2<256>>({"b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7",
+                                   "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+                                   "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe",
+                                   "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+                                   "5d5d139563c95b5967b9bd9a8c9b233a9dedb45072794cd232dc1b74832607d0"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_sha2_512) {
+    check_hmac<hashes::sha2<512>>(
+        {"87aa7cdea5ef619d4ff0b4241a1d6cb02379f4e2ce4ec2787ad0b30545e17cde"
+         "daa833b7d6b8a702038b274eaea3f4e4be9d914eeb61f1702e696c203a126854",
+         "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+         "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737",
+         "fa73b0089d56a284efb0f0756c890be9b1b5dbdd8ee81a3655f83e33b2279d39"
+         "bf3e848279a722c806b485a47e67c807b946a337bee8942674278859e13292fb",
+         "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f352"
+         "6b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598",
+         "84fa5aa0279bbc473267d05a53ea03310a987cecc4c1535ff29b6d76b8f1444a"
+         "728df3aadb89d4a9a6709e1998f373566e8f824a8ca93b1821f0b69bc2a2f65e"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_ripemd160) {
+    check_hmac<hashes::ripemd160>(
+        {"24cb4bd67d20fc1a5d2ed7732dcc39377f0a5668", "dda6c0213a485a9e24f4742064a7f033b43c4069",
+         "b0b105360de759960ab4f35298e116e295d8e7c1", "71bb52d26408e5a221393d5811b03cc7f94bcd3a",
+         "eb123f0b89091ba4cb169cc0142520ebe3aa094e"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_sha3_256) {
+    check_hmac<hashes::sha3<256>>({"ba85192310dffa96e2a3a40e69774351140bb7185e1202cdcc917589f95e16bb",
+                                   "c7d4072e788877ae3596bbb0da73b887c9171f93095b294ae857fbe2645e1ba5",
+                                   "84ec79124a27107865cedd8bd82da9965e5ed8c37b0ac98005a7f39ed58a4207",
+                                   "ed73a374b96c005235f948032f09674a58c0ce555cfc1f223b02356560312c3b",
+                                   "74f3c030ecc36a1835d04a333ebb7fce2688c0c78fb0bcf9592213331c884c75"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_blake2b_512) {
+    check_hmac<hashes::blake2b<512>>(
+        {"358a6a184924894fc34bee5680eedf57d84a37bb38832f288e3b27dc63a98cc8"
+         "c91e76da476b508bc6b2d408a248857452906e4a20b48c6b4b55d2df0fe1dd24",
+         "6ff884f8ddc2a6586b3c98a4cd6ebdf14ec10204b6710073eb5865ade37a2643"
+         "b8807c1335d107ecdb9ffeaeb6828c4625ba172c66379efcd222c2de11727ab4",
+         "f43bc62c7a99353c3b2c60e8ef24fbbd42e9547866dc9c5be4edc6f4a7d4bc0a"
+         "c620c2c60034d040f0dbaf86f9e9cd7891a095595eed55e2a996215f0c15c018",
+         "a54b2943b2a20227d41ca46c0945af09bc1faefb2f49894c23aebc557fb79c48"
+         "89dca74408dc865086667aedee4a3185c53a49c80b814c4c5813ea0c8b38a8f8",
+         "019fe04bf010b8d72772e6b46897ecf74b4878c394ff2c4d5cfa0b7cc9bbefcb"
+         "28c36de23cef03089db9c3d900468c89804f135e9fdef7ec9b3c7abe50ed33d3"});
+}
+
+BOOST_AUTO_TEST_CASE(hmac_block_boundaries) {
+    check_block_boundaries<hashes::sha2<256>>();
+    check_block_boundaries<hashes::sha3<256>>();
+    check_block_boundaries<hashes::blake2b<512>>();
+    check_block_boundaries<hashes::tiger<192>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_TEST_DISPATCH_HPP
+#define CRYPTO3_HASH_TEST_DISPATCH_HPP
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+
+#include <nil/crypto3/hash/detail/cpu_features.hpp>
+
+// Helpers shared by the tests checking every run-time dispatched backend against the reference code
+
+// Linear congruential generator filling words with test input that is the same on every host
+class lcg_words {
+public:
+    explicit lcg_words(std::uint64_t seed) : x(seed) {
+    }
+
+    // Each word takes the upper bits of the next value, the better mixed ones
+    template<typename WordRange>
+    void fill(WordRange &words) {
+        for (auto &w : words) {
+            typedef typename std::decay<decltype(w)>::type word_type;
+            x = x * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+            w = static_cast<word_type>(x >> (64 - std::numeric_limits<word_type>::digits));
+        }
+    }
+
+    template<typename BlockRange>
+    void fill_blocks(BlockRange &blocks) {
+        for (auto &block : blocks) {
+            fill(block);
+        }
+    }
+
+private:
+    std::uint64_t x;
+};
+
+// Calls check(backend) with the backend Dispatch picks on this host, then once more each time the next of
+// features is turned off, and returns the backend picked last. Every backend the host can run thus gets
+// compared with the reference.
+template<typename Dispatch, typename Check>
+typename Dispatch::backend_type
+    for_each_backend(std::initializer_list<bool nil::crypto3::hashes::detail::cpu_features::*> features,
+                     Check check) {
+    nil::crypto3::hashes::detail::cpu_features host = nil::crypto3::hashes::detail::cpu_features::host();
+    typename Dispatch::backend_type backend = Dispatch::select(host);
+    check(backend);
+    for (bool nil::crypto3::hashes::detail::cpu_features::*feature : features) {
+        host.*feature = false;
+        backend = Dispatch::select(host);
+        check(backend);
+    }
+    return backend;
+}
+
+#endif    // CRYPTO3_HASH_TEST_DISPATCH_HPP
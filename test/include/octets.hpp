@@ -0,0 +1,60 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_TEST_OCTETS_HPP
+#define CRYPTO3_HASH_TEST_OCTETS_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Octet helpers shared by the hash tests
+
+inline std::string to_hex(const std::uint8_t *data, std::size_t n) {
+    std::string s;
+    char buf[3];
+    for (std::size_t i = 0; i != n; ++i) {
+        std::snprintf(buf, sizeof(buf), "%02x", data[i]);
+        s += buf;
+    }
+    return s;
+}
+
+template<typename OctetRange>
+inline std::string to_hex(const OctetRange &r) {
+    return to_hex(std::data(r), std::size(r));
+}
+
+// Message whose octets differ from one seed to another, with no period shorter than 256 octets
+inline std::vector<std::uint8_t> make_message(std::size_t size, std::size_t seed = 0) {
+    std::vector<std::uint8_t> m(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        m[i] = static_cast<std::uint8_t>(i * 31 + seed * 7 + 5);
+    }
+    return m;
+}
+
+#endif    // CRYPTO3_HASH_TEST_OCTETS_HPP
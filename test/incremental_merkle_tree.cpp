@@ -0,0 +1,163 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+
+#define BOOST_TEST_MODULE incremental_merkle_tree_test
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/incremental_merkle_tree.hpp>
+#include <nil/crypto3/hash/merkle_tree.hpp>
+
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/poseidon.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+
+#include <nil/crypto3/algebra/fields/pallas/base_field.hpp>
+
+using namespace nil::crypto3;
+
+typedef hashes::sha2<256> sha2_256;
+typedef hashes::hasher<sha2_256>::digest_type sha2_256_digest;
+
+std::vector<std::vector<std::uint8_t>> make_leaves(std::size_t count) {
+    std::vector<std::vector<std::uint8_t>> leaves(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        leaves[i].assign(32 + i % 7, static_cast<std::uint8_t>(i * 3 + 1));
+    }
+    return leaves;
+}
+
+// Full tree of the given depth over the leaf digests, the missing ones being zero
+sha2_256_digest plain_root(std::vector<sha2_256_digest> level, std::size_t depth) {
+    level.resize(std::size_t(1) << depth, sha2_256_digest());
+    while (level.size() > 1) {
+        std::vector<sha2_256_digest> parents;
+        for (std::size_t i = 0; i < level.size(); i += 2) {
+            hashes::hasher<sha2_256> h;
+            h.update(std::vector<std::uint8_t> {0x01});
+            h.update(level[i].data(), level[i].size()).update(level[i + 1].data(), level[i + 1].size());
+            parents.push_back(h.finalize());
+        }
+        level = parents;
+    }
+    return level[0];
+}
+
+BOOST_AUTO_TEST_SUITE(incremental_merkle_tree_test_suite)
+
+BOOST_AUTO_TEST_CASE(incremental_merkle_tree_sha2_256_empty) {
+    hashes::incremental_merkle_tree<sha2_256, 3> tree;
+
+    BOOST_CHECK_EQUAL(tree.size(), 0);
+    BOOST_CHECK_EQUAL("bea16162721bca4b6e1782cbdc695a471522157c6716f508db47c599195340f4",
+                      std::to_string(tree.root()));
+    BOOST_CHECK_EQUAL(std::to_string(tree.empty_root(3)), std::to_string(tree.root()));
+    BOOST_CHECK_EQUAL(std::to_string(tree.empty_root(0)), std::to_string(sha2_256_digest()));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_merkle_tree_sha2_256_appends) {
+    std::vector<std::vector<std::uint8_t>> leaves = make_leaves(16);
+
+    hashes::incremental_merkle_tree<sha2_256, 4> tree;
+    std::vector<sha2_256_digest> digests;
+    for (const std::vector<std::uint8_t> &leaf : leaves) {
+        tree.append(leaf);
+
+        hashes::hasher<sha2_256> h;
+        h.update(std::vector<std::uint8_t> {0x00});
+        digests.push_back(h.update(leaf.data(), leaf.size()).finalize());
+        BOOST_CHECK_EQUAL(tree.size(), digests.size());
+        BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(plain_root(digests, 4)));
+    }
+    BOOST_CHECK(tree.full());
+
+    // A full tree is the complete binary tree over the same leaves
+    hashes::merkle_tree<sha2_256> complete(leaves);
+    BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(complete.root()));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_merkle_tree_sha2_256_extend) {
+    std::vector<std::vector<std::uint8_t>> leaves = make_leaves(37);
+
+    hashes::incremental_merkle_tree<sha2_256> one_by_one;
+    for (const std::vector<std::uint8_t> &leaf : leaves) {
+        one_by_one.append(leaf);
+    }
+
+    hashes::incremental_merkle_tree<sha2_256> batch;
+    batch.extend(std::vector<std::vector<std::uint8_t>>(leaves.begin(), leaves.begin() + 20));
+    batch.extend(std::vector<std::vector<std::uint8_t>>(leaves.begin() + 20, leaves.end()));
+
+    BOOST_CHECK_EQUAL(batch.size(), 37);
+    BOOST_CHECK_EQUAL(std::to_string(batch.root()), std::to_string(one_by_one.root()));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_merkle_tree_sha2_256_empty_leaf) {
+    sha2_256_digest empty_leaf;
+    empty_leaf.fill(0xAB);
+
+    hashes::incremental_merkle_tree<sha2_256, 2> tree(empty_leaf);
+    tree.append_digest(sha2_256_digest());
+
+    std::vector<sha2_256_digest> level = {sha2_256_digest(), empty_leaf, empty_leaf, empty_leaf};
+    for (std::size_t l = 0; l != 2; ++l) {
+        std::vector<sha2_256_digest> parents;
+        for (std::size_t i = 0; i < level.size(); i += 2) {
+            parents.push_back(hashes::merkle_tree<sha2_256>::node_hasher_type::hash_node(&level[i], 2));
+        }
+        level = parents;
+    }
+    BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(level[0]));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_merkle_tree_poseidon_pallas) {
+    typedef algebra::fields::pallas_base_field field_type;
+    typedef hashes::poseidon<hashes::detail::poseidon_policy<field_type, 128, 2>> hash_type;
+    typedef typename field_type::value_type element_type;
+
+    hashes::incremental_merkle_tree<hash_type, 2> tree;
+    std::vector<element_type> level(4, element_type());
+    for (std::size_t i = 0; i < 3; ++i) {
+        element_type leaf = element_type(i + 7);
+        tree.append(leaf);
+        level[i] = hash<hash_type>(leaf, element_type::zero());
+    }
+
+    while (level.size() > 1) {
+        std::vector<element_type> parents;
+        for (std::size_t i = 0; i < level.size(); i += 2) {
+            parents.push_back(hash<hash_type>(std::vector<element_type> {level[i], level[i + 1]}, element_type::one()));
+        }
+        level = parents;
+    }
+    BOOST_CHECK(tree.root() == level[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,215 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE kangaroo_twelve_test
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/kangaroo_twelve.hpp>
+#include <nil/crypto3/hash/shake.hpp>
+#include <nil/crypto3/hash/turbo_shake.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+// Test vectors are from RFC 9861, section 5
+
+// ptn(n) of RFC 9861: the repeated pattern 00 01 ... FA of length n
+std::vector<std::uint8_t> ptn(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i % 251);
+    }
+    return v;
+}
+
+BOOST_AUTO_TEST_SUITE(turbo_shake_test_suite)
+
+BOOST_AUTO_TEST_CASE(turbo_shake128_vectors) {
+    hashes::turbo_shake128 xof;
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "1e415f1c5983aff2169217277d17bb538cd945a397ddec541f1ce41af2c1b74c");
+
+    xof.reset();
+    xof.squeeze(10000);
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "a3b9b0385900ce761f22aed548e754da10a5242d62e8c658e3f3a923a7555607");
+
+    xof.reset();
+    xof.update(ptn(17));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "9c97d036a3bac819db70ede0ca554ec6e4c2a1a4ffbfd9ec269ca6a111161233");
+
+    xof.reset();
+    xof.update(ptn(17 * 17));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "96c77c279e0126f7fc07c9b07f5cdae1e0be60bdbe10620040e75d7223a624d2");
+
+    xof.reset();
+    xof.update(ptn(17 * 17 * 17));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "d4976eb56bcf118520582b709f73e1d6853e001fdaf80e1b13e0d0599d5fb372");
+}
+
+BOOST_AUTO_TEST_CASE(turbo_shake128_domain_separators) {
+    hashes::turbo_shake128 xof01(0x01);
+    xof01.update(std::vector<std::uint8_t>(1, 0xFF));
+    BOOST_CHECK_EQUAL(to_hex(xof01.squeeze(32)), "012ad664922ce3f81b058735b50aacbde383f1a9a75180b4b9f929550a5552b5");
+
+    hashes::turbo_shake128 xof06(0x06);
+    xof06.update(std::vector<std::uint8_t>(3, 0xFF));
+    BOOST_CHECK_EQUAL(to_hex(xof06.squeeze(32)), "3d03988bb59e681851a192f429ae03988e8f444bc06036a3f1a7d2ccd758d174");
+}
+
+BOOST_AUTO_TEST_CASE(turbo_shake256_vector) {
+    hashes::turbo_shake256 xof;
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(64)),
+                      "367a329dafea871c7802ec67f905ae13c57695dc2c6663c61035f59a18f8e7db"
+                      "11edc0e12e91ea60eb6b32df06dd7f002fbafabb6e13ec1cc20d995547600db0");
+}
+
+BOOST_AUTO_TEST_CASE(turbo_shake_batch_matches_single) {
+    std::vector<std::vector<std::uint8_t>> messages;
+    for (std::size_t n : {0, 1, 167, 168, 169, 1000, 8192}) {
+        messages.push_back(ptn(n));
+    }
+
+    std::vector<const std::uint8_t *> data;
+    std::vector<std::size_t> sizes;
+    for (const std::vector<std::uint8_t> &m : messages) {
+        data.push_back(m.data());
+        sizes.push_back(m.size());
+    }
+
+    std::vector<std::vector<std::uint8_t>> out(messages.size(), std::vector<std::uint8_t>(300));
+    std::vector<std::uint8_t *> out_ptrs;
+    for (std::vector<std::uint8_t> &o : out) {
+        out_ptrs.push_back(o.data());
+    }
+
+    hashes::shake_xof_batch<128, 12, 0x0B> batch;
+    batch.absorb(data.data(), sizes.data(), messages.size());
+    batch.squeeze(out_ptrs.data(), 300);
+
+    for (std::size_t i = 0; i != messages.size(); ++i) {
+        hashes::turbo_shake128 xof(0x0B);
+        xof.update(messages[i]);
+        BOOST_CHECK(xof.squeeze(300) == out[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(kangaroo_twelve_test_suite)
+
+BOOST_AUTO_TEST_CASE(kt128_vectors) {
+    hashes::kt128 h;
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e5");
+
+    h.update(ptn(17));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "6bf75fa2239198db4772e36478f8e19b0f371205f6a9a93a273f51df37122888");
+
+    h.update(ptn(17 * 17));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "0c315ebcdedbf61426de7dcf8fb725d1e74675d7f5327a5067f367b108ecb67c");
+
+    h.update(ptn(17 * 17 * 17));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "cb552e2ec77d9910701d578b457ddf772c12e322e4ee7fe417f92c758f0d59d0");
+
+    h.update(ptn(17 * 17 * 17 * 17));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "8701045e22205345ff4dda05555cbb5c3af1a771c2b89baef37db43d9998b9fe");
+}
+
+BOOST_AUTO_TEST_CASE(kt128_customization) {
+    hashes::kt128 h(ptn(41));
+    h.update(std::vector<std::uint8_t>(1, 0xFF));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "d848c5068ced736f4462159b9867fd4c20b808acc3d5bc48e0b06ba0a3762ec4");
+}
+
+BOOST_AUTO_TEST_CASE(kt128_chunk_boundaries) {
+    hashes::kt128 h;
+    h.update(ptn(8191));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "1b577636f723643e990cc7d6a659837436fd6a103626600eb8301cd1dbe553d6");
+
+    h.update(ptn(8192));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "48f256f6772f9edfb6a8b661ec92dc93b95ebd05a08a17b39ae3490870c926c3");
+
+    // The customization string alone pushes the message into a second chunk
+    hashes::kt128 c(ptn(8189));
+    c.update(ptn(8192));
+    BOOST_CHECK_EQUAL(to_hex(c.finalize(32)), "3ed12f70fb05ddb58689510ab3e4d23c6c6033849aa01e1d8c220a297fedcd0b");
+}
+
+BOOST_AUTO_TEST_CASE(kt256_vectors) {
+    hashes::kt256 h;
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(64)),
+                      "b23d2e9cea9f4904e02bec06817fc10ce38ce8e93ef4c89e6537076af8646404"
+                      "e3e8b68107b8833a5d30490aa33482353fd4adc7148ecb782855003aaebde4a9");
+
+    h.update(ptn(17 * 17 * 17));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(64)),
+                      "647efb49fe9d717500171b41e7f11bd491544443209997ce1c2530d15eb1ffbb"
+                      "598935ef954528ffc152b1e4d731ee2683680674365cd191d562bae753b84aa5");
+}
+
+BOOST_AUTO_TEST_CASE(kt_chunks_and_threads) {
+    std::vector<std::uint8_t> m(200000);
+    for (std::size_t i = 0; i != m.size(); ++i) {
+        m[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+
+    for (std::size_t threads : {1, 3, 8}) {
+        hashes::kt128 h(std::string("custom"), threads);
+        for (std::size_t chunk : {1000, 8192, 8193, 65536, 200000}) {
+            for (std::size_t i = 0; i < m.size(); i += chunk) {
+                h.update(m.data() + i, std::min(chunk, m.size() - i));
+            }
+            BOOST_CHECK_EQUAL(to_hex(h.finalize(32)),
+                              "af412620267f5e65c08b546b6d475cdbd5af012530db8aea14efe8d0340115fa");
+        }
+
+        hashes::kt256 h256(std::string(), threads);
+        h256.update(m);
+        BOOST_CHECK_EQUAL(to_hex(h256.finalize(64)),
+                          "bb3aee9e35a69268e0249eb855fd911f950a9c6d383b972b14663f5384c4e514"
+                          "318c577f95ab773b0ad30ce750ae47b206879f5acd15345113c36386414ffcdc");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(kt128_squeeze_continues_finalize) {
+    hashes::kt128 a, b;
+    a.update(ptn(20000));
+    b.update(ptn(20000));
+
+    std::vector<std::uint8_t> whole = a.finalize(100);
+    std::vector<std::uint8_t> first = b.squeeze(40);
+    std::vector<std::uint8_t> second = b.squeeze(60);
+    first.insert(first.end(), second.begin(), second.end());
+    BOOST_CHECK(first == whole);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,216 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE kdf_test
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/hkdf.hpp>
+#include <nil/crypto3/hash/pbkdf2.hpp>
+
+#include <nil/crypto3/hash/blake2b.hpp>
+#include <nil/crypto3/hash/md5.hpp>
+#include <nil/crypto3/hash/ripemd.hpp>
+#include <nil/crypto3/hash/sha1.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/sha3.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+std::vector<std::uint8_t> octet_range(std::uint8_t first, std::uint8_t last) {
+    std::vector<std::uint8_t> v;
+    for (unsigned c = first; c != last; ++c) {
+        v.push_back(static_cast<std::uint8_t>(c));
+    }
+    return v;
+}
+
+struct pbkdf2_case {
+    std::string password;
+    std::string salt;
+    std::size_t iterations;
+    std::size_t size;
+    std::string expected;
+};
+
+template<typename Hash>
+void check_pbkdf2(const std::vector<pbkdf2_case> &cases) {
+    for (const pbkdf2_case &c : cases) {
+        hashes::pbkdf2<Hash> kdf(c.password);
+        BOOST_CHECK_EQUAL(to_hex(kdf.derive(c.salt, c.iterations, c.size)), c.expected);
+    }
+}
+
+// PBKDF2 spelled out on hmac, one U_j after another
+template<typename Hash>
+std::vector<std::uint8_t> plain_pbkdf2(const std::string &password, const std::string &salt, std::size_t iterations,
+                                       std::size_t size) {
+    hashes::hmac<Hash> mac(password);
+    std::vector<std::uint8_t> out;
+    for (std::uint8_t i = 1; out.size() < size; ++i) {
+        std::vector<std::uint8_t> m(salt.begin(), salt.end());
+        m.insert(m.end(), {0, 0, 0, i});
+        typename Hash::digest_type u = mac(m), t = u;
+        for (std::size_t j = 1; j != iterations; ++j) {
+            u = mac(u);
+            for (std::size_t k = 0; k != t.size(); ++k) {
+                t[k] ^= u[k];
+            }
+        }
+        out.insert(out.end(), t.begin(), t.end());
+    }
+    out.resize(size);
+    return out;
+}
+
+BOOST_AUTO_TEST_SUITE(hkdf_test_suite)
+
+// RFC 5869, Appendix A
+BOOST_AUTO_TEST_CASE(hkdf_sha2_256) {
+    hashes::hkdf<hashes::sha2<256>> basic(octet_range(0x00, 0x0d), std::vector<std::uint8_t>(22, 0x0b));
+    BOOST_CHECK_EQUAL(std::to_string(basic.prk()), "077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5");
+    BOOST_CHECK_EQUAL(to_hex(basic.expand(octet_range(0xf0, 0xfa), 42)),
+                      "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865");
+
+    hashes::hkdf<hashes::sha2<256>> long_inputs(octet_range(0x60, 0xb0), octet_range(0x00, 0x50));
+    BOOST_CHECK_EQUAL(to_hex(long_inputs.expand(octet_range(0xb0, 0xff), 0)), "");
+    std::vector<std::uint8_t> info = octet_range(0xb0, 0xff);
+    info.push_back(0xff);
+    BOOST_CHECK_EQUAL(to_hex(long_inputs.expand(info, 82)),
+                      "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c"
+                      "59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71"
+                      "cc30c58179ec3e87c14c01d5c1f3434f1d87");
+
+    hashes::hkdf<hashes::sha2<256>> no_salt(std::vector<std::uint8_t>(), std::vector<std::uint8_t>(22, 0x0b));
+    BOOST_CHECK_EQUAL(to_hex(no_salt.expand(std::vector<std::uint8_t>(), 42)),
+                      "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8");
+
+    // Expanding from the extracted key alone
+    hashes::hkdf<hashes::sha2<256>> expand_only(no_salt.prk());
+    BOOST_CHECK_EQUAL(to_hex(expand_only.expand(std::vector<std::uint8_t>(), 42)),
+                      "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8");
+}
+
+BOOST_AUTO_TEST_CASE(hkdf_sha1) {
+    hashes::hkdf<hashes::sha1> kdf(octet_range(0x00, 0x0d), std::vector<std::uint8_t>(11, 0x0b));
+    BOOST_CHECK_EQUAL(std::to_string(kdf.prk()), "9b6c18c432a7bf8f0e71c8eb88f4b30baa2ba243");
+    BOOST_CHECK_EQUAL(to_hex(kdf.expand(octet_range(0xf0, 0xfa), 42)),
+                      "085a01ea1b10f36933068b56efa5ad81a4f14b822f5b091568a9cdd4f155fda2c22e422478d305f3f896");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(pbkdf2_test_suite)
+
+// RFC 6070
+BOOST_AUTO_TEST_CASE(pbkdf2_sha1) {
+    check_pbkdf2<hashes::sha1>(
+        {{"password", "salt", 1, 20, "0c60c80f961f0e71f3a9b524af6012062fe037a6"},
+         {"password", "salt", 2, 20, "ea6c014dc72d6f8ccd1ed92ace1d41f0d8de8957"},
+         {"password", "salt", 4096, 20, "4b007901b765489abead49d926f721d065a429c1"},
+         {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 25,
+          "3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038"},
+         {std::string("pass\0word", 9), std::string("sa\0lt", 5), 4096, 16, "56fa6aa75548099dcc37d7f03425e0c3"}});
+}
+
+BOOST_AUTO_TEST_CASE(pbkdf2_sha2_256) {
+    check_pbkdf2<hashes::sha2<256>>(
+        {{"password", "salt", 1, 32, "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b"},
+         {"password", "salt", 4096, 20, "c5e478d59288c841aa530db6845c4c8d962893a0"},
+         {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 25,
+          "348c89dbcbd32b2f32d814b8116e84cf2b17347ebc1800181c"},
+         {"password", "salt", 1000, 150,
+          "632c2812e46d4604102ba7618e9d6d7d2f8128f6266b4a03264d2a0460b7dcb388b3b1131f741bcbeb02541c8c2e97bd"
+          "8bed62ab6425542e45512b7312f440ebc6e21f4356a5edf32cf0394e0d5be940e0e930cfe21e38a3ff94e28d26c23fac"
+          "7701ac92f52ade33aad5663b057526d66c32f2239c65e5510f3bb57cb914f1e0e051605dce56d911c8ddfcea6105cb8f"
+          "2fa3a4988697"}});
+}
+
+BOOST_AUTO_TEST_CASE(pbkdf2_sha2_224) {
+    check_pbkdf2<hashes::sha2<224>>(
+        {{"password", "salt", 4096, 20, "218c453bf90635bd0a21a75d172703ff6108ef60"},
+         {"password", "salt", 1000, 150,
+          "d3bcf320fd918908eafcaa460faf40e201f6508d4e6f3d9c1c0abd30dae08cc8b1bc0657e2ebc229d22e48df55df72e8"
+          "3f2e50db2324a73b01ddbb88831662f0080da7025964a778aee580fd2b77824070dbd32f40158e709ad32ac7e2dd28df"
+          "c9d95cf326f3c959ce2d1a9c8b1d14a68ea5a5e8fd2659d955aba30c4316ae60bcfe8813a8002ce27ef25dd41f594883"
+          "746b796f3db1"}});
+}
+
+BOOST_AUTO_TEST_CASE(pbkdf2_sha2_512) {
+    check_pbkdf2<hashes::sha2<512>>(
+        {{"password", "salt", 4096, 20, "d197b1b33db0143e018b12f3d1d1479e6cdebdcc"},
+         {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 25,
+          "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868"}});
+}
+
+BOOST_AUTO_TEST_CASE(pbkdf2_little_endian_merkle_damgard) {
+    check_pbkdf2<hashes::md5>({{"password", "salt", 4096, 20, "15001f89b9c29ee6998c520d1a0629e893cc3f99"}});
+    check_pbkdf2<hashes::ripemd160>({{"password", "salt", 4096, 20, "99a40d3fe4ee95869791d9faa248645627827621"}});
+}
+
+BOOST_AUTO_TEST_CASE(pbkdf2_through_hmac) {
+    check_pbkdf2<hashes::sha3<256>>({{"password", "salt", 4096, 20, "778b6e237a0f49621549ff70d218d2080756b9fb"}});
+    check_pbkdf2<hashes::blake2b<512>>(
+        {{"password", "salt", 4096, 20, "9d4f324ef40b5be658fa0ab94a168664f060c0c9"}});
+}
+
+BOOST_AUTO_TEST_CASE(pbkdf2_batch) {
+    typedef hashes::pbkdf2<hashes::sha2<256>> kdf_type;
+
+    // Batches of every size up to more than two vectors full, with distinct passwords and salts
+    for (std::size_t count = 1; count <= 19; count += 3) {
+        std::vector<kdf_type> kdfs;
+        std::vector<std::string> salts;
+        for (std::size_t i = 0; i != count; ++i) {
+            kdfs.emplace_back("password" + std::to_string(i));
+            salts.push_back("salt" + std::to_string(i * 7));
+        }
+
+        std::vector<const kdf_type *> keys;
+        std::vector<const std::uint8_t *> salt_data;
+        std::vector<std::size_t> salt_sizes;
+        std::vector<std::vector<std::uint8_t>> out(count, std::vector<std::uint8_t>(40));
+        std::vector<std::uint8_t *> out_data;
+        for (std::size_t i = 0; i != count; ++i) {
+            keys.push_back(&kdfs[i]);
+            salt_data.push_back(reinterpret_cast<const std::uint8_t *>(salts[i].data()));
+            salt_sizes.push_back(salts[i].size());
+            out_data.push_back(out[i].data());
+        }
+
+        kdf_type::derive(keys.data(), salt_data.data(), salt_sizes.data(), count, 100, out_data.data(), 40);
+        for (std::size_t i = 0; i != count; ++i) {
+            BOOST_CHECK(out[i] == plain_pbkdf2<hashes::sha2<256>>("password" + std::to_string(i), salts[i], 100, 40));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
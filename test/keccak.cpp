@@ -26,6 +26,8 @@
 #define BOOST_TEST_MODULE keccak_test
 
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -39,6 +41,8 @@
 
 #include <nil/crypto3/hash/keccak.hpp>
 
+#include <dispatch.hpp>
+
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
 
@@ -482,3 +486,37 @@ BOOST_AUTO_TEST_CASE(keccak_512_preprocessor2) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(keccak_backend_test_suite)
+
+BOOST_AUTO_TEST_CASE(keccak_backend_name) {
+    const char *backend = hashes::keccak_1600_backend();
+    const char *known[] = {"avx2", "x86_64", "armv8", "generic"};
+
+    BOOST_CHECK(std::any_of(std::begin(known), std::end(known),
+                            [backend](const char *name) { return !std::strcmp(backend, name); }));
+}
+
+#if BOOST_ARCH_X86_64
+BOOST_AUTO_TEST_CASE(keccak_dispatch_backends_agree) {
+    typedef hashes::detail::keccak_1600_policy<256> policy_type;
+    typedef hashes::detail::keccak_1600_dispatch_impl<policy_type> dispatch_type;
+
+    policy_type::state_type state;
+    lcg_words(0x9e3779b97f4a7c15).fill(state);
+
+    policy_type::state_type expected = state;
+    hashes::detail::keccak_1600_impl<policy_type>::permute(expected);
+
+    for_each_backend<dispatch_type>({&hashes::detail::cpu_features::avx2},
+                                    [&](const dispatch_type::backend_type &backend) {
+                                        policy_type::state_type permuted = state;
+                                        backend.permute(permuted);
+                                        BOOST_CHECK(permuted == expected);
+                                    });
+
+    BOOST_CHECK_EQUAL(dispatch_type::backend().name, hashes::keccak_1600_backend());
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
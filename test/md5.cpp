@@ -126,6 +126,25 @@ BOOST_AUTO_TEST_CASE(md5_shortmsg_byte3) {
     BOOST_CHECK_EQUAL("f96b697d7cb7938d525a2f31aaf161d0", std::to_string(d).data());
 }
 
+BOOST_AUTO_TEST_CASE(md5_length_boundary) {
+    // The padding and the length share the last block up to 55 octets, and need an extra block from 56 on
+    std::string a(55, 'a');
+    hashes::md5::digest_type d = hash<hashes::md5>(a);
+    BOOST_CHECK_EQUAL("ef1772b6dff9a122358552954ad0df65", std::to_string(d).data());
+
+    a.push_back('a');
+    d = hash<hashes::md5>(a);
+    BOOST_CHECK_EQUAL("3b0c8ac703f828b04c6c197006d17218", std::to_string(d).data());
+
+    a.resize(63, 'a');
+    d = hash<hashes::md5>(a);
+    BOOST_CHECK_EQUAL("b06521f39153d618550606be297466d5", std::to_string(d).data());
+
+    a.push_back('a');
+    d = hash<hashes::md5>(a);
+    BOOST_CHECK_EQUAL("014842d480b571495a4a0363793f7367", std::to_string(d).data());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(md5_accumulator_test_suite)
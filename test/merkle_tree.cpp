@@ -0,0 +1,219 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+
+#define BOOST_TEST_MODULE merkle_tree_test
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/merkle_tree.hpp>
+
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/poseidon.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+
+#include <nil/crypto3/algebra/fields/pallas/base_field.hpp>
+
+using namespace nil::crypto3;
+
+std::vector<std::vector<std::uint8_t>> make_leaves(std::size_t count) {
+    std::vector<std::vector<std::uint8_t>> leaves(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        leaves[i].resize((i * 29) % 150);
+        for (std::size_t j = 0; j < leaves[i].size(); ++j) {
+            leaves[i][j] = static_cast<std::uint8_t>(i * 5 + j);
+        }
+    }
+    return leaves;
+}
+
+// Builds the levels one node at a time, the way callers did by hand, with the leaf and node prefixes
+template<typename Hash>
+typename Hash::digest_type plain_root(const std::vector<std::vector<std::uint8_t>> &leaves, std::size_t arity) {
+    typedef typename hashes::hasher<Hash>::digest_type digest_type;
+
+    std::vector<digest_type> level;
+    for (const auto &leaf : leaves) {
+        hashes::hasher<Hash> h;
+        h.update(std::vector<std::uint8_t> {0x00});
+        level.push_back(h.update(leaf.data(), leaf.size()).finalize());
+    }
+
+    while (level.size() > 1) {
+        std::vector<digest_type> parents;
+        for (std::size_t i = 0; i < level.size(); i += arity) {
+            hashes::hasher<Hash> h;
+            h.update(std::vector<std::uint8_t> {0x01});
+            for (std::size_t j = i; j < std::min(level.size(), i + arity); ++j) {
+                h.update(level[j].data(), level[j].size());
+            }
+            parents.push_back(h.finalize());
+        }
+        level = parents;
+    }
+    return level[0];
+}
+
+template<typename Hash, std::size_t Arity>
+void check_tree(std::size_t count, std::size_t threads) {
+    std::vector<std::vector<std::uint8_t>> leaves = make_leaves(count);
+
+    hashes::merkle_tree<Hash, Arity> tree(leaves, threads);
+    BOOST_REQUIRE_EQUAL(tree.leaves_count(), count);
+    BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(plain_root<Hash>(leaves, Arity)));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        typename hashes::merkle_tree<Hash, Arity>::proof_type proof = tree.proof(i);
+        typename hashes::merkle_tree<Hash, Arity>::digest_type leaf = tree.hash_leaf(leaves[i]);
+
+        BOOST_CHECK_EQUAL(std::to_string(leaf), std::to_string(tree.node(0, i)));
+        BOOST_CHECK(proof.validate(leaf, tree.root(), tree.levels() - 1));
+        if (count > 1) {
+            leaf[0] ^= 1;
+            BOOST_CHECK(!proof.validate(leaf, tree.root(), tree.levels() - 1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(merkle_tree_test_suite)
+
+BOOST_AUTO_TEST_CASE(merkle_tree_sha2_256_roots) {
+    std::vector<std::string> leaves = {"a", "b", "c", "d", "e"};
+
+    hashes::merkle_tree<hashes::sha2<256>> binary(leaves);
+    BOOST_CHECK_EQUAL(binary.levels(), 4);
+    BOOST_CHECK_EQUAL(binary.nodes().size(), 11);
+    BOOST_CHECK_EQUAL("5addd685bca30b91467dbbbc36a6802db92e27997350d57cda1b80c45e47be22",
+                      std::to_string(binary.root()));
+
+    hashes::merkle_tree<hashes::sha2<256>, 4> quaternary(leaves);
+    BOOST_CHECK_EQUAL(quaternary.levels(), 3);
+    BOOST_CHECK_EQUAL("020106555ac2c26a96d955203c6362cdabf4c3882448b39b4aac939ad7be4a2b",
+                      std::to_string(quaternary.root()));
+
+    std::vector<std::string> single = {""};
+    hashes::merkle_tree<hashes::sha2<256>> leaf(single);
+    BOOST_CHECK_EQUAL(leaf.levels(), 1);
+    BOOST_CHECK_EQUAL("6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d",
+                      std::to_string(leaf.root()));
+    BOOST_CHECK(leaf.proof(0).path().empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree_sha2_256_shapes) {
+    // Levels which leave some nodes with fewer children than the arity
+    for (std::size_t count : {1, 2, 3, 7, 16, 17, 100}) {
+        check_tree<hashes::sha2<256>, 2>(count, 1);
+        check_tree<hashes::sha2<256>, 3>(count, 1);
+        check_tree<hashes::sha2<256>, 4>(count, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree_keccak_256_shapes) {
+    for (std::size_t count : {1, 5, 9, 33}) {
+        check_tree<hashes::keccak_1600<256>, 2>(count, 1);
+        check_tree<hashes::keccak_1600<256>, 8>(count, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree_sha2_256_threads) {
+    // Enough leaves for the lower levels to be split between the threads
+    check_tree<hashes::sha2<256>, 2>(3000, 4);
+    check_tree<hashes::sha2<256>, 4>(2049, 3);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree_malformed_proofs) {
+    std::vector<std::vector<std::uint8_t>> leaves = make_leaves(6);
+    hashes::merkle_tree<hashes::sha2<256>> tree(leaves);
+    hashes::merkle_tree<hashes::sha2<256>>::digest_type leaf = tree.hash_leaf(leaves[5]);
+
+    std::size_t depth = tree.levels() - 1;
+
+    hashes::merkle_tree<hashes::sha2<256>>::proof_type proof = tree.proof(5);
+    BOOST_CHECK(proof.validate(leaf, tree.root(), depth));
+    BOOST_CHECK(!proof.validate(leaf, tree.root(), depth + 1));
+
+    hashes::merkle_tree<hashes::sha2<256>>::proof_type moved(4, proof.path());
+    BOOST_CHECK(!moved.validate(leaf, tree.root(), depth));
+
+    hashes::merkle_tree<hashes::sha2<256>>::proof_type beyond(5 + 8, proof.path());
+    BOOST_CHECK(!beyond.validate(leaf, tree.root(), depth));
+
+    // The path of an inner node, which checks out against the root, but not at the depth of a leaf
+    std::vector<hashes::merkle_tree<hashes::sha2<256>>::proof_type::siblings_type> upper(proof.path().begin() + 1,
+                                                                                       proof.path().end());
+    hashes::merkle_tree<hashes::sha2<256>>::proof_type inner(2, upper);
+    BOOST_CHECK(inner.root(tree.node(1, 2)) == tree.root());
+    BOOST_CHECK(!inner.validate(tree.node(1, 2), tree.root(), depth));
+
+    // Nor is an inner node the digest of a leaf made of its children
+    std::vector<std::uint8_t> children(tree.node(0, 4).begin(), tree.node(0, 4).end());
+    children.insert(children.end(), tree.node(0, 5).begin(), tree.node(0, 5).end());
+    BOOST_CHECK(tree.hash_leaf(children) != tree.node(1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree_poseidon_pallas) {
+    typedef algebra::fields::pallas_base_field field_type;
+    typedef hashes::poseidon<hashes::detail::poseidon_policy<field_type, 128, 2>> hash_type;
+    typedef typename field_type::value_type element_type;
+
+    std::vector<element_type> leaves;
+    for (std::size_t i = 0; i < 5; ++i) {
+        leaves.push_back(element_type(i + 1));
+    }
+
+    hashes::merkle_tree<hash_type> tree(leaves, 2);
+
+    std::vector<element_type> level;
+    for (const element_type &leaf : leaves) {
+        level.push_back(hash<hash_type>(leaf, element_type::zero()));
+    }
+    while (level.size() > 1) {
+        std::vector<element_type> parents;
+        for (std::size_t i = 0; i < level.size(); i += 2) {
+            std::vector<element_type> children(level.begin() + i, level.begin() + std::min(level.size(), i + 2));
+            parents.push_back(hash<hash_type>(children, element_type::one()));
+        }
+        level = parents;
+    }
+    BOOST_CHECK(tree.root() == level[0]);
+
+    for (std::size_t i = 0; i < leaves.size(); ++i) {
+        BOOST_CHECK(tree.proof(i).validate(tree.hash_leaf(leaves[i]), tree.root(), tree.levels() - 1));
+    }
+
+    // Octet leaves go through the overload for containers of integers
+    std::vector<std::vector<std::uint8_t>> octets = make_leaves(3);
+    hashes::merkle_tree<hash_type> packed(octets);
+    for (std::size_t i = 0; i < octets.size(); ++i) {
+        BOOST_CHECK(packed.node(0, i) == hash<hash_type>(octets[i], element_type::zero()));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
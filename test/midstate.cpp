@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE hash_midstate_test
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/hash_state.hpp>
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/midstate.hpp>
+
+#include <nil/crypto3/hash/blake2b.hpp>
+#include <nil/crypto3/hash/md5.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/sha3.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+template<typename Hash>
+hashes::midstate<Hash> round_trip(const hashes::midstate<Hash> &m) {
+    typename hashes::midstate<Hash>::serialized_type bytes = m.serialize();
+
+    hashes::midstate<Hash> r;
+    BOOST_CHECK(r.deserialize(bytes));
+    return r;
+}
+
+template<typename Hash>
+void check_resume() {
+    const std::vector<std::uint8_t> m = make_message(500);
+    typename Hash::digest_type d = hash<Hash>(m);
+    const std::string expected = std::to_string(d);
+
+    for (std::size_t split : {0, 1, 63, 64, 65, 128, 136, 144, 200, 272, 499, 500}) {
+        // Accumulator snapshot resumed by both an accumulator and a hasher
+        accumulator_set<Hash> acc;
+        hash<Hash>(m.begin(), m.begin() + split, acc);
+        hashes::midstate<Hash> snapshot = round_trip(export_midstate(acc));
+
+        accumulator_set<Hash> resumed_acc;
+        import_midstate(resumed_acc, snapshot);
+        hash<Hash>(m.begin() + split, m.end(), resumed_acc);
+        BOOST_CHECK_EQUAL(std::to_string(accumulators::extract::hash<Hash>(resumed_acc)), expected);
+
+        hashes::hasher<Hash> resumed_hasher;
+        resumed_hasher.import_midstate(snapshot);
+        BOOST_CHECK_EQUAL(std::to_string(resumed_hasher.update(m.data() + split, m.size() - split).finalize()),
+                          expected);
+
+        // Hasher snapshot resumed by an accumulator
+        hashes::hasher<Hash> h;
+        h.update(m.data(), split);
+        accumulator_set<Hash> from_hasher;
+        import_midstate(from_hasher, round_trip(h.export_midstate()));
+        hash<Hash>(m.begin() + split, m.end(), from_hasher);
+        BOOST_CHECK_EQUAL(std::to_string(accumulators::extract::hash<Hash>(from_hasher)), expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(midstate_test_suite)
+
+BOOST_AUTO_TEST_CASE(midstate_sha2_256_layout) {
+    hashes::hasher<hashes::sha2<256>> h;
+    h.update(make_message(3));
+    hashes::midstate<hashes::sha2<256>>::serialized_type s = h.export_midstate().serialize();
+
+    BOOST_CHECK_EQUAL(s.size(), 8 + 8 + (8 + 16) * 4);
+    // Version
+    BOOST_CHECK_EQUAL(s[0], 3);
+    // Tag: SHA-256 of the empty message starts with e3b0c442
+    BOOST_CHECK_EQUAL(s[1], 0xe3);
+    BOOST_CHECK_EQUAL(s[2], 0xb0);
+    BOOST_CHECK_EQUAL(s[3], 0xc4);
+    BOOST_CHECK_EQUAL(s[4], 0x42);
+    // State words, block words
+    BOOST_CHECK_EQUAL(s[5], 8);
+    BOOST_CHECK_EQUAL(s[6], 16);
+    // Flags
+    BOOST_CHECK_EQUAL(s[7], 0);
+    // Bits seen
+    BOOST_CHECK_EQUAL(s[8], 24);
+    BOOST_CHECK_EQUAL(s[9], 0);
+    // First word of the initial state, 0x6a09e667
+    BOOST_CHECK_EQUAL(s[16], 0x67);
+    BOOST_CHECK_EQUAL(s[17], 0xe6);
+    BOOST_CHECK_EQUAL(s[18], 0x09);
+    BOOST_CHECK_EQUAL(s[19], 0x6a);
+}
+
+BOOST_AUTO_TEST_CASE(midstate_deserialize_mismatch) {
+    hashes::hasher<hashes::sha2<256>> h;
+    hashes::midstate<hashes::sha2<256>>::serialized_type s = h.export_midstate().serialize();
+
+    hashes::midstate<hashes::sha2<512>> other;
+    BOOST_CHECK(!other.deserialize(s));
+
+    // Same state and block layout, told apart by the tag only
+    hashes::midstate<hashes::sha2<224>> same_layout;
+    BOOST_CHECK(!same_layout.deserialize(s));
+    hashes::hasher<hashes::sha2<224>> h224;
+    BOOST_CHECK(!hashes::midstate<hashes::sha2<256>>().deserialize(h224.export_midstate().serialize()));
+
+    hashes::midstate<hashes::sha2<256>> truncated;
+    BOOST_CHECK(!truncated.deserialize(s.begin(), s.end() - 1));
+
+    hashes::midstate<hashes::sha2<256>>::serialized_type bad_tag = s;
+    bad_tag[1] ^= 1;
+    hashes::midstate<hashes::sha2<256>> tampered;
+    BOOST_CHECK(!tampered.deserialize(bad_tag));
+
+    hashes::midstate<hashes::sha2<256>>::serialized_type bad_flags = s;
+    bad_flags[7] = 2;
+    hashes::midstate<hashes::sha2<256>> unknown_flags;
+    BOOST_CHECK(!unknown_flags.deserialize(bad_flags));
+
+    s[0] = 2;
+    hashes::midstate<hashes::sha2<256>> unknown_version;
+    BOOST_CHECK(!unknown_version.deserialize(s));
+}
+
+BOOST_AUTO_TEST_CASE(midstate_merkle_damgard) {
+    check_resume<hashes::md5>();
+    check_resume<hashes::sha2<256>>();
+    check_resume<hashes::sha2<512>>();
+}
+
+BOOST_AUTO_TEST_CASE(midstate_sponge) {
+    check_resume<hashes::sha3<256>>();
+    check_resume<hashes::sha3<512>>();
+}
+
+BOOST_AUTO_TEST_CASE(midstate_haifa) {
+    check_resume<hashes::blake2b<256>>();
+    check_resume<hashes::blake2b<512>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE hash_parallel_for_test
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/detail/parallel_for.hpp>
+
+using namespace nil::crypto3::hashes;
+
+BOOST_AUTO_TEST_SUITE(parallel_for_test_suite)
+
+BOOST_AUTO_TEST_CASE(parallel_for_covers_range) {
+    for (std::size_t threads : {1, 2, 3, 8}) {
+        std::vector<std::atomic<int>> seen(1000);
+        detail::parallel_for(seen.size(), threads, [&seen](std::size_t first, std::size_t last) {
+            for (; first != last; ++first) {
+                ++seen[first];
+            }
+        });
+        for (const std::atomic<int> &s : seen) {
+            BOOST_CHECK_EQUAL(s.load(), 1);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_rethrows) {
+    // Whichever range throws, the call returns only after every range is done
+    for (std::size_t throwing : {0, 500, 999}) {
+        std::atomic<std::size_t> done(0);
+        BOOST_CHECK_THROW(detail::parallel_for(1000, 4,
+                                               [&done, throwing](std::size_t first, std::size_t last) {
+                                                   if (first <= throwing && throwing < last) {
+                                                       throw std::runtime_error("range failed");
+                                                   }
+                                                   done += last - first;
+                                               }),
+                          std::runtime_error);
+        BOOST_CHECK_EQUAL(done.load(), 750);
+    }
+
+    // The pool is still usable afterwards
+    std::atomic<std::size_t> done(0);
+    detail::parallel_for(1000, 4, [&done](std::size_t first, std::size_t last) { done += last - first; });
+    BOOST_CHECK_EQUAL(done.load(), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
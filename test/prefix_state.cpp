@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE hash_prefix_state_test
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/hash_state.hpp>
+#include <nil/crypto3/hash/prefix_state.hpp>
+
+#include <nil/crypto3/hash/blake2b.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/sha3.hpp>
+
+using namespace nil::crypto3;
+
+template<typename Hash>
+void check_prefix() {
+    const std::string tag = "QUUX-V01-CS02-with-expander-SHA256-128";
+
+    for (std::size_t prefix_size : {0, 7, 64, 72, 136, 200}) {
+        std::vector<std::uint8_t> prefix(prefix_size);
+        for (std::size_t i = 0; i < prefix_size; ++i) {
+            prefix[i] = static_cast<std::uint8_t>(tag[i % tag.size()]);
+        }
+        const hashes::prefix_state<Hash> state(prefix);
+
+        for (std::size_t suffix_size : {0, 1, 31, 64, 100}) {
+            std::vector<std::uint8_t> suffix(suffix_size, static_cast<std::uint8_t>(suffix_size));
+            std::vector<std::uint8_t> m(prefix);
+            m.insert(m.end(), suffix.begin(), suffix.end());
+
+            typename Hash::digest_type expected = hash<Hash>(m);
+            BOOST_CHECK_EQUAL(std::to_string(state(suffix)), std::to_string(expected));
+
+            typename hashes::prefix_state<Hash>::hasher_type h = state.fork();
+            BOOST_CHECK_EQUAL(std::to_string(h.update(suffix).finalize()), std::to_string(expected));
+        }
+    }
+}
+
+template<typename Hash>
+void check_block_aligned_prefix() {
+    typedef typename hashes::prefix_state<Hash>::hasher_type hasher_type;
+
+    const std::vector<std::uint8_t> prefix(2 * hasher_type::block_values, 0x5c);
+    const hashes::prefix_state<Hash> state(prefix);
+
+    // Both blocks are compressed and nothing is left in the cache
+    hashes::midstate<Hash> m = state.export_midstate();
+    BOOST_CHECK(m.block_compressed);
+    BOOST_CHECK_EQUAL(m.total_seen, 2 * hasher_type::block_bits);
+    BOOST_CHECK(m.state != hasher_type().export_midstate().state);
+    BOOST_CHECK(m.state != hashes::prefix_state<Hash>(prefix.begin(), prefix.end() - 1).export_midstate().state);
+
+    const std::vector<std::uint8_t> suffix = {1, 2, 3};
+    std::vector<std::uint8_t> message(prefix);
+    message.insert(message.end(), suffix.begin(), suffix.end());
+    typename Hash::digest_type d = hash<Hash>(message);
+    const std::string expected = std::to_string(d);
+
+    hashes::midstate<Hash> serialized;
+    BOOST_CHECK(serialized.deserialize(m.serialize()));
+    BOOST_CHECK(serialized.block_compressed);
+
+    hasher_type resumed;
+    resumed.import_midstate(serialized);
+    BOOST_CHECK_EQUAL(std::to_string(resumed.update(suffix).finalize()), expected);
+
+    accumulator_set<Hash> acc;
+    import_midstate(acc, serialized);
+    hash<Hash>(suffix, acc);
+    BOOST_CHECK_EQUAL(std::to_string(accumulators::extract::hash<Hash>(acc)), expected);
+    BOOST_CHECK(!export_midstate(acc).block_compressed);
+
+    BOOST_CHECK_EQUAL(std::to_string(hashes::prefix_state<Hash>(serialized)(suffix)), expected);
+    typename Hash::digest_type prefix_digest = hash<Hash>(prefix);
+    BOOST_CHECK_EQUAL(std::to_string(state(std::vector<std::uint8_t>())), std::to_string(prefix_digest));
+}
+
+BOOST_AUTO_TEST_SUITE(prefix_state_test_suite)
+
+BOOST_AUTO_TEST_CASE(prefix_state_absorb) {
+    // sha256("abc")
+    hashes::prefix_state<hashes::sha2<256>> state;
+    state.absorb(std::string("a")).absorb(std::string("b"));
+
+    BOOST_CHECK_EQUAL(std::to_string(state(std::string("c"))),
+                      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+BOOST_AUTO_TEST_CASE(prefix_state_merkle_damgard) {
+    check_prefix<hashes::sha2<256>>();
+}
+
+BOOST_AUTO_TEST_CASE(prefix_state_sponge) {
+    check_prefix<hashes::sha3<256>>();
+}
+
+BOOST_AUTO_TEST_CASE(prefix_state_haifa) {
+    check_prefix<hashes::blake2b<512>>();
+}
+
+BOOST_AUTO_TEST_CASE(prefix_state_block_aligned) {
+    check_block_aligned_prefix<hashes::sha2<256>>();
+    check_block_aligned_prefix<hashes::sha3<256>>();
+    check_block_aligned_prefix<hashes::blake2b<512>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
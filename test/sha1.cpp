@@ -26,6 +26,8 @@
 #define BOOST_TEST_MODULE sha1_test
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -39,6 +41,12 @@
 
 #include <nil/crypto3/hash/sha1.hpp>
 
+#if BOOST_ARCH_X86_64
+#include <nil/crypto3/hash/detail/sha1/sha1_dispatch_impl.hpp>
+#endif
+
+#include <dispatch.hpp>
+
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
 
@@ -259,4 +267,59 @@ BOOST_AUTO_TEST_CASE(sha1_preprocessor3) {
     BOOST_CHECK_EQUAL("34aa973cd4c4daa4f61eeb2bdbad27316534016f", std::to_string(s).data());
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END()
+
+#if BOOST_ARCH_X86_64 && defined(CRYPTO3_HAS_SHA_NI)
+BOOST_AUTO_TEST_SUITE(sha1_sha_ni_test_suite)
+
+BOOST_AUTO_TEST_CASE(sha1_sha_ni_matches_davies_meyer) {
+    typedef hashes::detail::sha1_policy policy_type;
+    typedef hashes::davies_meyer_compressor<policy_type::block_cipher_type, hashes::detail::state_adder>
+        reference_type;
+
+    std::uint32_t x = 0x9e3779b9;
+    std::vector<policy_type::block_type> blocks(7);
+    for (policy_type::block_type &block : blocks) {
+        for (std::uint32_t &w : block) {
+            w = x = x * 1664525u + 1013904223u;
+        }
+    }
+
+    policy_type::state_type state = policy_type::iv_generator()(), expected = state;
+    hashes::detail::sha1_sha_ni_impl::process_blocks(state, blocks.data(), blocks.size());
+    for (const policy_type::block_type &block : blocks) {
+        reference_type::process_block(expected, block);
+    }
+
+    BOOST_CHECK(state == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
+
+#if BOOST_ARCH_X86_64
+BOOST_AUTO_TEST_SUITE(sha1_dispatch_test_suite)
+
+BOOST_AUTO_TEST_CASE(sha1_dispatch_backends_agree) {
+    typedef hashes::detail::sha1_policy policy_type;
+    typedef hashes::detail::sha1_dispatch_impl dispatch_type;
+    typedef hashes::davies_meyer_compressor<policy_type::block_cipher_type, hashes::detail::state_adder>
+        reference_type;
+
+    std::vector<policy_type::block_type> blocks(7);
+    lcg_words(0x9e3779b9).fill_blocks(blocks);
+
+    policy_type::state_type expected = policy_type::iv_generator()();
+    reference_type::process_blocks(expected, blocks.data(), blocks.size());
+
+    dispatch_type::backend_type generic = for_each_backend<dispatch_type>(
+        {&hashes::detail::cpu_features::sha_ni}, [&](const dispatch_type::backend_type &backend) {
+            policy_type::state_type state = policy_type::iv_generator()();
+            backend.process_blocks(state, blocks.data(), blocks.size());
+            BOOST_CHECK(state == expected);
+        });
+    BOOST_CHECK_EQUAL(generic.name, std::string("generic"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
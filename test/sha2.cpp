@@ -26,6 +26,8 @@
 #define BOOST_TEST_MODULE sha2_test
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -39,6 +41,12 @@
 
 #include <nil/crypto3/hash/sha2.hpp>
 
+#if BOOST_ARCH_X86_64
+#include <nil/crypto3/hash/detail/sha2/sha2_256_dispatch_impl.hpp>
+#endif
+
+#include <dispatch.hpp>
+
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
 
@@ -222,6 +230,31 @@ BOOST_AUTO_TEST_CASE(sha2_256_shortmsg_byte1) {
     BOOST_CHECK_EQUAL("9df5c16a3f580406f07d96149303d8c408869b32053b726cf3defd241e484957", std::to_string(d).data());
 }
 
+BOOST_AUTO_TEST_CASE(sha2_256_longmsg_range) {
+    // perl -e 'for (1..1000000) { print "a"; }' | sha256sum
+    std::string a(1000000, 'a');
+    hashes::sha2<256>::digest_type d = hash<hashes::sha2<256>>(a);
+
+    BOOST_CHECK_EQUAL("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", std::to_string(d).data());
+}
+
+BOOST_AUTO_TEST_CASE(sha2_256_split_range) {
+    // Chunks straddle block boundaries, so both the cached and the direct block paths are taken
+    std::vector<std::uint8_t> a(300);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+
+    accumulator_set<hashes::sha2<256>> acc;
+    hash<hashes::sha2<256>>(a.begin(), a.begin() + 5, acc);
+    hash<hashes::sha2<256>>(a.begin() + 5, a.begin() + 135, acc);
+    hash<hashes::sha2<256>>(a.begin() + 135, a.end(), acc);
+    hashes::sha2<256>::digest_type d = extract::hash<hashes::sha2<256>>(acc);
+
+    BOOST_CHECK_EQUAL("04773f8726c81cafcfa1a09a82664b98b00d2021031a1715bca1154f2dad3472", std::to_string(d).data());
+    BOOST_CHECK_EQUAL(std::to_string(d), std::to_string(hashes::sha2<256>::digest_type(hash<hashes::sha2<256>>(a))));
+}
+
 BOOST_AUTO_TEST_CASE(sha2_384_shortmsg_bit) {
     // D.1/1
     std::array<bool, 5> a = {0, 0, 0, 1, 0};
@@ -640,4 +673,60 @@ BOOST_AUTO_TEST_CASE(sha224_range_hash) {
     BOOST_CHECK_EQUAL("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7", std::to_string(h).data());
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END()
+
+#if BOOST_ARCH_X86_64 && defined(CRYPTO3_HAS_SHA_NI)
+BOOST_AUTO_TEST_SUITE(sha2_sha_ni_test_suite)
+
+BOOST_AUTO_TEST_CASE(sha2_256_sha_ni_matches_davies_meyer) {
+    typedef hashes::detail::sha2_policy<256> policy_type;
+    typedef hashes::detail::sha2_256_sha_ni_impl<policy_type> sha_ni_type;
+    typedef hashes::davies_meyer_compressor<policy_type::block_cipher_type, hashes::detail::state_adder>
+        reference_type;
+
+    std::uint32_t x = 0x12345678;
+    std::vector<policy_type::block_type> blocks(7);
+    for (policy_type::block_type &block : blocks) {
+        for (std::uint32_t &w : block) {
+            w = x = x * 1664525u + 1013904223u;
+        }
+    }
+
+    policy_type::state_type state = policy_type::iv_generator()(), expected = state;
+    sha_ni_type::process_blocks(state, blocks.data(), blocks.size());
+    for (const policy_type::block_type &block : blocks) {
+        reference_type::process_block(expected, block);
+    }
+
+    BOOST_CHECK(state == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
+
+#if BOOST_ARCH_X86_64
+BOOST_AUTO_TEST_SUITE(sha2_dispatch_test_suite)
+
+BOOST_AUTO_TEST_CASE(sha2_256_dispatch_backends_agree) {
+    typedef hashes::detail::sha2_policy<256> policy_type;
+    typedef hashes::detail::sha2_256_dispatch_impl<policy_type> dispatch_type;
+    typedef hashes::davies_meyer_compressor<policy_type::block_cipher_type, hashes::detail::state_adder>
+        reference_type;
+
+    std::vector<policy_type::block_type> blocks(7);
+    lcg_words(0x12345678).fill_blocks(blocks);
+
+    policy_type::state_type expected = policy_type::iv_generator()();
+    reference_type::process_blocks(expected, blocks.data(), blocks.size());
+
+    dispatch_type::backend_type generic = for_each_backend<dispatch_type>(
+        {&hashes::detail::cpu_features::sha_ni}, [&](const dispatch_type::backend_type &backend) {
+            policy_type::state_type state = policy_type::iv_generator()();
+            backend.process_blocks(state, blocks.data(), blocks.size());
+            BOOST_CHECK(state == expected);
+        });
+    BOOST_CHECK_EQUAL(generic.name, std::string("generic"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
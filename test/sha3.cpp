@@ -335,6 +335,29 @@ BOOST_AUTO_TEST_CASE(sha3_512_shortmsg_byte3) {
         std::to_string(d).data());
 }
 
+BOOST_AUTO_TEST_CASE(sha3_256_longmsg_range) {
+    // Million repetitions of "a"
+    std::string a(1000000, 'a');
+    hashes::sha3<256>::digest_type d = hash<hashes::sha3<256>>(a);
+
+    BOOST_CHECK_EQUAL("5c8875ae474a3634ba4fd55ec85bffd661f32aca75c6d699d0cdcb6c115891c1", std::to_string(d).data());
+}
+
+BOOST_AUTO_TEST_CASE(sha3_256_rate_boundary) {
+    // Octet-aligned padding one octet short of the rate, where 0x06 and 0x80 share an octet, and around it
+    std::string a(134, 'a');
+    hashes::sha3<256>::digest_type d = hash<hashes::sha3<256>>(a);
+    BOOST_CHECK_EQUAL("58b970c37ac2d65b599b691868a61401a501c40f235d55f059d39a942f41dcee", std::to_string(d).data());
+
+    a.push_back('a');
+    d = hash<hashes::sha3<256>>(a);
+    BOOST_CHECK_EQUAL("8094bb53c44cfb1e67b7c30447f9a1c33696d2463ecc1d9c92538913392843c9", std::to_string(d).data());
+
+    a.push_back('a');
+    d = hash<hashes::sha3<256>>(a);
+    BOOST_CHECK_EQUAL("3fc5559f14db8e453a0a3091edbd2bc25e11528d81c66fa570a4efdcc2695ee1", std::to_string(d).data());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(sha3_accumulator_test_suite)
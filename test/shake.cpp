@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE shake_test
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/shake.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+template<typename Xof>
+void check_chunked_squeeze(const std::vector<std::uint8_t> &m) {
+    Xof whole;
+    whole.update(m.data(), m.size());
+    std::vector<std::uint8_t> expected = whole.squeeze(1000);
+
+    for (std::size_t chunk : {1, 7, 64, 135, 136, 167, 168, 169, 500}) {
+        Xof xof;
+        for (std::size_t i = 0; i < m.size(); i += chunk) {
+            xof.update(m.data() + i, std::min(chunk, m.size() - i));
+        }
+
+        std::vector<std::uint8_t> out(expected.size());
+        for (std::size_t i = 0; i < out.size(); i += chunk) {
+            xof.squeeze(out.data() + i, std::min(chunk, out.size() - i));
+        }
+        BOOST_CHECK_EQUAL(to_hex(out), to_hex(expected));
+    }
+}
+
+template<std::size_t SecurityBits>
+void check_batch_against_single() {
+    std::vector<std::vector<std::uint8_t>> messages;
+    std::vector<const std::uint8_t *> data;
+    std::vector<std::size_t> sizes;
+    for (std::size_t i = 0; i != 19; ++i) {
+        messages.push_back(make_message(i * 41 % 400, i));
+    }
+    for (const std::vector<std::uint8_t> &m : messages) {
+        data.push_back(m.data());
+        sizes.push_back(m.size());
+    }
+
+    hashes::shake_xof_batch<SecurityBits> batch;
+    batch.absorb(data.data(), sizes.data(), data.size());
+    BOOST_CHECK_EQUAL(batch.size(), messages.size());
+
+    // Squeezed in uneven steps, so the steps straddle the rate
+    std::vector<std::vector<std::uint8_t>> out(messages.size(), std::vector<std::uint8_t>(700));
+    for (std::size_t offset = 0, step = 1; offset < 700; offset += step, step = step * 3 + 1) {
+        std::size_t amount = std::min(step, 700 - offset);
+        std::vector<std::uint8_t *> targets;
+        for (std::vector<std::uint8_t> &o : out) {
+            targets.push_back(o.data() + offset);
+        }
+        batch.squeeze(targets.data(), amount);
+    }
+
+    for (std::size_t i = 0; i != messages.size(); ++i) {
+        hashes::shake_xof<SecurityBits> xof;
+        xof.update(messages[i]);
+        BOOST_CHECK_EQUAL(to_hex(out[i]), to_hex(xof.squeeze(700)));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(shake_test_suite)
+
+BOOST_AUTO_TEST_CASE(shake128_vectors) {
+    hashes::shake128 xof;
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26");
+
+    xof.reset();
+    xof.update(std::string("abc"));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "5881092dd818bf5cf8a3ddb793fbcba74097d5c526a6d35f97b83351940f2cc8");
+
+    // Octets 480 ... 511, three permutations further into the output
+    xof.squeeze(448);
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "7085901803ec6f17f0ec650a292198275211a56bf13f0bf7241268b50d3f1ec8");
+}
+
+BOOST_AUTO_TEST_CASE(shake256_vectors) {
+    hashes::shake256 xof;
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(64)),
+                      "46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762f"
+                      "d75dc4ddd8c0f200cb05019d67b592f6fc821c49479ab48640292eacb3b7c4be");
+
+    xof.reset();
+    xof.update(std::string("abc"));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(64)),
+                      "483366601360a8771c6863080cc4114d8db44530f8f1e1ee4f94ea37e78b5739"
+                      "d5a15bef186a5386c75744c0527e1faa9f8726e462a12a4feb06bd8801e751e4");
+
+    xof.squeeze(416);
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "9440b99d6088e20203aebafa8e9dffa94ed35ef1f41f5fdf549fbcc5a0f68298");
+}
+
+BOOST_AUTO_TEST_CASE(shake_chunked_squeeze) {
+    for (std::size_t size : {0, 1, 135, 136, 137, 167, 168, 169, 1000}) {
+        check_chunked_squeeze<hashes::shake128>(make_message(size, 0));
+        check_chunked_squeeze<hashes::shake256>(make_message(size, 0));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shake_batch) {
+    check_batch_against_single<128>();
+    check_batch_against_single<256>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,220 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE sp800_185_test
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <nil/crypto3/hash/cshake.hpp>
+#include <nil/crypto3/hash/kmac.hpp>
+#include <nil/crypto3/hash/parallel_hash.hpp>
+#include <nil/crypto3/hash/tuple_hash.hpp>
+
+#include <octets.hpp>
+
+using namespace nil::crypto3;
+
+// Sample values are from the NIST SP 800-185 examples
+
+std::vector<std::uint8_t> make_range(std::uint8_t first, std::size_t size) {
+    std::vector<std::uint8_t> v(size);
+    for (std::size_t i = 0; i != size; ++i) {
+        v[i] = static_cast<std::uint8_t>(first + i);
+    }
+    return v;
+}
+
+const std::vector<std::uint8_t> kmac_key = make_range(0x40, 32);
+
+const std::vector<std::uint8_t> parallel_data = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                                 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+                                                 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+
+BOOST_AUTO_TEST_SUITE(cshake_test_suite)
+
+BOOST_AUTO_TEST_CASE(cshake128_samples) {
+    hashes::cshake128 xof(std::string(), std::string("Email Signature"));
+    xof.update(make_range(0, 4));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "c1c36925b6409a04f1b504fcbca9d82b4017277cb5ed2b2065fc1d3814d5aaf5");
+
+    xof.reset();
+    xof.update(make_range(0, 200));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(32)), "c5221d50e4f822d96a2e8881a961420f294b7b24fe3d2094baed2c6524cc166b");
+}
+
+BOOST_AUTO_TEST_CASE(cshake256_sample) {
+    hashes::cshake256 xof(std::string(), std::string("Email Signature"));
+    xof.update(make_range(0, 4));
+    BOOST_CHECK_EQUAL(to_hex(xof.squeeze(64)),
+                      "d008828e2b80ac9d2218ffee1d070c48b8e4c87bff32c9699d5b6896eee0edd1"
+                      "64020e2be0560858d9c00c037e34a96937c561a74c412bb4c746469527281c8c");
+}
+
+BOOST_AUTO_TEST_CASE(cshake_without_strings_is_shake) {
+    hashes::cshake128 cshake;
+    hashes::shake128 shake;
+    cshake.update(std::string("abc"));
+    shake.update(std::string("abc"));
+    BOOST_CHECK_EQUAL(to_hex(cshake.squeeze(200)), to_hex(shake.squeeze(200)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(kmac_test_suite)
+
+BOOST_AUTO_TEST_CASE(kmac128_samples) {
+    hashes::kmac128 mac(kmac_key);
+    mac.update(make_range(0, 4));
+    BOOST_CHECK_EQUAL(to_hex(mac.finalize(32)), "e5780b0d3ea6f7d3a429c5706aa43a00fadbd7d49628839e3187243f456ee14e");
+
+    hashes::kmac128 tagged(kmac_key, std::string("My Tagged Application"));
+    tagged.update(make_range(0, 4));
+    BOOST_CHECK_EQUAL(to_hex(tagged.finalize(32)),
+                      "3b1fba963cd8b0b59e8c1a6d71888b7143651af8ba0a7070c0979e2811324aa5");
+
+    // finalize() went back to the keyed state
+    tagged.update(make_range(0, 200));
+    BOOST_CHECK_EQUAL(to_hex(tagged.finalize(32)),
+                      "1f5b4e6cca02209e0dcb5ca635b89a15e271ecc760071dfd805faa38f9729230");
+}
+
+BOOST_AUTO_TEST_CASE(kmac256_samples) {
+    hashes::kmac256 tagged(kmac_key, std::string("My Tagged Application"));
+    tagged.update(make_range(0, 4));
+    BOOST_CHECK_EQUAL(to_hex(tagged.finalize(64)),
+                      "20c570c31346f703c9ac36c61c03cb64c3970d0cfc787e9b79599d273a68d2f7"
+                      "f69d4cc3de9d104a351689f27cf6f5951f0103f33f4f24871024d9c27773a8dd");
+
+    hashes::kmac256 mac(kmac_key);
+    mac.update(make_range(0, 200));
+    BOOST_CHECK_EQUAL(to_hex(mac.finalize(64)),
+                      "75358cf39e41494e949707927cee0af20a3ff553904c86b08f21cc414bcfd691"
+                      "589d27cf5e15369cbbff8b9a4c2eb17800855d0235ff635da82533ec6b759b69");
+}
+
+BOOST_AUTO_TEST_CASE(kmacxof128_sample) {
+    hashes::kmac128 mac(kmac_key);
+    mac.update(make_range(0, 4));
+
+    std::vector<std::uint8_t> out(32);
+    mac.squeeze(out.data(), 5);
+    mac.squeeze(out.data() + 5, 27);
+    BOOST_CHECK_EQUAL(to_hex(out), "cd83740bbd92ccc8cf032b1481a0f4460e7ca9dd12b08a0c4031178bacd6ec35");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(tuple_hash_test_suite)
+
+BOOST_AUTO_TEST_CASE(tuple_hash128_samples) {
+    hashes::tuple_hash128 h;
+    h.update(make_range(0, 3)).update(make_range(0x10, 6));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "c5d8786c1afb9b82111ab34b65b2c0048fa64e6d48e263264ce1707d3ffc8ed1");
+
+    hashes::tuple_hash128 tagged(std::string("My Tuple App"));
+    tagged.update(make_range(0, 3)).update(make_range(0x10, 6)).update(make_range(0x20, 9));
+    BOOST_CHECK_EQUAL(to_hex(tagged.finalize(32)),
+                      "e60f202c89a2631eda8d4c588ca5fd07f39e5151998deccf973adb3804bb6e84");
+}
+
+BOOST_AUTO_TEST_CASE(tuple_hash256_sample) {
+    hashes::tuple_hash256 h;
+    h.update(make_range(0, 3)).update(make_range(0x10, 6));
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(64)),
+                      "cfb7058caca5e668f81a12a20a2195ce97a925f1dba3e7449a56f82201ec6073"
+                      "11ac2696b1ab5ea2352df1423bde7bd4bb78c9aed1a853c78672f9eb23bbe194");
+}
+
+BOOST_AUTO_TEST_CASE(tuple_hash_element_boundaries) {
+    hashes::tuple_hash128 h;
+    std::vector<std::uint8_t> ab_c = h.update(std::string("ab")).update(std::string("c")).finalize(32);
+    std::vector<std::uint8_t> a_bc = h.update(std::string("a")).update(std::string("bc")).finalize(32);
+    BOOST_CHECK(ab_c != a_bc);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(parallel_hash_test_suite)
+
+BOOST_AUTO_TEST_CASE(parallel_hash128_samples) {
+    hashes::parallel_hash128 h(8);
+    h.update(parallel_data);
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(32)), "ba8dc1d1d979331d3f813603c67f72609ab5e44b94a0b8f9af46514454a2b4f5");
+
+    hashes::parallel_hash128 tagged(8, std::string("Parallel Data"));
+    tagged.update(parallel_data);
+    BOOST_CHECK_EQUAL(to_hex(tagged.finalize(32)),
+                      "fc484dcb3f84dceedc353438151bee58157d6efed0445a81f165e495795b7206");
+}
+
+BOOST_AUTO_TEST_CASE(parallel_hash256_sample) {
+    hashes::parallel_hash256 h(8);
+    h.update(parallel_data);
+    BOOST_CHECK_EQUAL(to_hex(h.finalize(64)),
+                      "bc1ef124da34495e948ead207dd9842235da432d2bbc54b4c110e64c45110553"
+                      "1b7f2a3e0ce055c02805e7c2de1fb746af97a1dd01f43b824e31b87612410429");
+}
+
+BOOST_AUTO_TEST_CASE(parallel_hash_xof128_sample) {
+    hashes::parallel_hash128 h(8);
+    h.update(parallel_data);
+
+    std::vector<std::uint8_t> out(32);
+    h.squeeze(out.data(), 32);
+    BOOST_CHECK_EQUAL(to_hex(out), "fe47d661e49ffe5b7d999922c062356750caf552985b8e8ce6667f2727c3c8d3");
+}
+
+BOOST_AUTO_TEST_CASE(parallel_hash_chunks_and_threads) {
+    std::vector<std::uint8_t> m(10000);
+    for (std::size_t i = 0; i != m.size(); ++i) {
+        m[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+
+    for (std::size_t threads : {1, 3, 8}) {
+        hashes::parallel_hash128 h(1024, std::string(), threads);
+        for (std::size_t chunk : {1, 100, 1024, 5000, 10000}) {
+            for (std::size_t i = 0; i < m.size(); i += chunk) {
+                h.update(m.data() + i, std::min(chunk, m.size() - i));
+            }
+            BOOST_CHECK_EQUAL(to_hex(h.finalize(32)),
+                              "064989bf483e457d6d855e2f667f7fbdff9b46cb63a99575a8eafea5fc7aea0e");
+        }
+
+        hashes::parallel_hash256 h256(100, std::string("x"), threads);
+        h256.update(m);
+        BOOST_CHECK_EQUAL(to_hex(h256.finalize(64)),
+                          "ab1459ee8d8b3bd0cfd12548e6d58a7967383b7cb231cc5b07a1dec85f8e1a0d"
+                          "ce6e9f868a988109ab87b8b25279d3115ac5447efe2ef4e2d6e65b83a688514c");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
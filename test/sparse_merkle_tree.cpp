@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2020 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+
+#define BOOST_TEST_MODULE sparse_merkle_tree_test
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/sparse_merkle_tree.hpp>
+
+#include <nil/crypto3/hash/hasher.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/poseidon.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+
+#include <nil/crypto3/algebra/fields/pallas/base_field.hpp>
+
+using namespace nil::crypto3;
+
+typedef hashes::sha2<256> sha2_256;
+typedef hashes::hasher<sha2_256>::digest_type sha2_256_digest;
+
+template<typename Digest>
+Digest make_digest(std::size_t i) {
+    Digest d;
+    for (std::size_t j = 0; j < d.size(); ++j) {
+        d[j] = static_cast<std::uint8_t>(i * 13 + j);
+    }
+    return d;
+}
+
+template<typename Tree>
+typename Tree::key_type make_key(std::size_t i) {
+    typename Tree::key_type key = {};
+    for (std::size_t j = 0; j < key.size(); ++j) {
+        key[j] = static_cast<std::uint8_t>((i + 1) * (j + 3) * 0x9D);
+    }
+    return key;
+}
+
+// Full binary tree over every leaf of an 8-bit key space, hashed node by node
+template<typename Hash>
+typename hashes::hasher<Hash>::digest_type plain_root(std::vector<typename hashes::hasher<Hash>::digest_type> level) {
+    typedef typename hashes::hasher<Hash>::digest_type digest_type;
+
+    while (level.size() > 1) {
+        std::vector<digest_type> parents;
+        for (std::size_t i = 0; i < level.size(); i += 2) {
+            hashes::hasher<Hash> h;
+            h.update(std::vector<std::uint8_t> {0x01});
+            h.update(level[i].data(), level[i].size()).update(level[i + 1].data(), level[i + 1].size());
+            parents.push_back(h.finalize());
+        }
+        level = parents;
+    }
+    return level[0];
+}
+
+BOOST_AUTO_TEST_SUITE(sparse_merkle_tree_test_suite)
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_sha2_256_empty) {
+    hashes::sparse_merkle_tree<sha2_256> tree;
+
+    BOOST_CHECK_EQUAL(tree.size(), 0);
+    BOOST_CHECK_EQUAL("6155289130893872355eac98042d22aefa2c2e708bea169402760e3b55f9a2dc",
+                      std::to_string(tree.root()));
+    BOOST_CHECK(tree.proof(make_key<hashes::sparse_merkle_tree<sha2_256>>(0)).validate(sha2_256_digest(),
+                                                                                       tree.root()));
+}
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_sha2_256_small_key_space) {
+    typedef hashes::sparse_merkle_tree<sha2_256, 8> tree_type;
+
+    tree_type tree;
+    std::vector<sha2_256_digest> leaves(256);
+    std::vector<std::pair<tree_type::key_type, sha2_256_digest>> updates;
+    for (std::size_t i : {0, 1, 2, 77, 128, 200, 254, 255}) {
+        leaves[i] = make_digest<sha2_256_digest>(i);
+        updates.emplace_back(tree_type::key_type {static_cast<std::uint8_t>(i)}, leaves[i]);
+    }
+    tree.update(updates);
+
+    BOOST_CHECK_EQUAL(tree.size(), 8);
+    BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(plain_root<sha2_256>(leaves)));
+
+    for (std::size_t i = 0; i < 256; ++i) {
+        tree_type::key_type key = {static_cast<std::uint8_t>(i)};
+        BOOST_CHECK_EQUAL(std::to_string(tree.get(key)), std::to_string(leaves[i]));
+        BOOST_CHECK(tree.proof(key).validate(leaves[i], tree.root()));
+        BOOST_CHECK(!tree.proof(key).validate(make_digest<sha2_256_digest>(i + 1), tree.root()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_sha2_256_batches) {
+    typedef hashes::sparse_merkle_tree<sha2_256> tree_type;
+
+    // Duplicate keys, the last write winning, and keys written back to empty
+    std::vector<std::pair<tree_type::key_type, sha2_256_digest>> updates;
+    for (std::size_t i = 0; i < 300; ++i) {
+        updates.emplace_back(make_key<tree_type>(i % 170), make_digest<sha2_256_digest>(i));
+    }
+    for (std::size_t i = 0; i < 20; ++i) {
+        updates.emplace_back(make_key<tree_type>(i * 3), sha2_256_digest());
+    }
+
+    tree_type one_by_one;
+    for (const auto &u : updates) {
+        one_by_one.update(u.first, u.second);
+    }
+
+    tree_type batch(sha2_256_digest(), 4);
+    batch.update(std::vector<std::pair<tree_type::key_type, sha2_256_digest>>(updates.begin(),
+                                                                              updates.begin() + 100));
+    batch.update(std::vector<std::pair<tree_type::key_type, sha2_256_digest>>(updates.begin() + 100,
+                                                                              updates.end()));
+
+    BOOST_CHECK_EQUAL(batch.size(), 150);
+    BOOST_CHECK_EQUAL(one_by_one.size(), 150);
+    BOOST_CHECK_EQUAL(std::to_string(batch.root()), std::to_string(one_by_one.root()));
+
+    for (std::size_t i = 0; i < 170; ++i) {
+        tree_type::key_type key = make_key<tree_type>(i);
+        BOOST_CHECK(batch.proof(key).validate(batch.get(key), batch.root()));
+    }
+
+    // Removing every key brings back the empty tree
+    for (std::size_t i = 0; i < 170; ++i) {
+        batch.erase(make_key<tree_type>(i));
+    }
+    BOOST_CHECK_EQUAL(batch.size(), 0);
+    BOOST_CHECK_EQUAL(std::to_string(batch.root()), std::to_string(batch.empty_root(256)));
+}
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_sha2_256_single_key_subtrees) {
+    typedef hashes::sparse_merkle_tree<sha2_256, 8> tree_type;
+
+    // Keys come and go next to each other, moving the tops of the single-key subtrees up and down
+    tree_type tree;
+    std::vector<sha2_256_digest> leaves(256);
+    for (std::size_t i = 0; i < 200; ++i) {
+        std::size_t key = (i * 37) % 19 * 13 % 256;
+        leaves[key] = (i % 3 == 2) ? sha2_256_digest() : make_digest<sha2_256_digest>(i);
+        tree.update(tree_type::key_type {static_cast<std::uint8_t>(key)}, leaves[key]);
+
+        BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(plain_root<sha2_256>(leaves)));
+        for (std::size_t j = 0; j < 256; j += 17) {
+            tree_type::key_type probe = {static_cast<std::uint8_t>(j)};
+            BOOST_CHECK(tree.proof(probe).validate(leaves[j], tree.root()));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_sha2_256_stored_nodes) {
+    typedef hashes::sparse_merkle_tree<sha2_256> tree_type;
+
+    tree_type tree;
+    std::vector<std::pair<tree_type::key_type, sha2_256_digest>> updates;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        updates.emplace_back(make_key<tree_type>(i), make_digest<sha2_256_digest>(i));
+        updates.back().first[0] = static_cast<std::uint8_t>(i >> 8);
+        updates.back().first[1] = static_cast<std::uint8_t>(i);
+    }
+    tree.update(updates);
+
+    // A node per subtree with two keys or more: about one per key, whatever the key length
+    BOOST_CHECK_EQUAL(tree.size(), 1000);
+    BOOST_CHECK_LT(tree.stored_nodes(), 2 * tree.size());
+
+    // Two keys differing in the last bit only share every node above them
+    tree_type pair;
+    tree_type::key_type key = make_key<tree_type>(0);
+    pair.update(key, make_digest<sha2_256_digest>(0));
+    BOOST_CHECK_EQUAL(pair.stored_nodes(), 0);
+    key.back() ^= 0x01;
+    pair.update(key, make_digest<sha2_256_digest>(1));
+    BOOST_CHECK_EQUAL(pair.stored_nodes(), 256);
+    pair.erase(key);
+    BOOST_CHECK_EQUAL(pair.stored_nodes(), 0);
+
+    for (const auto &u : updates) {
+        tree.erase(u.first);
+    }
+    BOOST_CHECK_EQUAL(tree.size(), 0);
+    BOOST_CHECK_EQUAL(tree.stored_nodes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_keccak_256_small_key_space) {
+    typedef hashes::sparse_merkle_tree<hashes::keccak_1600<256>, 8> tree_type;
+    typedef tree_type::digest_type digest_type;
+
+    tree_type tree;
+    std::vector<digest_type> leaves(256);
+    std::vector<std::pair<tree_type::key_type, digest_type>> updates;
+    for (std::size_t i = 3; i < 256; i += 5) {
+        leaves[i] = make_digest<digest_type>(i);
+        updates.emplace_back(tree_type::key_type {static_cast<std::uint8_t>(i)}, leaves[i]);
+    }
+    tree.update(updates);
+
+    BOOST_CHECK_EQUAL(std::to_string(tree.root()), std::to_string(plain_root<hashes::keccak_1600<256>>(leaves)));
+}
+
+BOOST_AUTO_TEST_CASE(sparse_merkle_tree_poseidon_pallas) {
+    typedef algebra::fields::pallas_base_field field_type;
+    typedef hashes::poseidon<hashes::detail::poseidon_policy<field_type, 128, 2>> hash_type;
+    typedef typename field_type::value_type element_type;
+    typedef hashes::sparse_merkle_tree<hash_type, 8> tree_type;
+
+    std::vector<element_type> level(256, element_type());
+    std::vector<std::pair<tree_type::key_type, element_type>> updates;
+    for (std::size_t i : {5, 6, 100, 250}) {
+        level[i] = element_type(i + 1);
+        updates.emplace_back(tree_type::key_type {static_cast<std::uint8_t>(i)}, level[i]);
+    }
+
+    tree_type tree;
+    tree.update(updates);
+
+    while (level.size() > 1) {
+        std::vector<element_type> parents;
+        for (std::size_t i = 0; i < level.size(); i += 2) {
+            parents.push_back(hash<hash_type>(std::vector<element_type> {level[i], level[i + 1]}, element_type::one()));
+        }
+        level = parents;
+    }
+    BOOST_CHECK(tree.root() == level[0]);
+
+    tree_type::key_type key = {100};
+    BOOST_CHECK(tree.proof(key).validate(element_type(101), tree.root()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()